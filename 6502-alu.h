@@ -0,0 +1,129 @@
+#ifndef  _6502_ALU_H_
+#define  _6502_ALU_H_
+
+//----------------------------------------------------------------------------- ----------------------------------------
+#include <stdint.h>
+
+#include "6502.h"
+
+//----------------------------------------------------------------------------- ----------------------------------------
+// Decimal mode lookup tables - built by the preprocessor
+//
+// A decimal add or subtract splits at the nibbles : the low digit only depends on (A.lo, M.lo, C), and the high digit,
+// N, V & C only on (A.hi, M.hi, the carry/borrow out of the low digit).  So two 512 entry tables each, in place of the
+// 128K (A, M, C) combinations.
+//
+//   low  : [c << 8 | A.lo << 4 | M.lo]   ->  bit 4 = carry/borrow to the high digit, bits 0-3 = the low digit
+//   high : [c << 8 | A.hi << 4 | M.hi]   ->  bits 4-7 = the high digit  (ADC: N, V & C in bits 8-15)
+//
+#define ALU_X4(f, i)    f(i), f((i) + 1), f((i) + 2), f((i) + 3)
+#define ALU_X16(f, i)   ALU_X4(f, i), ALU_X4(f, (i) + 4), ALU_X4(f, (i) + 8), ALU_X4(f, (i) + 12)
+#define ALU_X64(f, i)   ALU_X16(f, i), ALU_X16(f, (i) + 16), ALU_X16(f, (i) + 32), ALU_X16(f, (i) + 48)
+#define ALU_X512(f)     ALU_X64(f, 0), ALU_X64(f, 64), ALU_X64(f, 128), ALU_X64(f, 192), \
+                        ALU_X64(f, 256), ALU_X64(f, 320), ALU_X64(f, 384), ALU_X64(f, 448)
+
+#define ALU_A(i)        (((i) >> 4) & 0x0F)                 // A's nibble
+#define ALU_M(i)        ((i) & 0x0F)                        // M's nibble
+#define ALU_C(i)        ((i) >> 8)                          // Carry (ADC) / borrow (SBC) in
+#define ALU_SGN(n)      (((n) ^ 8) - 8)                     // A high nibble as the top of a signed byte
+
+// ADC : low digit
+#define DA_S(i)         (ALU_A(i) + ALU_M(i) + ALU_C(i))
+#define DA_LO(i)        ((DA_S(i) >= 0x0A) ? ((DA_S(i) + 0x06) & 0x0F) + 0x10 : DA_S(i))
+
+// ADC : high digit  (N & V are taken before the adjust, C after)
+#define DA_H(i)         ((ALU_A(i) + ALU_M(i) + ALU_C(i)) << 4)
+#define DA_HA(i)        ((DA_H(i) >= 0xA0) ? DA_H(i) + 0x60 : DA_H(i))
+#define DA_SV(i)        ((ALU_SGN(ALU_A(i)) + ALU_SGN(ALU_M(i)) + ALU_C(i)) * 16)
+#define DA_HI(i)        (((  (DA_SV(i) & FLG_N)                                     \
+                           | (((DA_SV(i) < -128) || (DA_SV(i) > 127)) ? FLG_V : 0) \
+                           | ((DA_HA(i) >= 0x100) ? FLG_C : 0)  ) << 8)           \
+                         | (DA_HA(i) & 0xF0))
+
+// SBC : low digit, high digit  (the flags are the binary ones)
+#define DS_S(i)         (ALU_A(i) - ALU_M(i) + ALU_C(i) - 1)
+#define DS_LO(i)        ((DS_S(i) < 0) ? ((DS_S(i) - 0x06) & 0x0F) | 0x10 : DS_S(i))
+#define DS_H(i)         (ALU_A(i) - ALU_M(i) - ALU_C(i))
+#define DS_HI(i)        ((((DS_H(i) < 0) ? DS_H(i) - 0x06 : DS_H(i)) & 0x0F) << 4)
+
+static const uint8_t   adc_dlo[512] = { ALU_X512(DA_LO) };
+static const uint16_t  adc_dhi[512] = { ALU_X512(DA_HI) };
+static const uint8_t   sbc_dlo[512] = { ALU_X512(DS_LO) };
+static const uint8_t   sbc_dhi[512] = { ALU_X512(DS_HI) };
+
+#undef ALU_X4
+#undef ALU_X16
+#undef ALU_X64
+#undef ALU_X512
+#undef ALU_A
+#undef ALU_M
+#undef ALU_C
+#undef ALU_SGN
+#undef DA_S
+#undef DA_LO
+#undef DA_H
+#undef DA_HA
+#undef DA_SV
+#undef DA_HI
+#undef DS_S
+#undef DS_LO
+#undef DS_H
+#undef DS_HI
+
+//+============================================================================ ========================================
+// Decimal mode results, for cores that keep the flags their own way
+//   adc_bcd() -> result | N, V & C << 8   (Z is from the binary sum)
+//   sbc_bcd() -> result                     (the flags are the binary ones)
+//
+static inline  unsigned  adc_bcd (uint8_t a,  uint8_t v,  unsigned c)
+{
+	unsigned  lo = adc_dlo[(c << 8) | ((a & 0x0F) << 4) | (v & 0x0F)];
+	unsigned  hi = adc_dhi[((lo >> 4) << 8) | (a & 0xF0) | (v >> 4)];
+
+	return (hi & 0xFFF0) | (lo & 0x0F);
+}
+
+static inline  uint8_t  sbc_bcd (uint8_t a,  uint8_t v,  unsigned c)
+{
+	unsigned  lo = sbc_dlo[(c << 8) | ((a & 0x0F) << 4) | (v & 0x0F)];
+
+	return sbc_dhi[((lo >> 4) << 8) | (a & 0xF0) | (v >> 4)] | (lo & 0x0F);
+}
+
+//+============================================================================ ========================================
+// ALU helpers - decimal mode follows the NMOS behaviour documented by Bruce Clark
+//   http://www.6502.org/tutorials/decimal_mode.html  (Appendix A)
+// N, V & Z are "garbage" in decimal mode on NMOS, but deterministic garbage - it is reproduced here
+//
+static inline  uint8_t  adc (uint8_t a,  uint8_t v,  uint8_t* p)
+{
+	unsigned  c = *p & FLG_C;
+	unsigned  r = a + v + c;
+	uint8_t   f = *p & ~(FLG_N | FLG_V | FLG_Z | FLG_C);
+
+	if (!(*p & FLG_D)) {
+		f |= (r & 0x80) | (!(r & 0xFF) << 1) | (r >> 8);
+		f |= (~(a ^ v) & (a ^ r) & 0x80) >> 1;
+		*p = f;
+		return r;
+	}
+
+	r  = adc_bcd(a, v, c) | (!(r & 0xFF) << 9);                // Z from the binary sum
+	*p = f | (r >> 8);
+	return r;
+}
+
+//+============================================================================ ========================================
+static inline  uint8_t  sbc (uint8_t a,  uint8_t v,  uint8_t* p)
+{
+	unsigned  c = *p & FLG_C;
+	unsigned  r = a + (uint8_t)~v + c;                           // N, V, Z & C are the binary results in both modes
+
+	*p = (*p & ~(FLG_N | FLG_V | FLG_Z | FLG_C))
+	   | (r & 0x80) | (!(r & 0xFF) << 1) | (r >> 8)
+	   | (((a ^ v) & (a ^ r) & 0x80) >> 1);
+
+	return (*p & FLG_D) ? sbc_bcd(a, v, c) : r;
+}
+
+#endif //_6502_ALU_H_
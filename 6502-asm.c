@@ -0,0 +1,705 @@
+// gcc  6502-asm.c  6502-op2i.c  -o asm  -O2
+//   ./asm file.s [out.bin]      : assemble  (default output: a.bin)
+//   ./asm -r file.bin [org]     : round trip - disassemble through decode(), reassemble & compare  (org in hex)
+//
+// Syntax (one statement per line, ';' starts a comment):
+//   label:  [statement]
+//   NAME = expr                 : equate
+//   * = expr    |  .org expr    : set the program counter  (forward only - the gap is zero-filled)
+//   .byte expr|"text", ...      .word expr, ...
+//   MNM  [operand]              : #i  A  e  e,X  e,Y  (e)  (e,X)  (e),Y  - branches take the target address
+// Expressions:  $hex  %bin  decimal  'c'  label  *   joined by + & -  [< low byte, > high byte, of the whole expression]
+//
+// Zero page vs absolute:  an operand is zero page when its value is known (in pass 1) to be < $100
+//                         and was not written as a $ literal of 3+ digits ($0012 is absolute)
+//                         Forward references are absolute.
+
+//----------------------------------------------------------------------------- ----------------------------------------
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdarg.h>
+#include <string.h>
+#include <strings.h>
+#include <time.h>
+
+#include "6502.h"
+
+#define AS_OBUF_SZ  (64 << 10)     // Output is streamed through this
+
+//----------------------------------------------------------------------------- ----------------------------------------
+// Assembler state
+//
+typedef
+	struct sym {
+		const char*  name;          // In the source text  (not NUL terminated)
+		uint32_t     len;
+		uint32_t     line;          // Where it was defined  (0 -> free slot)
+		int32_t      val;
+		uint8_t      known;         // val is valid
+	}
+sym_t;
+
+typedef
+	struct val {
+		int32_t  v;
+		uint8_t  known;             // Every symbol in it had a value
+		uint8_t  wide;              // Contains a $ literal of 3+ digits  -> absolute
+	}
+val_t;
+
+typedef
+	struct as {
+		int16_t      opc[MN_MAX][AM_MAX];   // (mnemonic, mode) -> opcode  (-1 -> none)  - the inverse of op2i[]
+
+		const char*  file;
+		uint32_t     line;
+		int          pass;          // 1: sizes & symbols, 2: output
+		int          nerr;
+
+		uint16_t     pc;
+		size_t       at;            // Bytes of output so far
+
+		sym_t*       sym;           // Open addressing, power-of-2 size, at most half full
+		size_t       ssz, nsym;
+
+		uint8_t*     abs;           // Line n: bit set -> pass 1 chose absolute
+		size_t       absz;
+
+		FILE*        out;           // Output sink: a file...
+		uint8_t*     img;           // ...or memory  (when out == NULL)
+		size_t       isz;
+		uint8_t      obuf[AS_OBUF_SZ];
+		size_t       on;
+	}
+as_t;
+
+#define IS_EOL(c)  ( !(c) || ((c) == '\n') || ((c) == '\r') || ((c) == ';') )
+#define IS_ID0(c)  ( (((c) | 0x20) >= 'a' && ((c) | 0x20) <= 'z') || ((c) == '_') )
+#define IS_ID(c)   ( IS_ID0(c) || ((c) >= '0' && (c) <= '9') )
+
+//+============================================================================ ========================================
+static  double  now (void)
+{
+	struct timespec  ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+//+============================================================================ ========================================
+static  void  as_err (as_t* as,  const char* fmt,  ...)
+{
+	va_list  ap;
+
+	fprintf(stderr, "%s:%u: ", as->file, as->line);
+	va_start(ap, fmt);
+	vfprintf(stderr, fmt, ap);
+	va_end(ap);
+	fputc('\n', stderr);
+	as->nerr++;
+}
+
+//+============================================================================ ========================================
+static inline  const char*  skip (const char* s)
+{
+	while ((*s == ' ') || (*s == '\t'))  s++ ;
+	return s;
+}
+
+//+============================================================================ ========================================
+// Build the (mnemonic, mode) -> opcode map from the decode table
+//
+static  void  as_init (as_t* as)
+{
+	memset(as, 0, sizeof(*as));
+	memset(as->opc, 0xFF, sizeof(as->opc));
+	for (int op = 0;  op < 256;  op++)
+		if (op2i[op].len && (as->opc[op2i[op].mnem][op2i[op].am] < 0))  as->opc[op2i[op].mnem][op2i[op].am] = op ;
+}
+
+//+============================================================================ ========================================
+static  void  as_free (as_t* as)
+{
+	free(as->sym);
+	free(as->abs);
+	free(as->img);
+}
+
+//----------------------------------------------------------------------------- ----------------------------------------
+// Symbols
+//
+static inline  uint32_t  sym_hash (const char* s,  uint32_t len)
+{
+	uint32_t  h = 2166136261u;                         // FNV-1a
+	while (len--)  h = (h ^ (uint8_t)*s++) * 16777619u ;
+	return h;
+}
+
+//+============================================================================ ========================================
+// Find 'name'  (or the free slot it would go in)
+//
+static  sym_t*  sym_find (as_t* as,  const char* name,  uint32_t len)
+{
+	size_t  msk = as->ssz - 1;
+
+	if (!as->ssz)  return NULL ;
+	for (size_t i = sym_hash(name, len) & msk;  ;  i = (i + 1) & msk) {
+		sym_t*  sp = &as->sym[i];
+		if (!sp->line || ((sp->len == len) && !memcmp(sp->name, name, len)))  return sp ;
+	}
+}
+
+//+============================================================================ ========================================
+// Find or add 'name'
+//
+static  sym_t*  sym_add (as_t* as,  const char* name,  uint32_t len)
+{
+	sym_t*  sp;
+
+	if ((as->nsym + 1) * 2 > as->ssz) {
+		sym_t*  old = as->sym;
+		size_t  osz = as->ssz;
+
+		as->ssz = osz ? osz * 2 : 1024 ;
+		if (!(as->sym = calloc(as->ssz, sizeof(*as->sym))))  return as->sym = old, as->ssz = osz, NULL ;
+		for (size_t i = 0;  i < osz;  i++)
+			if (old[i].line)  *sym_find(as, old[i].name, old[i].len) = old[i] ;
+		free(old);
+	}
+
+	sp = sym_find(as, name, len);
+	if (!sp->line) {
+		sp->name = name;
+		sp->len  = len;
+		as->nsym++;
+	}
+	return sp;
+}
+
+//+============================================================================ ========================================
+// Define 'name' on this line
+//
+static  void  sym_def (as_t* as,  const char* name,  uint32_t len,  val_t v)
+{
+	sym_t*  sp = sym_add(as, name, len);
+
+	if (!sp)  return as_err(as, "out of memory") ;
+	if (as->pass == 1) {
+		if (sp->line)  return as_err(as, "'%.*s' already defined on line %u", (int)len, name, sp->line) ;
+		sp->line = as->line;
+	} else if (sp->known && v.known && (sp->val != v.v)) {
+		return as_err(as, "'%.*s' moved between passes", (int)len, name);
+	}
+	sp->val   = v.v;
+	sp->known = v.known;
+}
+
+//----------------------------------------------------------------------------- ----------------------------------------
+// Expressions
+//
+static  const char*  as_term (as_t* as,  const char* s,  val_t* v)
+{
+	int  n = 0;
+
+	v->v     = 0;
+	v->known = 1;
+	v->wide  = 0;
+
+	if (*s == '$') {
+		for (s++;  ;  s++, n++) {
+			int  c = *s | 0x20;
+			if      ((c >= '0') && (c <= '9'))  v->v = (v->v << 4) | (c - '0') ;
+			else if ((c >= 'a') && (c <= 'f'))  v->v = (v->v << 4) | (c - 'a' + 10) ;
+			else                                break ;
+		}
+		v->wide = (n >= 3);
+
+	} else if (*s == '%') {
+		for (s++;  (*s == '0') || (*s == '1');  s++, n++)  v->v = (v->v << 1) | (*s - '0') ;
+
+	} else if ((*s >= '0') && (*s <= '9')) {
+		for (;  (*s >= '0') && (*s <= '9');  s++, n++)  v->v = v->v * 10 + (*s - '0') ;
+
+	} else if (*s == '\'') {
+		if (!s[1] || (s[2] != '\''))  return as_err(as, "bad character constant"), NULL ;
+		v->v = (uint8_t)s[1];
+		s += 3,  n = 1;
+
+	} else if (*s == '*') {
+		v->v = as->pc;
+		s++,  n = 1;
+
+	} else if (IS_ID0(*s)) {
+		const char*  id = s;
+		sym_t*       sp;
+
+		while (IS_ID(*s))  s++ ;
+		sp = sym_find(as, id, s - id);
+		if (sp && sp->line && sp->known) {
+			v->v = sp->val;
+		} else {
+			v->known = 0;
+			if (as->pass == 2)  as_err(as, (sp && sp->line) ? "'%.*s' cannot be resolved" : "'%.*s' undefined", (int)(s - id), id) ;
+		}
+		n = 1;
+	}
+
+	if (!n)  return as_err(as, "bad expression"), NULL ;
+	return s;
+}
+
+//+============================================================================ ========================================
+static  const char*  as_expr (as_t* as,  const char* s,  val_t* v)
+{
+	int  part = 0;                                     // '<' or '>'
+	int  sign = 1;
+
+	v->v     = 0;
+	v->known = 1;
+	v->wide  = 0;
+
+	s = skip(s);
+	if ((*s == '<') || (*s == '>'))  part = *s++,  s = skip(s) ;
+	if (*s == '-')                   sign = -1,    s = skip(s + 1) ;
+
+	for (;;) {
+		val_t  t;
+
+		if (!(s = as_term(as, s, &t)))  return NULL ;
+		v->v     += sign * t.v;
+		v->known &= t.known;
+		v->wide  |= t.wide;
+
+		s = skip(s);
+		if      (*s == '+')  sign =  1 ;
+		else if (*s == '-')  sign = -1 ;
+		else                 break ;
+		s = skip(s + 1);
+	}
+
+	if (part) {
+		v->v    = (part == '<') ? (v->v & 0xFF) : ((v->v >> 8) & 0xFF) ;
+		v->wide = 0;
+	}
+	return s;
+}
+
+//----------------------------------------------------------------------------- ----------------------------------------
+// Output
+//
+static  int  as_flush (as_t* as)
+{
+	if (!as->on)  return 0 ;
+
+	if (as->out) {
+		if (fwrite(as->obuf, 1, as->on, as->out) != as->on)  return as_err(as, "write error"), -1 ;
+	} else {
+		uint8_t*  p = realloc(as->img, as->isz + as->on);
+		if (!p)  return as_err(as, "out of memory"), -1 ;
+		memcpy((as->img = p) + as->isz, as->obuf, as->on);
+		as->isz += as->on;
+	}
+	as->on = 0;
+	return 0;
+}
+
+//+============================================================================ ========================================
+static inline  void  as_emit (as_t* as,  uint8_t b)
+{
+	if (as->pass == 2) {
+		as->obuf[as->on++] = b;
+		if (as->on == sizeof(as->obuf))  as_flush(as) ;
+	}
+	as->pc++;
+	as->at++;
+}
+
+//+============================================================================ ========================================
+// Pass 2: is 'v' in [lo, hi]?
+//
+static inline  int  as_range (as_t* as,  val_t v,  int32_t lo,  int32_t hi)
+{
+	if ((as->pass == 1) || !v.known || ((v.v >= lo) && (v.v <= hi)))  return 1 ;
+	as_err(as, "value $%X out of range", (unsigned)v.v);
+	return 0;
+}
+
+//+============================================================================ ========================================
+static  void  as_org (as_t* as,  const char* s)
+{
+	val_t  v;
+
+	if (!(s = as_expr(as, s, &v)))        return ;
+	if (!IS_EOL(*s))                      return as_err(as, "junk after expression") ;
+	if (!v.known)                         return as_err(as, "origin must not be a forward reference") ;
+	if (!as_range(as, v, 0, 0xFFFF))      return ;
+
+	if (!as->at) {                                     // Nothing emitted yet -> this is where the image starts
+		as->pc = v.v;
+		return;
+	}
+	if ((uint16_t)v.v < as->pc)           return as_err(as, "origin moves backwards") ;
+	while (as->pc != (uint16_t)v.v)  as_emit(as, 0) ;
+}
+
+//+============================================================================ ========================================
+// .byte & .word
+//
+static  void  as_data (as_t* as,  const char* s,  int w)
+{
+	for (;;) {
+		val_t  v;
+
+		s = skip(s);
+		if (!w && (*s == '"')) {
+			for (s++;  *s != '"';  s++) {
+				if (IS_EOL(*s) && (*s != ';'))  return as_err(as, "unterminated string") ;
+				as_emit(as, *s);
+			}
+			s = skip(s + 1);
+		} else {
+			if (!(s = as_expr(as, s, &v)))  return ;
+			if (w) {
+				as_range(as, v, -0x8000, 0xFFFF);
+				as_emit(as, v.v);
+				as_emit(as, v.v >> 8);
+			} else {
+				as_range(as, v, -0x80, 0xFF);
+				as_emit(as, v.v);
+			}
+		}
+		if (*s != ',')  break ;
+		s++;
+	}
+	if (!IS_EOL(*s))  as_err(as, "junk after data") ;
+}
+
+//+============================================================================ ========================================
+// ",X" / ",Y"  ->  'X' / 'Y'  (0 -> neither)
+//
+static  const char*  as_index (const char* s,  int* idx)
+{
+	int  c;
+
+	s = skip(s + 1);
+	c = *s & ~0x20;
+	*idx = (((c == 'X') || (c == 'Y')) && !IS_ID(s[1])) ? c : 0 ;
+	return s + 1;
+}
+
+//+============================================================================ ========================================
+static  void  as_insn (as_t* as,  mnem_t mn,  const char* s)
+{
+	static const uint8_t  zp[3] = {AM_ZP , AM_ZPX , AM_ZPY };
+	static const uint8_t  ab[3] = {AM_ABS, AM_ABSX, AM_ABSY};
+	const int16_t*  opc = as->opc[mn];
+	val_t           v   = {0, 1, 0};
+	int             idx = 0;
+	int             am;
+	uint8_t         op;
+
+	s = skip(s);
+	if (IS_EOL(*s)) {
+		am = (opc[AM_IMP] >= 0) ? AM_IMP : AM_ACC ;
+
+	} else if (((*s & ~0x20) == 'A') && IS_EOL(*skip(s + 1))) {
+		am = AM_ACC,  s++;
+
+	} else if (*s == '#') {
+		if (!(s = as_expr(as, s + 1, &v)))  return ;
+		am = AM_IMM;
+
+	} else if (*s == '(') {
+		if (!(s = as_expr(as, s + 1, &v)))  return ;
+		if (*s == ',') {                                 // (e,X)
+			s = skip(as_index(s, &idx));
+			if ((idx != 'X') || (*s != ')'))  return as_err(as, "expected (e,X)") ;
+			am = AM_INDX,  s++;
+		} else if (*s == ')') {
+			s = skip(s + 1);
+			if (*s == ',') {                             // (e),Y
+				s = as_index(s, &idx);
+				if (idx != 'Y')  return as_err(as, "expected (e),Y") ;
+				am = AM_INDY;
+			} else {                                     // (e)
+				am = AM_IND;
+			}
+		} else {
+			return as_err(as, "expected ')'");
+		}
+
+	} else {
+		if (!(s = as_expr(as, s, &v)))  return ;
+		if (*s == ',') {
+			s = as_index(s, &idx);
+			if (!idx)  return as_err(as, "expected X or Y") ;
+		}
+
+		if (!idx && (opc[AM_REL] >= 0)) {
+			am = AM_REL;
+		} else {
+			int       i   = !idx ? 0 : (idx == 'X') ? 1 : 2 ;
+			uint32_t  ln  = as->line;
+			int       big;
+
+			if (as->pass == 1) {                         // Decide, and remember for pass 2
+				big = v.wide || !v.known || (v.v < 0) || (v.v > 0xFF) ;
+				if (big && v.known && (opc[ab[i]] < 0))  return as_err(as, "%s does not have %s addressing", mnem[mn], amode[ab[i]]) ;
+				big = (big && (opc[ab[i]] >= 0)) || (opc[zp[i]] < 0);
+				if ((ln >> 3) >= as->absz) {
+					size_t    nsz = as->absz ? as->absz * 2 : 4096 ;
+					uint8_t*  p;
+					while ((ln >> 3) >= nsz)  nsz *= 2 ;
+					if (!(p = realloc(as->abs, nsz)))  return as_err(as, "out of memory") ;
+					memset(p + as->absz, 0, nsz - as->absz);
+					as->abs  = p;
+					as->absz = nsz;
+				}
+				as->abs[ln >> 3] = (as->abs[ln >> 3] & ~(1 << (ln & 7))) | (big << (ln & 7));
+			} else {
+				big = (as->abs[ln >> 3] >> (ln & 7)) & 1;
+			}
+			am = big ? ab[i] : zp[i] ;
+		}
+	}
+
+	s = skip(s);
+	if (!IS_EOL(*s))  return as_err(as, "junk after operand") ;
+	if (opc[am] < 0)  return as_err(as, "%s does not have %s addressing", mnem[mn], amode[am]) ;
+
+	op = opc[am];
+	switch (am) {
+		case AM_IMP :
+		case AM_ACC :  as_emit(as, op);  break ;
+
+		case AM_REL : {
+			int32_t  d = (int16_t)(v.v - (as->pc + 2));
+			if ((as->pass == 2) && v.known && ((d < -128) || (d > 127)))  as_err(as, "branch out of range (%d)", (int)d) ;
+			as_emit(as, op);
+			as_emit(as, d);
+			break;
+		}
+
+		case AM_IMM :
+			as_range(as, v, -0x80, 0xFF);
+			as_emit(as, op);
+			as_emit(as, v.v);
+			break;
+
+		case AM_ZP  :
+		case AM_ZPX :
+		case AM_ZPY :
+		case AM_INDX:
+		case AM_INDY:
+			as_range(as, v, 0, 0xFF);
+			as_emit(as, op);
+			as_emit(as, v.v);
+			break;
+
+		default :                                        // ABS, ABSX, ABSY, IND
+			as_range(as, v, -0x8000, 0xFFFF);
+			as_emit(as, op);
+			as_emit(as, v.v);
+			as_emit(as, v.v >> 8);
+			break;
+	}
+}
+
+//+============================================================================ ========================================
+static  void  as_line (as_t* as,  const char* s)
+{
+	mnem_t  mn = MN_ILL;
+
+	s = skip(s);
+
+	if (*s == '*') {                                   // * = expr
+		s = skip(s + 1);
+		if (*s != '=')  return as_err(as, "expected '='") ;
+		return as_org(as, s + 1);
+	}
+
+	if (IS_ID0(*s)) {                                  // label:  /  NAME = expr
+		const char*  id = s;
+		const char*  t;
+
+		while (IS_ID(*s))  s++ ;
+		t = skip(s);
+		if (*t == ':') {
+			sym_def(as, id, s - id, (val_t){as->pc, 1, 0});
+			s = skip(t + 1);
+		} else if (*t == '=') {
+			val_t  v;
+			if (!(t = as_expr(as, t + 1, &v)))  return ;
+			if (!IS_EOL(*t))  return as_err(as, "junk after expression") ;
+			return sym_def(as, id, s - id, v);
+		} else {
+			s = id;
+		}
+	}
+
+	if (IS_EOL(*s))  return ;
+
+	if (*s == '.') {                                   // Directives
+		const char*  d = ++s;
+		int          n;
+
+		while (IS_ID(*s))  s++ ;
+		n = s - d;
+		if      ((n == 3) && !strncasecmp(d, "org" , 3))  as_org (as, s) ;
+		else if ((n == 4) && !strncasecmp(d, "byte", 4))  as_data(as, s, 0) ;
+		else if ((n == 4) && !strncasecmp(d, "word", 4))  as_data(as, s, 1) ;
+		else    as_err(as, "unknown directive '.%.*s'", n, d) ;
+		return;
+	}
+
+	if (IS_ID0(s[0]) && IS_ID0(s[1]) && IS_ID0(s[2]) && !IS_ID(s[3]))  mn = mnem_find(s) ;
+	if (mn == MN_ILL)  return as_err(as, "unknown instruction") ;
+	as_insn(as, mn, s + 3);
+}
+
+//+============================================================================ ========================================
+// Assemble the NUL terminated 'src'  (two passes)
+// Returns the number of errors
+//
+static  int  as_run (as_t* as,  const char* src)
+{
+	for (as->pass = 1;  (as->pass <= 2) && !as->nerr;  as->pass++) {
+		as->pc   = 0;
+		as->at   = 0;
+		as->line = 0;
+
+		for (const char* s = src;  *s;  ) {
+			const char*  eol = strchr(s, '\n');
+
+			as->line++;
+			as_line(as, s);
+			if (!eol)  break ;
+			s = eol + 1;
+		}
+	}
+	as_flush(as);
+	return as->nerr;
+}
+
+//+============================================================================ ========================================
+// Whole file, NUL terminated
+//
+static  char*  load (const char* fn,  size_t* psz)
+{
+	FILE*   fh = fopen(fn, "rb");
+	char*   buf;
+	long    sz;
+
+	if (!fh)  return perror(fn), NULL ;
+	if ((fseek(fh, 0, SEEK_END) < 0) || ((sz = ftell(fh)) < 0) || (fseek(fh, 0, SEEK_SET) < 0))
+		return perror(fn), fclose(fh), NULL ;
+	if ((buf = malloc(sz + 1)) && (fread(buf, 1, sz, fh) != (size_t)sz))  perror(fn),  free(buf),  buf = NULL ;
+	fclose(fh);
+	if (!buf)  return NULL ;
+
+	buf[sz] = '\0';
+	if (psz)  *psz = sz ;
+	return buf;
+}
+
+//+============================================================================ ========================================
+static  int  assemble (const char* fn,  const char* ofn)
+{
+	as_t*   as = malloc(sizeof(*as));
+	char*   src;
+	size_t  sz;
+	double  t;
+	int     rv;
+
+	if (!as)                     return perror("malloc"), 1 ;
+	if (!(src = load(fn, &sz)))  return free(as), 1 ;
+	as_init(as);
+	as->file = fn;
+
+	if (!(as->out = fopen(ofn, "wb")))  return perror(ofn), free(src), free(as), 1 ;
+
+	t  = now();
+	rv = as_run(as, src);
+	t  = now() - t;
+
+	if (fclose(as->out) && !rv)  perror(ofn),  rv = 1 ;
+	if (rv) {
+		fprintf(stderr, "%d error(s)\n", rv);
+		remove(ofn);
+	} else {
+		printf("%s: %u lines, %zu bytes -> %s in %.2f ms\n", fn, as->line, as->at, ofn, t * 1e3);
+	}
+
+	as_free(as);
+	free(as);
+	free(src);
+	return !!rv;
+}
+
+//+============================================================================ ========================================
+// Disassemble 'fn' through decode(), assemble the result, and check that the bytes come back
+//   Invalid opcodes & a truncated final instruction become ".byte $xx"
+//
+static  int  round_trip (const char* fn,  uint16_t org)
+{
+	as_t*     as = malloc(sizeof(*as));
+	uint8_t*  buf;
+	char*     src;
+	char*     p;
+	size_t    sz, n = 0;
+	double    t;
+	int       rv;
+
+	if (!as)                                 return perror("malloc"), 1 ;
+	if (!(buf = (uint8_t*)load(fn, &sz)))    return free(as), 1 ;
+	if (!(src = malloc(sz * 16 + 32)))       return perror("malloc"), free(buf), free(as), 1 ;
+
+	p = src + sprintf(src, "\t* = $%04X\n", org);
+	for (size_t off = 0;  off < sz;  n++) {
+		decode_t  d = op2i[buf[off]];
+		disasm_t  dis;
+
+		if (!d.len || (off + d.len > sz)) {
+			p += sprintf(p, "\t.byte $%02X\n", buf[off++]);
+			continue;
+		}
+		decode(&buf[off], &dis);
+		if (dis.am == AM_REL)  sprintf(dis.oper, "$%04X", (uint16_t)(org + off + 2 + (int8_t)buf[off + 1])) ;
+		p += sprintf(p, *dis.oper ? "\t%s %s\n" : "\t%s\n", dis.mnem, dis.oper);
+		off += d.len;
+	}
+
+	as_init(as);
+	as->file = "(round trip)";
+
+	t  = now();
+	rv = as_run(as, src);
+	t  = now() - t;
+
+	if (!rv) {
+		rv = (as->isz != sz) || memcmp(as->img, buf, sz);
+		printf("%s: %zu bytes, %zu lines (%zu bytes of source) assembled in %.2f ms (%.1f MB/s) : %s\n",
+		       fn, sz, n, (size_t)(p - src), t * 1e3, (p - src) / t / 1e6, rv ? "MISMATCH" : "identical");
+		for (size_t i = 0;  rv && (i < sz);  i++)
+			if ((i >= as->isz) || (as->img[i] != buf[i])) {
+				printf("  first difference at +$%zX ($%04X)\n", i, (uint16_t)(org + i));
+				break;
+			}
+	}
+
+	as_free(as);
+	free(as);
+	free(src);
+	free(buf);
+	return !!rv;
+}
+
+//+============================================================================ ========================================
+int  main (int argc,  char* argv[])
+{
+	if ((argc >= 3) && !strcmp(argv[1], "-r"))  return round_trip(argv[2], (argc > 3) ? strtoul(argv[3], NULL, 16) : 0) ;
+	if ((argc >= 2) && (argv[1][0] != '-'))     return assemble(argv[1], (argc > 2) ? argv[2] : "a.bin") ;
+
+	fprintf(stderr, "use: %s file.s [out.bin]  |  %s -r file.bin [org]\n", argv[0], argv[0]);
+	return 1;
+}
@@ -1,581 +1,995 @@
-// gcc  6502-auto.c  -o table  -g
+// gcc  6502-auto.c  6502-flow.c  6502-time.c  6502-scan.c  6502-xref.c  6502-incr.c  6502-emit.c  6502-op2i.c  6502-var.c  -o table  -g  -pthread
+//   ./table                                : HTML opcode table
+//   ./table -d file.bin [org]              : disassemble a binary image  (org in hex)
+//   ./table -b file.bin [org]              : disassembly throughput, hexfmt vs sprintf
+//   ./table -f file.bin [org [entry ...]]  : follow control flow from the vectors (& entries) - labels, code & data
+//   ./table -t file.bin org lo hi [entry ...]  : best/worst cycles of each basic block & loop in lo..hi
+//   ./table -j dir|list outdir [threads]   : disassemble every image into outdir/<name>.dis, in parallel
+//                                            (list: one "file [org]" per line -> outdir/<n>-<name>.dis, n from 1)
+//   ./table -s file.bin                    : instruction-boundary pre-scan - check against decode() & throughput
+//   ./table -x file.bin [org [out.xrf]]    : cross-reference index of every memory operand  (default file.bin.xrf)
+//   ./table -q file.xrf addr[-addr] [rwmj] : who reads, writes, read-modify-writes or jumps to addr  (hex)
+//   ./table -e file.bin [org] < edits      : patch & re-disassemble incrementally - edits are "offset byte ..." (hex)
+//   ./table -g prefix                      : the opcode table as prefix.htm, .json, .csv & a C header .h  (one pass)
+//   ./table -v var [-d|-j|-e|-x|-g ...]    : HTML table / disassembly for a CPU variant  (6502 nmos 65c02 65816)
 
 //----------------------------------------------------------------------------- ----------------------------------------
 #include <stdint.h>
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
+#include <time.h>
+#include <errno.h>
+#include <stdatomic.h>
 
-//----------------------------------------------------------------------------- ----------------------------------------
-#define PEEK8(p)     ( *((uint8_t*)(p)) )
-#define PEEK16LE(p)  ( PEEK8(p) | (PEEK8( ((uint8_t*)(p)) +1) <<8) )
+#include <dirent.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "6502.h"
+#include "6502-flow.h"
+#include "6502-time.h"
+#include "6502-scan.h"
+#include "6502-xref.h"
+#include "6502-incr.h"
+#include "6502-emit.h"
 
 //----------------------------------------------------------------------------- ----------------------------------------
-// Opcodes
+// Streaming disassembler
+//
+// Line format : see dis_line() in 6502.h  (the sprintf() path makes the same lines)
 //
+#define DIS_OBUF_SZ   (4 << 20)    // Output buffer: flushed when less than one line remains
+
 typedef
-	enum opcode {
-		// https://www.masswerk.at/6502/6502_instruction_set.html
-		// In case of errors:  The *COMMENTS* should be trusted above the enums
-		//   *  : (Tcnt += 1) if page boundary is crossed
-		//   ** : (Tcnt += 1) if branch occurs on same page
-		//      : (Tcnt += 2) if branch occurs to different page
-		OP_ADC_ABS  = 0x6D,    // absolute      ADC oper      6D    3     4   
-		OP_ADC_ABSX = 0x7D,    // absolute,X    ADC oper,X    7D    3     4*   
-		OP_ADC_ABSY = 0x79,    // absolute,Y    ADC oper,Y    79    3     4*   
-		OP_ADC_IMM  = 0x69,    // immediate     ADC #oper     69    2     2
-		OP_ADC_INDX = 0x61,    // (indirect,X)  ADC (oper,X)  61    2     6   
-		OP_ADC_INDY = 0x71,    // (indirect),Y  ADC (oper),Y  71    2     5*   
-		OP_ADC_ZP   = 0x65,    // zeropage      ADC oper      65    2     3   
-		OP_ADC_ZPX  = 0x75,    // zeropage,X    ADC oper,X    75    2     4   
-		OP_AND_ABS  = 0x2D,    // absolute      AND oper      2D    3     4   
-		OP_AND_ABSX = 0x3D,    // absolute,X    AND oper,X    3D    3     4*   
-		OP_AND_ABSY = 0x39,    // absolute,Y    AND oper,Y    39    3     4*   
-		OP_AND_IMM  = 0x29,    // immediate     AND #oper     29    2     2   
-		OP_AND_INDX = 0x21,    // (indirect,X)  AND (oper,X)  21    2     6   
-		OP_AND_INDY = 0x31,    // (indirect),Y  AND (oper),Y  31    2     5*   
-		OP_AND_ZP   = 0x25,    // zeropage      AND oper      25    2     3   
-		OP_AND_ZPX  = 0x35,    // zeropage,X    AND oper,X    35    2     4   
-		OP_ASL_ABS  = 0x0E,    // absolute      ASL oper      0E    3     6   
-		OP_ASL_ABSX = 0x1E,    // absolute,X    ASL oper,X    1E    3     7   
-		OP_ASL_ACC  = 0x0A,    // accumulator   ASL A         0A    1     2   
-		OP_ASL_ZP   = 0x06,    // zeropage      ASL oper      06    2     5   
-		OP_ASL_ZPX  = 0x16,    // zeropage,X    ASL oper,X    16    2     6   
-		OP_BCC_REL  = 0x90,    // relative      BCC oper      90    2     2**   
-		OP_BCS_REL  = 0xB0,    // relative      BCS oper      B0    2     2**   
-		OP_BEQ_REL  = 0xF0,    // relative      BEQ oper      F0    2     2**   
-		OP_BIT_ABS  = 0x2C,    // absolute      BIT oper      2C    3     4   
-		OP_BIT_ZP   = 0x24,    // zeropage      BIT oper      24    2     3   
-		OP_BMI_REL  = 0x30,    // relative      BMI oper      30    2     2**   
-		OP_BNE_REL  = 0xD0,    // relative      BNE oper      D0    2     2**   
-		OP_BPL_REL  = 0x10,    // relative      BPL oper      10    2     2**   
-		OP_BRK_IMP  = 0x00,    // implied       BRK           00    1     7   
-		OP_BVC_REL  = 0x50,    // relative      BVC oper      50    2     2**   
-		OP_BVS_REL  = 0x70,    // relative      BVC oper      70    2     2**   
-		OP_CLC_IMP  = 0x18,    // implied       CLC           18    1     2   
-		OP_CLD_IMP  = 0xD8,    // implied       CLD           D8    1     2   
-		OP_CLI_IMP  = 0x58,    // implied       CLI           58    1     2   
-		OP_CLV_IMP  = 0xB8,    // implied       CLV           B8    1     2   
-		OP_CMP_ABS  = 0xCD,    // absolute      CMP oper      CD    3     4   
-		OP_CMP_ABSX = 0xDD,    // absolute,X    CMP oper,X    DD    3     4*   
-		OP_CMP_ABSY = 0xD9,    // absolute,Y    CMP oper,Y    D9    3     4*   
-		OP_CMP_IMM  = 0xC9,    // immediate     CMP #oper     C9    2     2   
-		OP_CMP_INDX = 0xC1,    // (indirect,X)  CMP (oper,X)  C1    2     6   
-		OP_CMP_INDY = 0xD1,    // (indirect),Y  CMP (oper),Y  D1    2     5*   
-		OP_CMP_ZP   = 0xC5,    // zeropage      CMP oper      C5    2     3   
-		OP_CMP_ZPX  = 0xD5,    // zeropage,X    CMP oper,X    D5    2     4   
-		OP_CPX_ABS  = 0xEC,    // absolute      CPX oper      EC    3     4   
-		OP_CPX_IMM  = 0xE0,    // immediate     CPX #oper     E0    2     2   
-		OP_CPX_ZP   = 0xE4,    // zeropage      CPX oper      E4    2     3   
-		OP_CPY_ABS  = 0xCC,    // absolute      CPY oper      CC    3     4   
-		OP_CPY_IMM  = 0xC0,    // immediate     CPY #oper     C0    2     2   
-		OP_CPY_ZP   = 0xC4,    // zeropage      CPY oper      C4    2     3   
-		OP_DEC_ABS  = 0xCE,    // absolute      DEC oper      CE    3     6   
-		OP_DEC_ABSX = 0xDE,    // absolute,X    DEC oper,X    DE    3     7   
-		OP_DEC_ZP   = 0xC6,    // zeropage      DEC oper      C6    2     5   
-		OP_DEC_ZPX  = 0xD6,    // zeropage,X    DEC oper,X    D6    2     6   
-		OP_DEX_IMP  = 0xCA,    // implied       DEC           CA    1     2   
-		OP_DEY_IMP  = 0x88,    // implied       DEC           88    1     2   
-		OP_EOR_ABS  = 0x4D,    // absolute      EOR oper      4D    3     4   
-		OP_EOR_ABSX = 0x5D,    // absolute,X    EOR oper,X    5D    3     4*   
-		OP_EOR_ABSY = 0x59,    // absolute,Y    EOR oper,Y    59    3     4*   
-		OP_EOR_IMM  = 0x49,    // immediate     EOR #oper     49    2     2   
-		OP_EOR_INDX = 0x41,    // (indirect,X)  EOR (oper,X)  41    2     6   
-		OP_EOR_INDY = 0x51,    // (indirect),Y  EOR (oper),Y  51    2     5*   
-		OP_EOR_ZP   = 0x45,    // zeropage      EOR oper      45    2     3   
-		OP_EOR_ZPX  = 0x55,    // zeropage,X    EOR oper,X    55    2     4   
-		OP_INC_ABS  = 0xEE,    // absolute      INC oper      EE    3     6   
-		OP_INC_ABSX = 0xFE,    // absolute,X    INC oper,X    FE    3     7   
-		OP_INC_ZP   = 0xE6,    // zeropage      INC oper      E6    2     5   
-		OP_INC_ZPX  = 0xF6,    // zeropage,X    INC oper,X    F6    2     6   
-		OP_INX_IMP  = 0xE8,    // implied       INX           E8    1     2   
-		OP_INY_IMP  = 0xC8,    // implied       INY           C8    1     2   
-		OP_JMP_ABS  = 0x4C,    // absolute      JMP oper      4C    3     3   
-		OP_JMP_IND  = 0x6C,    // indirect      JMP (oper)    6C    3     5   
-		OP_JSR_ABS  = 0x20,    // absolute      JSR oper      20    3     6   
-		OP_LDA_ABS  = 0xAD,    // absolute      LDA oper      AD    3     4   
-		OP_LDA_ABSX = 0xBD,    // absolute,X    LDA oper,X    BD    3     4*   
-		OP_LDA_ABSY = 0xB9,    // absolute,Y    LDA oper,Y    B9    3     4*   
-		OP_LDA_IMM  = 0xA9,    // immediate     LDA #oper     A9    2     2   
-		OP_LDA_INDX = 0xA1,    // (indirect,X)  LDA (oper,X)  A1    2     6   
-		OP_LDA_INDY = 0xB1,    // (indirect),Y  LDA (oper),Y  B1    2     5*   
-		OP_LDA_ZP   = 0xA5,    // zeropage      LDA oper      A5    2     3   
-		OP_LDA_ZPX  = 0xB5,    // zeropage,X    LDA oper,X    B5    2     4   
-		OP_LDX_ABS  = 0xAE,    // absolute      LDX oper      AE    3     4   
-		OP_LDX_ABSY = 0xBE,    // absolute,Y    LDX oper,Y    BE    3     4*   
-		OP_LDX_IMM  = 0xA2,    // immediate     LDX #oper     A2    2     2   
-		OP_LDX_ZP   = 0xA6,    // zeropage      LDX oper      A6    2     3   
-		OP_LDX_ZPY  = 0xB6,    // zeropage,Y    LDX oper,Y    B6    2     4   
-		OP_LDY_ABS  = 0xAC,    // absolute      LDY oper      AC    3     4   
-		OP_LDY_ABSX = 0xBC,    // absolute,X    LDY oper,X    BC    3     4*   
-		OP_LDY_IMM  = 0xA0,    // immediate     LDY #oper     A0    2     2   
-		OP_LDY_ZP   = 0xA4,    // zeropage      LDY oper      A4    2     3   
-		OP_LDY_ZPX  = 0xB4,    // zeropage,X    LDY oper,X    B4    2     4   
-		OP_LSR_ABS  = 0x4E,    // absolute      LSR oper      4E    3     6   
-		OP_LSR_ABSX = 0x5E,    // absolute,X    LSR oper,X    5E    3     7   
-		OP_LSR_IMM  = 0x4A,    // accumulator   LSR A         4A    1     2   
-		OP_LSR_ZP   = 0x46,    // zeropage      LSR oper      46    2     5   
-		OP_LSR_ZPX  = 0x56,    // zeropage,X    LSR oper,X    56    2     6   
-		OP_NOP_IMP  = 0xEA,    // implied       NOP           EA    1     2   
-		OP_ORA_ABS  = 0x0D,    // absolute      ORA oper      0D    3     4   
-		OP_ORA_ABSX = 0x1D,    // absolute,X    ORA oper,X    1D    3     4*   
-		OP_ORA_ABSY = 0x19,    // absolute,Y    ORA oper,Y    19    3     4*   
-		OP_ORA_IMM  = 0x09,    // immediate     ORA #oper     09    2     2   
-		OP_ORA_INDX = 0x01,    // (indirect,X)  ORA (oper,X)  01    2     6   
-		OP_ORA_INDY = 0x11,    // (indirect),Y  ORA (oper),Y  11    2     5*   
-		OP_ORA_ZP   = 0x05,    // zeropage      ORA oper      05    2     3   
-		OP_ORA_ZPX  = 0x15,    // zeropage,X    ORA oper,X    15    2     4   
-		OP_PHA_IMP  = 0x48,    // implied       PHA           48    1     3   
-		OP_PHP_IMP  = 0x08,    // implied       PHP           08    1     3   
-		OP_PLA_IMP  = 0x68,    // implied       PLA           68    1     4   
-		OP_PLP_IMP  = 0x28,    // implied       PLP           28    1     4   
-		OP_ROL_ABS  = 0x2E,    // absolute      ROL oper      2E    3     6   
-		OP_ROL_ABSX = 0x3E,    // absolute,X    ROL oper,X    3E    3     7   
-		OP_ROL_ACC  = 0x2A,    // accumulator   ROL A         2A    1     2   
-		OP_ROL_ZP   = 0x26,    // zeropage      ROL oper      26    2     5   
-		OP_ROL_ZPX  = 0x36,    // zeropage,X    ROL oper,X    36    2     6   
-		OP_ROR_ABS  = 0x6E,    // absolute      ROR oper      6E    3     6   
-		OP_ROR_ABSX = 0x7E,    // absolute,X    ROR oper,X    7E    3     7   
-		OP_ROR_ACC  = 0x6A,    // accumulator   ROR A         6A    1     2   
-		OP_ROR_ZP   = 0x66,    // zeropage      ROR oper      66    2     5   
-		OP_ROR_ZPX  = 0x76,    // zeropage,X    ROR oper,X    76    2     6   
-		OP_RTI_IMP  = 0x40,    // implied       RTI           40    1     6   
-		OP_RTS_IMP  = 0x60,    // implied       RTS           60    1     6   
-		OP_SBC_ABS  = 0xED,    // absolute      SBC oper      ED    3     4   
-		OP_SBC_ABSX = 0xFD,    // absolute,X    SBC oper,X    FD    3     4*   
-		OP_SBC_ABSY = 0xF9,    // absolute,Y    SBC oper,Y    F9    3     4*   
-		OP_SBC_IMM  = 0xE9,    // immediate     SBC #oper     E9    2     2   
-		OP_SBC_INDX = 0xE1,    // (indirect,X)  SBC (oper,X)  E1    2     6   
-		OP_SBC_INDY = 0xF1,    // (indirect),Y  SBC (oper),Y  F1    2     5*   
-		OP_SBC_ZP   = 0xE5,    // zeropage      SBC oper      E5    2     3   
-		OP_SBC_ZPX  = 0xF5,    // zeropage,X    SBC oper,X    F5    2     4   
-		OP_SEC_IMP  = 0x38,    // implied       SEC           38    1     2   
-		OP_SED_IMP  = 0xF8,    // implied       SED           F8    1     2   
-		OP_SEI_IMP  = 0x78,    // implied       SEI           78    1     2   
-		OP_STA_ABS  = 0x8D,    // absolute      STA oper      8D    3     4   
-		OP_STA_ABSX = 0x9D,    // absolute,X    STA oper,X    9D    3     5   
-		OP_STA_ABSY = 0x99,    // absolute,Y    STA oper,Y    99    3     5   
-		OP_STA_INDX = 0x81,    // (indirect,X)  STA (oper,X)  81    2     6   
-		OP_STA_INDY = 0x91,    // (indirect),Y  STA (oper),Y  91    2     6   
-		OP_STA_ZP   = 0x85,    // zeropage      STA oper      85    2     3   
-		OP_STA_ZPX  = 0x95,    // zeropage,X    STA oper,X    95    2     4   
-		OP_STX_ABS  = 0x8E,    // absolute      STX oper      8E    3     4   
-		OP_STX_ZP   = 0x86,    // zeropage      STX oper      86    2     3   
-		OP_STX_ZPY  = 0x96,    // zeropage,Y    STX oper,Y    96    2     4   
-		OP_STY_ABS  = 0x8C,    // absolute      STY oper      8C    3     4   
-		OP_STY_ZP   = 0x84,    // zeropage      STY oper      84    2     3   
-		OP_STY_ZPX  = 0x94,    // zeropage,X    STY oper,X    94    2     4   
-		OP_TAX_IMP  = 0xAA,    // implied       TAX           AA    1     2   
-		OP_TAY_IMP  = 0xA8,    // implied       TAY           A8    1     2   
-		OP_TSX_IMP  = 0xBA,    // implied       TSX           BA    1     2   
-		OP_TXA_IMP  = 0x8A,    // implied       TXA           8A    1     2   
-		OP_TXS_IMP  = 0x9A,    // implied       TXS           9A    1     2   
-		OP_TYA_IMP  = 0x98,    // implied       TYA           98    1     2   		
+	struct image {
+		uint8_t*  buf;        // mmap'ed file contents
+		size_t    sz;         // bytes
 	}
-opcode_t;
+image_t;
 
-//----------------------------------------------------------------------------- ----------------------------------------
-// Addressing Modes
+typedef
+	struct obuf {
+		char*     buf;        // DIS_OBUF_SZ bytes
+		char*     p;          // next free byte
+		int       fd;         // flush target  (-1 -> discard)
+	}
+obuf_t;
+
+//+============================================================================ ========================================
+// Map a whole file read-only
 //
-typedef	
-	enum amode {
-		// In order of "increasing opcode value"
-		AM_IMP = 0,
-		AM_REL,
-		AM_ACC,
-		AM_IMM,
-		AM_ZP,
-		AM_ZPX,
-		AM_ZPY,
-		AM_ABS,
-		AM_ABSX,
-		AM_ABSY,
-		AM_IND,
-		AM_INDX,
-		AM_INDY,
-		
-		AM_MAX  // Must be last
+int  image_open (image_t* img,  const char* fn)
+{
+	struct stat  st;
+	int          fd;
+
+	img->buf = NULL;
+	img->sz  = 0;
+
+	if ((fd = open(fn, O_RDONLY)) < 0)                 return perror(fn), -1 ;
+	if (fstat(fd, &st) < 0)                             return perror(fn), close(fd), -1 ;
+
+	if ((img->sz = st.st_size) > 0) {
+		img->buf = mmap(NULL, img->sz, PROT_READ, MAP_PRIVATE, fd, 0);
+		if (img->buf == MAP_FAILED)                     return perror(fn), close(fd), -1 ;
+		madvise(img->buf, img->sz, MADV_SEQUENTIAL);
 	}
-amode_t;	
-
-char  amode[AM_MAX][16] = {
-	[AM_IMP ] = "Implied", 
-	[AM_REL ] = "Relative", 
-	[AM_ACC ] = "Accum", 
-	[AM_IMM ] = "Immediate", 
-	[AM_ZP  ] = "ZeroPage", 
-	[AM_ZPX ] = "ZeroPage,X", 
-	[AM_ZPY ] = "ZeroPage,Y", 
-	[AM_ABS ] = "Abs", 
-	[AM_ABSX] = "Abs,X", 
-	[AM_ABSY] = "Abs.Y", 
-	[AM_IND ] = "(Ind)", 
-	[AM_INDX] = "(Ind,X)", 
-	[AM_INDY] = "(Ind),Y"
-};
 
-//----------------------------------------------------------------------------- ----------------------------------------
-// (Processor) Status Word (aka Flags) register
+	close(fd);
+	return 0;
+}
+
+//+============================================================================ ========================================
+void  image_close (image_t* img)
+{
+	if (img->buf)  munmap(img->buf, img->sz) ;
+	img->buf = NULL;
+	img->sz  = 0;
+}
+
+//+============================================================================ ========================================
+void  obuf_flush (obuf_t* ob)
+{
+	char*  p = ob->buf;
+
+	if (ob->fd >= 0)
+		while (p < ob->p) {
+			ssize_t  n = write(ob->fd, p, ob->p - p);
+			if (n <= 0)  break ;
+			p += n;
+		}
+	ob->p = ob->buf;
+}
+
+//+============================================================================ ========================================
+// Reference path: decode() + sprintf() for every line
 //
-typedef
-	enum flags {
-		// Leftmost (2^7) flag first
-		FLG_N    = 0x80,  // Negative    (r & 0x80)
-		FLG_V    = 0x40,  // oVerflow    http://6502.org/tutorials/vflag.html
-		FLG_X    = 0x20,  // -unused-
-		FLG_B    = 0x10,  // BReaK
-		FLG_D    = 0x08,  // Decimal     (BCD)
-		FLG_I    = 0x04,  // /Interrupt  (Interrupt DISable)
-		FLG_Z    = 0x02,  // Zero        (r = 0x00)
-		FLG_C    = 0x01,  // Carry       (r > 0xff)
-		
-		FLG_ALL  = 0xFF,
-		FLG_NONE = 0,
+static inline  int  dis_line_sprintf (char** ps,  const uint8_t* pc,  size_t rem,  uint16_t addr)
+{
+	disasm_t  dis;
+	int       len = op2i[*pc].len;
+	uint8_t   ins[3] = {pc[0], (rem > 1) ? pc[1] : 0, (rem > 2) ? pc[2] : 0};
+
+	if ((len == 0) || ((size_t)len > rem)) {
+		*ps += sprintf(*ps, "%04X  %02X        .byte $%02X\n", addr, *pc, *pc);
+		return 1;
 	}
-flags_t;
+
+	decode(ins, &dis);
+	if (dis.am == AM_REL)  sprintf(dis.oper, "$%04X", (uint16_t)(addr + 2 + (int8_t)pc[1])) ;
+
+	*ps += sprintf(*ps, "%04X  %02X ", addr, pc[0]);
+	*ps += (len > 1) ? sprintf(*ps, "%02X ", pc[1]) : sprintf(*ps, "   ");
+	*ps += (len > 2) ? sprintf(*ps, "%02X ", pc[2]) : sprintf(*ps, "   ");
+	*ps += sprintf(*ps, *dis.oper ? " %s %s\n" : " %s\n", dis.mnem, dis.oper);
+
+	return len;
+}
+
+//+============================================================================ ========================================
+// Walk a whole image
+//   org     : address of the first byte (wraps at 64K, so bank sets simply repeat the address space)
+//   slow    : use the decode()+sprintf() reference path  (op2i only)
+//   tab, nb : see dis_line()  - constants at every call, so each caller gets a copy of the loop for its table
+// Returns the number of instructions (incl. data bytes) emitted
+//
+static inline  size_t  disasm_walk (const image_t* img,  uint16_t org,  obuf_t* ob,  int slow,  const decode_t* tab,  int nb)
+{
+	const uint8_t*  pc   = img->buf;
+	const uint8_t*  end  = img->buf + img->sz;
+	char*           lim  = ob->buf + DIS_OBUF_SZ - DIS_LINE_MAX;
+	uint16_t        addr = org;
+	size_t          cnt  = 0;
+
+	while (pc < end) {
+		int  len;
+
+		if (ob->p >= lim)  obuf_flush(ob) ;
+
+		len   = slow ? dis_line_sprintf(&ob->p, pc, end - pc, addr)
+		             : dis_line        (&ob->p, pc, end - pc, addr, tab, nb) ;
+		pc   += len;
+		addr += len;
+		cnt++;
+	}
+
+	return cnt;
+}
+
+//+============================================================================ ========================================
+size_t  disasm_image (const image_t* img,  uint16_t org,  obuf_t* ob,  int slow)
+{
+	return disasm_walk(img, org, ob, slow, op2i, 3);
+}
+
+//+============================================================================ ========================================
+// disasm_image() for a CPU variant  - one switch per image, none per instruction
+//
+size_t  disasm_var (const image_t* img,  uint16_t org,  obuf_t* ob,  cpu_var_t var)
+{
+	switch (var) {
+		case VAR_NMOS :  return disasm_walk(img, org, ob, 0, op2i_nmos , 3);
+		case VAR_65C02:  return disasm_walk(img, org, ob, 0, op2i_65c02, 3);
+		case VAR_65816:  return disasm_walk(img, org, ob, 0, op2i_65816, 4);
+		default:         return disasm_walk(img, org, ob, 0, op2i      , 3);
+	}
+}
 
 //----------------------------------------------------------------------------- ----------------------------------------
-// A disassembled instruction
+// Control-flow listing
 //
-typedef
-	struct disasm {         // vv---Useful for: D=disassembly; E=emulation
-		char     mnem[8];   // D.: mnemonic
-		char     oper[16];  // D.: operands
-		amode_t  am;        // .E: Addressing Mode
-		int      len;       // DE: Instr/macro length
-		int      t;         // .E: Tcnt (for instr only (for now))  [+10, or +20 -> footnote #1, #2]
-		uint8_t  flg[3];    // .E: [0] clear, [1] set, [2] modify
+//   "LC000:"                               - Label  (branch/jump target)
+//   "AAAA  B0 B1 B2  MNM LC000"            - Branch/JMP/JSR operands are labels
+//   "AAAA  B0 B1     .word LC000"          - Vector or JMP (ind) pointer
+//   "AAAA            .byte $B0,$B1,..."    - Never reached  (up to 8 per line, broken at labels)
+//   "LC005 = $C005"                        - (header) targets outside the image, or inside an instruction
+//
+#define FLOW_LINE_MAX  (96)        // Label + longest line  (with slack)
+
+//+============================================================================ ========================================
+static inline  char*  flow_line_code (char* s,  const flow_t* f,  size_t off)
+{
+	const uint8_t*  pc   = &f->buf[off];
+	insn_t          in   = decode_insn(pc);
+	uint16_t        addr = flow_addr(f, off);
+	size_t          bank = off / f->bsz;
+
+	s    = hex4(s, addr);
+	*s++ = ' ';
+	*s++ = ' ';
+	s = hex2(s, pc[0]);  *s++ = ' ';
+	if (in.len > 1)  s = hex2(s, pc[1]) ;  else  *s++ = ' ', *s++ = ' ' ;
+	*s++ = ' ';
+	if (in.len > 2)  s = hex2(s, pc[2]) ;  else  *s++ = ' ', *s++ = ' ' ;
+	*s++ = ' ';
+	*s++ = ' ';
+
+	if (in.am == AM_REL) {
+		memcpy(s, mnem[op2i[in.op].mnem], 3);
+		s    += 3;
+		*s++  = ' ';
+		s     = flow_label(s, f, bank, insn_target(in, addr));
+	} else if ((in.am == AM_ABS) && ((in.op == OP_JMP_ABS) || (in.op == OP_JSR_ABS))) {
+		memcpy(s, mnem[op2i[in.op].mnem], 3);
+		s    += 3;
+		*s++  = ' ';
+		s     = flow_label(s, f, bank, in.oper);
+	} else {
+		s = insn_render(s, in, addr);
+	}
+
+	*s++ = '\n';
+	return s;
+}
+
+//+============================================================================ ========================================
+// Render the analysed image
+// Returns the number of lines emitted
+//
+size_t  flow_list (const flow_t* f,  obuf_t* ob)
+{
+	char*   lim = ob->buf + DIS_OBUF_SZ - FLOW_LINE_MAX;
+	size_t  cnt = 0;
+	size_t  off = 0;
+
+	// Equates
+	for (unsigned addr = 0;  addr < 0x10000;  addr++) {
+		if (ob->p >= lim)  obuf_flush(ob) ;
+		if (f->ext[addr >> 3] & (1 << (addr & 7))) {
+			ob->p  = strput(hex4(strput(flow_label(ob->p, f, f->sz / f->bsz + 1, addr), " = $"), addr), "\n");   // (no such bank)
+			cnt++;
+		}
+	}
+	for (size_t i = 0;  i < f->sz;  i++) {
+		if (ob->p >= lim)  obuf_flush(ob) ;
+		if ((f->cls[i] & (FL_LBL | FL_CLS)) == (FL_LBL | FL_OPER)) {
+			ob->p  = flow_label(ob->p, f, i / f->bsz, flow_addr(f, i));
+			ob->p  = strput(hex4(strput(ob->p, " = $"), flow_addr(f, i)), "\n");
+			cnt++;
+		}
 	}
-disasm_t;
+
+	while (off < f->sz) {
+		uint8_t   cl   = f->cls[off];
+		uint16_t  addr = flow_addr(f, off);
+		size_t    bank = off / f->bsz;
+		size_t    bend = (bank + 1) * f->bsz;
+		char*     s;
+
+		if (ob->p >= lim)  obuf_flush(ob) ;
+		s = ob->p;
+
+		if ((f->sz > f->bsz) && !(off % f->bsz)) {
+			s = strput(hex2(strput(s, "\n; bank $"), bank), "\n");
+		}
+		if (cl & FL_LBL)  s = strput(flow_label(s, f, bank, addr), ":\n") ;
+
+		if ((cl & FL_CLS) == FL_CODE) {
+			s    = flow_line_code(s, f, off);
+			off += op2i[f->buf[off]].len;
+
+		} else if (((cl & FL_CLS) == FL_WORD) && (off + 1 < f->sz) && (off + 1 < bend)
+		           && ((f->cls[off + 1] & (FL_CLS | FL_LBL)) == FL_WORD)) {
+			s    = hex4(s, addr);
+			s    = strput(hex2(strput(hex2(strput(s, "  "), f->buf[off]), " "), f->buf[off + 1]), "     .word ");
+			s    = flow_label(s, f, bank, f->buf[off] | (f->buf[off + 1] << 8));
+			*s++ = '\n';
+			off += 2;
+
+		} else {                                          // Data: until the next label, or anything else
+			s = strput(hex4(s, addr), "            .byte $");
+			s = hex2(s, f->buf[off++]);
+			for (int n = 1;  (n < 8) && (off < f->sz) && (off < bend) && (f->cls[off] == FL_NONE);  n++)
+				s = hex2(strput(s, ",$"), f->buf[off++]);
+			*s++ = '\n';
+		}
+
+		ob->p = s;
+		cnt++;
+	}
+
+	return cnt;
+}
+
+//+============================================================================ ========================================
+// Follow the control flow of an image and list it
+//   ent : extra entry points (hex), tried in every bank
+//
+int  disasm_flow (const image_t* img,  uint16_t org,  int nent,  char* ent[])
+{
+	flow_t  f;
+	obuf_t  ob = {malloc(DIS_OBUF_SZ), NULL, STDOUT_FILENO};
+
+	if (!ob.buf)  return perror("malloc"), 1 ;
+	if (flow_init(&f, img->buf, img->sz, org) < 0)  return perror("flow_init"), free(ob.buf), 1 ;
+
+	flow_vectors(&f);
+	for (int i = 0;  i < nent;  i++)
+		for (size_t bank = 0;  bank * f.bsz < f.sz;  bank++)
+			flow_entry(&f, bank, strtoul(ent[i], NULL, 16), FL_LBL | FL_ENT);
+	flow_run(&f);
+
+	ob.p = ob.buf;
+	flow_list(&f, &ob);
+	obuf_flush(&ob);
+	free(ob.buf);
+
+	fprintf(stderr, "%zu instructions\n", f.ninsn);
+	flow_free(&f);
+	return 0;
+}
+
+//+============================================================================ ========================================
+// Print an index range:  "X=00-7F", "Y=10", or "" when it could be anything
+//
+static  const char*  range_str (char* s,  char reg,  const uint8_t r[2])
+{
+	if      ((r[0] == 0x00) && (r[1] == 0xFF))  *s = '\0' ;
+	else if (r[0] == r[1])                      sprintf(s, "%c=%02X", reg, r[0]) ;
+	else                                        sprintf(s, "%c=%02X-%02X", reg, r[0], r[1]) ;
+	return s;
+}
+
+//+============================================================================ ========================================
+// Static timing of the code in lo..hi  (lo is also an entry point)
+//   ent : lo, hi, then extra entry points (hex), tried in every bank
+//
+int  disasm_time (const image_t* img,  uint16_t org,  int nent,  char* ent[])
+{
+	flow_t    f;
+	timing_t  tm;
+	uint16_t  lo = strtoul(ent[0], NULL, 16);
+	uint16_t  hi = strtoul(ent[1], NULL, 16);
+	char      lbl[16], lbl2[16], xs[16], ys[16];
+
+	if (flow_init(&f, img->buf, img->sz, org) < 0)  return perror("flow_init"), 1 ;
+
+	flow_vectors(&f);
+	for (int i = 0;  i < nent;  i += i ? 1 : 2)                  // lo, then anything after hi
+		for (size_t bank = 0;  bank * f.bsz < f.sz;  bank++)
+			flow_entry(&f, bank, strtoul(ent[i], NULL, 16), FL_LBL | FL_ENT);
+	flow_run(&f);
+
+	if (time_init(&tm, &f) < 0)  return perror("time_init"), flow_free(&f), 1 ;
+
+	printf("; block        bytes       n   min   max  exit  entry\n");
+	for (size_t i = 0;  i < tm.nblk;  i++) {
+		const tm_blk_t*  b    = &tm.blk[i];
+		uint16_t         addr = flow_addr(&f, b->off);
+
+		if ((addr < lo) || (addr > hi))  continue ;
+		*flow_label(lbl, &f, b->off / f.bsz, addr) = '\0';
+		range_str(xs, 'X', b->xr);
+		range_str(ys, 'Y', b->yr);
+		printf("%-12s  %04X-%04X  %3u  %4u  %4u  %-4s  %s%s%s\n", lbl, addr, flow_addr(&f, b->end - 1), b->n,
+		       b->min + b->nt, b->max + b->tk,
+		       (b->term == TM_BR) ? ((b->tk > 3) ? "br++" : "br+") : (b->term == TM_JMP) ? "jmp" :
+		       (b->term == TM_FALL) ? "-" : "stop",
+		       xs, (*xs && *ys) ? " " : "", ys);
+	}
+
+	printf("\n; loop         latch          min   max  index\n");
+	for (size_t i = 0;  i < tm.nloop;  i++) {
+		const tm_loop_t*  lp = &tm.loop[i];
+		const tm_blk_t*   h  = &tm.blk[lp->head];
+		const tm_blk_t*   l  = &tm.blk[lp->latch];
+		uint16_t          ha = flow_addr(&f, h->off);
+
+		if ((ha < lo) || (ha > hi))  continue ;
+		*flow_label(lbl , &f, h->off / f.bsz, ha) = '\0';
+		*flow_label(lbl2, &f, l->off / f.bsz, flow_addr(&f, l->off)) = '\0';
+		if (lp->min == 0xFFFF)  printf("%-12s  %-12s     -     -\n", lbl, lbl2) ;
+		else  printf("%-12s  %-12s  %4u  %4u  %s\n", lbl, lbl2, lp->min, lp->max, lp->reg ? range_str(xs, lp->reg, lp->r) : "") ;
+	}
+
+	time_free(&tm);
+	flow_free(&f);
+	return 0;
+}
+
+//+============================================================================ ========================================
+static  double  now (void)
+{
+	struct timespec  ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+//+============================================================================ ========================================
+// Compare the two output paths:  bytes/sec & byte-identical output
+//
+int  disasm_bench (const image_t* img,  uint16_t org)
+{
+	static const char*  name[2] = {"hexfmt ", "sprintf"};
+	double              bps[2];
+
+	for (int slow = 0;  slow <= 1;  slow++) {
+		obuf_t  ob   = {malloc(DIS_OBUF_SZ), NULL, -1};
+		int     reps = 0;
+		double  t0, t;
+
+		if (!ob.buf)  return perror("malloc"), 1 ;
+		ob.p = ob.buf;
+		t0   = now();
+		do {
+			disasm_image(img, org, &ob, slow);
+			obuf_flush(&ob);
+			reps++;
+		} while ((t = now() - t0) < 1.0) ;
+
+		bps[slow] = (double)img->sz * reps / t;
+		printf("%s : %10.2f MB/s  (%d passes over %zu bytes)\n", name[slow], bps[slow] / 1e6, reps, img->sz);
+		free(ob.buf);
+	}
+	printf("speedup : %10.2fx\n", bps[0] / bps[1]);
+
+	// Both paths must agree (the first buffer-load is enough to catch a formatting slip)
+	{
+		obuf_t  a = {malloc(DIS_OBUF_SZ), NULL, -1};
+		obuf_t  b = {malloc(DIS_OBUF_SZ), NULL, -1};
+		image_t part = {img->buf, img->sz < (DIS_OBUF_SZ / DIS_LINE_MAX) ? img->sz : (DIS_OBUF_SZ / DIS_LINE_MAX)};
+		int     ok;
+
+		if (!a.buf || !b.buf)  return perror("malloc"), free(a.buf), free(b.buf), 1 ;
+		a.p = a.buf;
+		b.p = b.buf;
+		disasm_image(&part, org, &a, 0);
+		disasm_image(&part, org, &b, 1);
+		ok = ((a.p - a.buf) == (b.p - b.buf)) && !memcmp(a.buf, b.buf, a.p - a.buf);
+		printf("output  : %s\n", ok ? "identical" : "MISMATCH");
+		free(a.buf);
+		free(b.buf);
+		return ok ? 0 : 1;
+	}
+}
 
 //----------------------------------------------------------------------------- ----------------------------------------
-// Instruction decoder table
+// Batch disassembly
 //
+// Every worker owns a slice [lo, hi) of the job list, packed into one atomic word.
+// The owner takes jobs from the bottom; an idle worker steals the top half of the first slice that is not empty,
+// looking round from its own.
+// Both are a single CAS, so there are no locks - and op2i[] is const, so the decoder has no shared state at all.
+// Each worker has its own output buffer and writes its own files.
+//
+#define BATCH_MAX   (256)          // Threads
+
 typedef
-	struct decode {
-		char     mnem[8];   // mnemonic
-		amode_t  am;        // Addressing Mode
-		int      len;       // Instr/macro length
-		int      t;         // Tcnt (for instr only (for now))  [+10, or +20 -> footnote #1, #2]   <-- 0_o
-		uint8_t  flg[3];    // [0] clear, [1] set, [2] modify
+	struct job {
+		char*     fn;             // Image
+		uint16_t  org;
+		size_t    sz;             // (filled in by the worker)
 	}
-decode_t;
+job_t;
 
-decode_t  op2i[256];
+typedef
+	struct batch {
+		job_t*            job;
+		size_t            njob;
+		const char*       out;                  // Output directory
+		int               num;                  // Number the outputs  (a list may name one file name in two directories)
+		cpu_var_t         var;
+		int               nthr;
+		_Atomic uint64_t  slice[BATCH_MAX];     // Per worker:  lo | hi << 32
+	}
+batch_t;
+
+typedef
+	struct worker {
+		batch_t*   b;
+		int        id;
+		size_t     done, stolen;  // Jobs run, and how many of them were stolen
+		size_t     bytes;
+	}
+worker_t;
 
 //+============================================================================ ========================================
-// Called when the program exits
+// Take the next job from our own slice  (-1 -> empty)
 //
-void  setup (void) 
+static  long  batch_pop (batch_t* b,  int id)
 {
-	memset(op2i, 0, sizeof(op2i));
-	
-	//
-	// Footnotes:
-	//   [1] : (Tcnt += 1) if page boundary is crossed         // +10
-	//   [2] : (Tcnt += 1) if branch occurs on same page       // +20
-	//       : (Tcnt += 2) if branch occurs to different page  // ...
-	//
-	//                                    addr    len TCnt |<----------------flags------------------->|
-	//   opcode                    mnem     mode   V  VV   | reset  |   set   |         modify        |
-	op2i[OP_ADC_ABS ] = (decode_t){"ADC", AM_ABS , 3,  4, {FLG_NONE, FLG_NONE, FLG_N|FLG_V|FLG_Z|FLG_C}};
-	op2i[OP_ADC_ABSX] = (decode_t){"ADC", AM_ABSX, 3, 14, {FLG_NONE, FLG_NONE, FLG_N|FLG_V|FLG_Z|FLG_C}};
-	op2i[OP_ADC_ABSY] = (decode_t){"ADC", AM_ABSY, 3, 14, {FLG_NONE, FLG_NONE, FLG_N|FLG_V|FLG_Z|FLG_C}};
-	op2i[OP_ADC_IMM ] = (decode_t){"ADC", AM_IMM , 2,  2, {FLG_NONE, FLG_NONE, FLG_N|FLG_V|FLG_Z|FLG_C}};
-	op2i[OP_ADC_INDX] = (decode_t){"ADC", AM_INDX, 2,  6, {FLG_NONE, FLG_NONE, FLG_N|FLG_V|FLG_Z|FLG_C}};
-	op2i[OP_ADC_INDY] = (decode_t){"ADC", AM_INDY, 2, 15, {FLG_NONE, FLG_NONE, FLG_N|FLG_V|FLG_Z|FLG_C}};
-	op2i[OP_ADC_ZP  ] = (decode_t){"ADC", AM_ZP  , 2,  3, {FLG_NONE, FLG_NONE, FLG_N|FLG_V|FLG_Z|FLG_C}};
-	op2i[OP_ADC_ZPX ] = (decode_t){"ADC", AM_ZPX , 2,  4, {FLG_NONE, FLG_NONE, FLG_N|FLG_V|FLG_Z|FLG_C}};
-	op2i[OP_AND_ABS ] = (decode_t){"AND", AM_ABS , 3,  4, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }};
-	op2i[OP_AND_ABSX] = (decode_t){"AND", AM_ABSX, 3, 14, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }};
-	op2i[OP_AND_ABSY] = (decode_t){"AND", AM_ABSY, 3, 14, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }};
-	op2i[OP_AND_IMM ] = (decode_t){"AND", AM_IMM , 2,  2, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }};
-	op2i[OP_AND_INDX] = (decode_t){"AND", AM_INDX, 2,  6, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }};
-	op2i[OP_AND_INDY] = (decode_t){"AND", AM_INDY, 2, 15, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }};
-	op2i[OP_AND_ZP  ] = (decode_t){"AND", AM_ZP  , 2,  3, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }};
-	op2i[OP_AND_ZPX ] = (decode_t){"AND", AM_ZPX , 2,  4, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }};
-	op2i[OP_ASL_ABS ] = (decode_t){"ASL", AM_ABS , 3,  6, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}};
-	op2i[OP_ASL_ABSX] = (decode_t){"ASL", AM_ABSX, 3,  7, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}};
-	op2i[OP_ASL_ACC ] = (decode_t){"ASL", AM_ACC , 1,  2, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}};
-	op2i[OP_ASL_ZP  ] = (decode_t){"ASL", AM_ZP  , 2,  5, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}};
-	op2i[OP_ASL_ZPX ] = (decode_t){"ASL", AM_ZPX , 2,  6, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}};
-	op2i[OP_BCC_REL ] = (decode_t){"BCC", AM_REL , 2, 22, {FLG_NONE, FLG_NONE, FLG_NONE               }};
-	op2i[OP_BCS_REL ] = (decode_t){"BCS", AM_REL , 2, 22, {FLG_NONE, FLG_NONE, FLG_NONE               }};
-	op2i[OP_BEQ_REL ] = (decode_t){"BEQ", AM_REL , 2, 22, {FLG_NONE, FLG_NONE, FLG_NONE               }};
-	op2i[OP_BIT_ABS ] = (decode_t){"BIT", AM_ABS , 3,  4, {FLG_NONE, FLG_NONE, FLG_N|FLG_V|FLG_Z      }};
-	op2i[OP_BIT_ZP  ] = (decode_t){"BIT", AM_ZP  , 2,  3, {FLG_NONE, FLG_NONE, FLG_N|FLG_V|FLG_Z      }};
-	op2i[OP_BMI_REL ] = (decode_t){"BMI", AM_REL , 2, 22, {FLG_NONE, FLG_NONE, FLG_NONE               }};
-	op2i[OP_BNE_REL ] = (decode_t){"BNE", AM_REL , 2, 22, {FLG_NONE, FLG_NONE, FLG_NONE               }};
-	op2i[OP_BPL_REL ] = (decode_t){"BPL", AM_REL , 2, 22, {FLG_NONE, FLG_NONE, FLG_NONE               }};
-	op2i[OP_BRK_IMP ] = (decode_t){"BRK", AM_IMP , 1,  7, {FLG_NONE, FLG_I,    FLG_NONE               }};
-	op2i[OP_BVC_REL ] = (decode_t){"BVC", AM_REL , 2, 22, {FLG_NONE, FLG_NONE, FLG_NONE               }};
-	op2i[OP_BVS_REL ] = (decode_t){"BVS", AM_REL , 2, 22, {FLG_NONE, FLG_NONE, FLG_NONE               }};
-	op2i[OP_CLC_IMP ] = (decode_t){"CLC", AM_IMP , 1,  2, {FLG_C,    FLG_NONE, FLG_NONE               }};
-	op2i[OP_CLD_IMP ] = (decode_t){"CLD", AM_IMP , 1,  2, {FLG_D,    FLG_NONE, FLG_NONE               }};
-	op2i[OP_CLI_IMP ] = (decode_t){"CLI", AM_IMP , 1,  2, {FLG_I,    FLG_NONE, FLG_NONE               }};
-	op2i[OP_CLV_IMP ] = (decode_t){"CLV", AM_IMP , 1,  2, {FLG_V,    FLG_NONE, FLG_NONE               }};
-	op2i[OP_CMP_ABS ] = (decode_t){"CMP", AM_ABS , 3,  4, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}};
-	op2i[OP_CMP_ABSX] = (decode_t){"CMP", AM_ABSX, 3, 14, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}};
-	op2i[OP_CMP_ABSY] = (decode_t){"CMP", AM_ABSY, 3, 14, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}};
-	op2i[OP_CMP_IMM ] = (decode_t){"CMP", AM_IMM , 2,  2, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}};
-	op2i[OP_CMP_INDX] = (decode_t){"CMP", AM_INDX, 2,  6, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}};
-	op2i[OP_CMP_INDY] = (decode_t){"CMP", AM_INDY, 2, 15, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}};
-	op2i[OP_CMP_ZP  ] = (decode_t){"CMP", AM_ZP  , 2,  3, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}};
-	op2i[OP_CMP_ZPX ] = (decode_t){"CMP", AM_ZPX , 2,  4, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}};
-	op2i[OP_CPX_ABS ] = (decode_t){"CPX", AM_ABS , 3,  4, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}};
-	op2i[OP_CPX_IMM ] = (decode_t){"CPX", AM_IMM , 2,  2, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}};
-	op2i[OP_CPX_ZP  ] = (decode_t){"CPX", AM_ZP  , 2,  3, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}};
-	op2i[OP_CPY_ABS ] = (decode_t){"CPY", AM_ABS , 3,  4, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}};
-	op2i[OP_CPY_IMM ] = (decode_t){"CPY", AM_IMM , 2,  2, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}};
-	op2i[OP_CPY_ZP  ] = (decode_t){"CPY", AM_ZP  , 2,  3, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}};
-	op2i[OP_DEC_ABS ] = (decode_t){"DEC", AM_ABS , 3,  6, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }};
-	op2i[OP_DEC_ABSX] = (decode_t){"DEC", AM_ABSX, 3,  7, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }};
-	op2i[OP_DEC_ZP  ] = (decode_t){"DEC", AM_ZP  , 2,  5, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }};
-	op2i[OP_DEC_ZPX ] = (decode_t){"DEC", AM_ZPX , 2,  6, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }};
-	op2i[OP_DEX_IMP ] = (decode_t){"DEX", AM_IMP , 1,  2, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }};
-	op2i[OP_DEY_IMP ] = (decode_t){"DEY", AM_IMP , 1,  2, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }};
-	op2i[OP_EOR_ABS ] = (decode_t){"EOR", AM_ABS , 3,  4, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }};
-	op2i[OP_EOR_ABSX] = (decode_t){"EOR", AM_ABSX, 3, 14, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }};
-	op2i[OP_EOR_ABSY] = (decode_t){"EOR", AM_ABSY, 3, 14, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }};
-	op2i[OP_EOR_IMM ] = (decode_t){"EOR", AM_IMM , 2,  2, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }};
-	op2i[OP_EOR_INDX] = (decode_t){"EOR", AM_INDX, 2,  6, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }};
-	op2i[OP_EOR_INDY] = (decode_t){"EOR", AM_INDY, 2, 15, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }};
-	op2i[OP_EOR_ZP  ] = (decode_t){"EOR", AM_ZP  , 2,  3, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }};
-	op2i[OP_EOR_ZPX ] = (decode_t){"EOR", AM_ZPX , 2,  4, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }};
-	op2i[OP_INC_ABS ] = (decode_t){"INC", AM_ABS , 3,  6, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }};
-	op2i[OP_INC_ABSX] = (decode_t){"INC", AM_ABSX, 3,  7, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }};
-	op2i[OP_INC_ZP  ] = (decode_t){"INC", AM_ZP  , 2,  5, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }};
-	op2i[OP_INC_ZPX ] = (decode_t){"INC", AM_ZPX , 2,  6, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }};
-	op2i[OP_INX_IMP ] = (decode_t){"INX", AM_IMP , 1,  2, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }};
-	op2i[OP_INY_IMP ] = (decode_t){"INY", AM_IMP , 1,  2, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }};
-	op2i[OP_JMP_ABS ] = (decode_t){"JMP", AM_ABS , 3,  3, {FLG_NONE, FLG_NONE, FLG_NONE               }};            
-	op2i[OP_JMP_IND ] = (decode_t){"JMP", AM_IND , 3,  5, {FLG_NONE, FLG_NONE, FLG_NONE               }};            
-	op2i[OP_JSR_ABS ] = (decode_t){"JSR", AM_ABS , 3,  6, {FLG_NONE, FLG_NONE, FLG_NONE               }};            
-	op2i[OP_LDA_ABS ] = (decode_t){"LDA", AM_ABS , 3,  4, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }};
-	op2i[OP_LDA_ABSX] = (decode_t){"LDA", AM_ABSX, 3, 14, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }};
-	op2i[OP_LDA_ABSY] = (decode_t){"LDA", AM_ABSY, 3, 14, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }};
-	op2i[OP_LDA_IMM ] = (decode_t){"LDA", AM_IMM , 2,  2, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }};
-	op2i[OP_LDA_INDX] = (decode_t){"LDA", AM_INDX, 2,  6, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }};
-	op2i[OP_LDA_INDY] = (decode_t){"LDA", AM_INDY, 2, 15, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }};
-	op2i[OP_LDA_ZP  ] = (decode_t){"LDA", AM_ZP  , 2,  3, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }};
-	op2i[OP_LDA_ZPX ] = (decode_t){"LDA", AM_ZPX , 2,  4, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }};
-	op2i[OP_LDX_ABS ] = (decode_t){"LDX", AM_ABS , 3,  4, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }};
-	op2i[OP_LDX_ABSY] = (decode_t){"LDX", AM_ABSY, 3, 14, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }};
-	op2i[OP_LDX_IMM ] = (decode_t){"LDX", AM_IMM , 2,  2, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }};
-	op2i[OP_LDX_ZP  ] = (decode_t){"LDX", AM_ZP  , 2,  3, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }};
-	op2i[OP_LDX_ZPY ] = (decode_t){"LDX", AM_ZPY , 2,  4, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }};
-	op2i[OP_LDY_ABS ] = (decode_t){"LDY", AM_ABS , 3,  4, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }};
-	op2i[OP_LDY_ABSX] = (decode_t){"LDY", AM_ABSX, 3, 14, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }};
-	op2i[OP_LDY_IMM ] = (decode_t){"LDY", AM_IMM , 2,  2, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }};
-	op2i[OP_LDY_ZP  ] = (decode_t){"LDY", AM_ZP  , 2,  3, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }};
-	op2i[OP_LDY_ZPX ] = (decode_t){"LDY", AM_ZPX , 2,  4, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }};
-	op2i[OP_LSR_ABS ] = (decode_t){"LSR", AM_ABS , 3,  6, {FLG_N,    FLG_NONE, FLG_Z            |FLG_C}};
-	op2i[OP_LSR_ABSX] = (decode_t){"LSR", AM_ABSX, 3,  7, {FLG_N,    FLG_NONE, FLG_Z            |FLG_C}};
-	op2i[OP_LSR_IMM ] = (decode_t){"LSR", AM_ACC , 1,  2, {FLG_N,    FLG_NONE, FLG_Z            |FLG_C}};
-	op2i[OP_LSR_ZP  ] = (decode_t){"LSR", AM_ZP  , 2,  5, {FLG_N,    FLG_NONE, FLG_Z            |FLG_C}};
-	op2i[OP_LSR_ZPX ] = (decode_t){"LSR", AM_ZPX , 2,  6, {FLG_N,    FLG_NONE, FLG_Z            |FLG_C}};
-	op2i[OP_NOP_IMP ] = (decode_t){"NOP", AM_IMP , 1,  2, {FLG_NONE, FLG_NONE, FLG_NONE               }};
-	op2i[OP_ORA_ABS ] = (decode_t){"ORA", AM_ABS , 3,  4, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }};
-	op2i[OP_ORA_ABSX] = (decode_t){"ORA", AM_ABSX, 3, 14, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }};
-	op2i[OP_ORA_ABSY] = (decode_t){"ORA", AM_ABSY, 3, 14, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }};
-	op2i[OP_ORA_IMM ] = (decode_t){"ORA", AM_IMM , 2,  2, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }};
-	op2i[OP_ORA_INDX] = (decode_t){"ORA", AM_INDX, 2,  6, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }};
-	op2i[OP_ORA_INDY] = (decode_t){"ORA", AM_INDY, 2, 15, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }};
-	op2i[OP_ORA_ZP  ] = (decode_t){"ORA", AM_ZP  , 2,  3, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }};
-	op2i[OP_ORA_ZPX ] = (decode_t){"ORA", AM_ZPX , 2,  4, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }};
-	op2i[OP_PHA_IMP ] = (decode_t){"PHA", AM_IMP , 1,  3, {FLG_NONE, FLG_NONE, FLG_NONE               }};
-	op2i[OP_PHP_IMP ] = (decode_t){"PHP", AM_IMP , 1,  3, {FLG_NONE, FLG_NONE, FLG_NONE               }};
-	op2i[OP_PLA_IMP ] = (decode_t){"PLA", AM_IMP , 1,  4, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }};
-	op2i[OP_PLP_IMP ] = (decode_t){"PLP", AM_IMP , 1,  4, {FLG_NONE, FLG_NONE, FLG_ALL                }};
-	op2i[OP_ROL_ABS ] = (decode_t){"ROL", AM_ABS , 3,  6, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}};
-	op2i[OP_ROL_ABSX] = (decode_t){"ROL", AM_ABSX, 3,  7, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}};
-	op2i[OP_ROL_ACC ] = (decode_t){"ROL", AM_ACC , 1,  2, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}};
-	op2i[OP_ROL_ZP  ] = (decode_t){"ROL", AM_ZP  , 2,  5, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}};
-	op2i[OP_ROL_ZPX ] = (decode_t){"ROL", AM_ZPX , 2,  6, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}};
-	op2i[OP_ROR_ABS ] = (decode_t){"ROR", AM_ABS , 3,  6, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}};
-	op2i[OP_ROR_ABSX] = (decode_t){"ROR", AM_ABSX, 3,  7, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}};
-	op2i[OP_ROR_ACC ] = (decode_t){"ROR", AM_ACC , 1,  2, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}};
-	op2i[OP_ROR_ZP  ] = (decode_t){"ROR", AM_ZP  , 2,  5, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}};
-	op2i[OP_ROR_ZPX ] = (decode_t){"ROR", AM_ZPX , 2,  6, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}};
-	op2i[OP_RTI_IMP ] = (decode_t){"RTI", AM_IMP , 1,  6, {FLG_NONE, FLG_NONE, FLG_ALL                }};
-	op2i[OP_RTS_IMP ] = (decode_t){"RTS", AM_IMP , 1,  6, {FLG_NONE, FLG_NONE, FLG_NONE               }};
-	op2i[OP_SBC_ABS ] = (decode_t){"SBC", AM_ABS , 3,  4, {FLG_NONE, FLG_NONE, FLG_N|FLG_V|FLG_Z|FLG_C}};
-	op2i[OP_SBC_ABSX] = (decode_t){"SBC", AM_ABSX, 3, 14, {FLG_NONE, FLG_NONE, FLG_N|FLG_V|FLG_Z|FLG_C}};
-	op2i[OP_SBC_ABSY] = (decode_t){"SBC", AM_ABSY, 3, 14, {FLG_NONE, FLG_NONE, FLG_N|FLG_V|FLG_Z|FLG_C}};
-	op2i[OP_SBC_IMM ] = (decode_t){"SBC", AM_IMM , 2,  2, {FLG_NONE, FLG_NONE, FLG_N|FLG_V|FLG_Z|FLG_C}};
-	op2i[OP_SBC_INDX] = (decode_t){"SBC", AM_INDX, 2,  6, {FLG_NONE, FLG_NONE, FLG_N|FLG_V|FLG_Z|FLG_C}};
-	op2i[OP_SBC_INDY] = (decode_t){"SBC", AM_INDY, 2, 15, {FLG_NONE, FLG_NONE, FLG_N|FLG_V|FLG_Z|FLG_C}};
-	op2i[OP_SBC_ZP  ] = (decode_t){"SBC", AM_ZP  , 2,  3, {FLG_NONE, FLG_NONE, FLG_N|FLG_V|FLG_Z|FLG_C}};
-	op2i[OP_SBC_ZPX ] = (decode_t){"SBC", AM_ZPX , 2,  4, {FLG_NONE, FLG_NONE, FLG_N|FLG_V|FLG_Z|FLG_C}};
-	op2i[OP_SEC_IMP ] = (decode_t){"SEC", AM_IMP , 1,  2, {FLG_NONE, FLG_C,    FLG_NONE               }};
-	op2i[OP_SED_IMP ] = (decode_t){"SED", AM_IMP , 1,  2, {FLG_NONE, FLG_D,    FLG_NONE               }};
-	op2i[OP_SEI_IMP ] = (decode_t){"SEI", AM_IMP , 1,  2, {FLG_NONE, FLG_I,    FLG_NONE               }};
-	op2i[OP_STA_ABS ] = (decode_t){"STA", AM_ABS , 3,  4, {FLG_NONE, FLG_NONE, FLG_NONE               }};
-	op2i[OP_STA_ABSX] = (decode_t){"STA", AM_ABSX, 3,  5, {FLG_NONE, FLG_NONE, FLG_NONE               }};
-	op2i[OP_STA_ABSY] = (decode_t){"STA", AM_ABSY, 3,  5, {FLG_NONE, FLG_NONE, FLG_NONE               }};
-	op2i[OP_STA_INDX] = (decode_t){"STA", AM_INDX, 2,  6, {FLG_NONE, FLG_NONE, FLG_NONE               }};
-	op2i[OP_STA_INDY] = (decode_t){"STA", AM_INDY, 2,  6, {FLG_NONE, FLG_NONE, FLG_NONE               }};
-	op2i[OP_STA_ZP  ] = (decode_t){"STA", AM_ZP  , 2,  3, {FLG_NONE, FLG_NONE, FLG_NONE               }};
-	op2i[OP_STA_ZPX ] = (decode_t){"STA", AM_ZPX , 2,  4, {FLG_NONE, FLG_NONE, FLG_NONE               }};
-	op2i[OP_STX_ABS ] = (decode_t){"STX", AM_ABS , 3,  4, {FLG_NONE, FLG_NONE, FLG_NONE               }};
-	op2i[OP_STX_ZP  ] = (decode_t){"STX", AM_ZP  , 2,  3, {FLG_NONE, FLG_NONE, FLG_NONE               }};
-	op2i[OP_STX_ZPY ] = (decode_t){"STX", AM_ZPY , 2,  4, {FLG_NONE, FLG_NONE, FLG_NONE               }};
-	op2i[OP_STY_ABS ] = (decode_t){"STY", AM_ABS , 3,  4, {FLG_NONE, FLG_NONE, FLG_NONE               }};
-	op2i[OP_STY_ZP  ] = (decode_t){"STY", AM_ZP  , 2,  3, {FLG_NONE, FLG_NONE, FLG_NONE               }};
-	op2i[OP_STY_ZPX ] = (decode_t){"STY", AM_ZPX , 2,  4, {FLG_NONE, FLG_NONE, FLG_NONE               }};
-	op2i[OP_TAX_IMP ] = (decode_t){"TAX", AM_IMP , 1,  2, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }};
-	op2i[OP_TAY_IMP ] = (decode_t){"TAY", AM_IMP , 1,  2, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }};
-	op2i[OP_TSX_IMP ] = (decode_t){"TSX", AM_IMP , 1,  2, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }};
-	op2i[OP_TXA_IMP ] = (decode_t){"TXA", AM_IMP , 1,  2, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }};
-	op2i[OP_TXS_IMP ] = (decode_t){"TXS", AM_IMP , 1,  2, {FLG_NONE, FLG_NONE, FLG_NONE               }};
-	op2i[OP_TYA_IMP ] = (decode_t){"TYA", AM_IMP , 1,  2, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }};
+	uint64_t  v = atomic_load(&b->slice[id]);
+
+	for (;;) {
+		uint32_t  lo = v,  hi = v >> 32;
+
+		if (lo >= hi)                                                           return -1 ;
+		if (atomic_compare_exchange_weak(&b->slice[id], &v, (lo + 1) | ((uint64_t)hi << 32)))  return lo ;
+	}
 }
 
 //+============================================================================ ========================================
-int  decode (uint8_t* pc,  disasm_t* pDis)
+// Move the top half of somebody else's slice into ours  (0 -> nothing left anywhere)
+//
+static  int  batch_steal (batch_t* b,  int id)
 {
-	decode_t*  pDec = &op2i[*pc];
-
-	strcpy(pDis->mnem, pDec->mnem);
-	*pDis->oper = '\0';
-
-	switch (pDis->am = pDec->am) {
-		case AM_IMP :  sprintf(pDis->oper, ""                          );  break ;
-		case AM_REL :  sprintf(pDis->oper, "lbl"                       );  break ;
-		case AM_ACC :  sprintf(pDis->oper, "A"                         );  break ;
-		case AM_IMM :  sprintf(pDis->oper, "#$%02X"    , PEEK8   (pc+1));  break ;
-		case AM_ZP  :  sprintf(pDis->oper, "$%02X"     , PEEK8   (pc+1));  break ;
-		case AM_ZPX :  sprintf(pDis->oper, "$%02X, X"  , PEEK8   (pc+1));  break ;
-		case AM_ZPY :  sprintf(pDis->oper, "$%02X, Y"  , PEEK8   (pc+1));  break ;
-		case AM_ABS :  sprintf(pDis->oper, "$%04X"     , PEEK16LE(pc+1));  break ;
-		case AM_ABSX:  sprintf(pDis->oper, "$%04X, X"  , PEEK16LE(pc+1));  break ;
-		case AM_ABSY:  sprintf(pDis->oper, "$%04X, Y"  , PEEK16LE(pc+1));  break ;
-		case AM_IND :  sprintf(pDis->oper, "($%04X)"   , PEEK16LE(pc+1));  break ;
-		case AM_INDX:  sprintf(pDis->oper, "($%02X, X)", PEEK8   (pc+1));  break ;
-		case AM_INDY:  sprintf(pDis->oper, "($%02X), Y", PEEK8   (pc+1));  break ;
-		default:       sprintf(pDis->oper, "???"                       );  break ;
-	}                                                                  
-
-	pDis->len    = pDec->len;     // iLen
-	pDis->t      = pDec->t;       // TCnt
-	pDis->flg[0] = pDec->flg[0];  // clear
-	pDis->flg[1] = pDec->flg[1];  // set
-	pDis->flg[2] = pDec->flg[2];  // modify
-
-	return pDis->len;
+	for (int k = 1;  k < b->nthr;  k++) {
+		int       vic = (id + k) % b->nthr;
+		uint64_t  v   = atomic_load(&b->slice[vic]);
+
+		for (;;) {
+			uint32_t  lo = v,  hi = v >> 32,  mid;
+
+			if (lo >= hi)  break ;
+			mid = hi - (hi - lo + 1) / 2;
+			if (atomic_compare_exchange_weak(&b->slice[vic], &v, lo | ((uint64_t)mid << 32))) {
+				atomic_store(&b->slice[id], mid | ((uint64_t)hi << 32));   // Only we write an empty slice
+				return 1;
+			}
+		}
+	}
+	return 0;
 }
 
 //+============================================================================ ========================================
-int  main (int argc,  char* argv[],  char* envp[])
+static  void*  batch_worker (void* arg)
 {
-	// Initialise the disassembler
-	setup();
-	
-	// Table Header
-	printf("    <table summary=\"\" border=\"1\" cellpadding=\"0\" width=\"100%\">\n");
-	printf("      <tr align=\"center\">\n");
-	printf("        <th width=\"5%\">&nbsp;</th>\n");
-	printf("        <th width=\"5%\"><big><big>&#8209;</big></big>0</th>\n");
-	printf("        <th width=\"5%\"><big><big>&#8209;</big></big>1</th>\n");
-	printf("        <th width=\"5%\"><big><big>&#8209;</big></big>2</th>\n");
-	printf("        <th width=\"5%\"><big><big>&#8209;</big></big>3</th>\n");
-	printf("        <th width=\"5%\"><big><big>&#8209;</big></big>4</th>\n");
-	printf("        <th width=\"5%\"><big><big>&#8209;</big></big>5</th>\n");
-	printf("        <th width=\"5%\"><big><big>&#8209;</big></big>6</th>\n");
-	printf("        <th width=\"5%\"><big><big>&#8209;</big></big>7</th>\n");
-	printf("        <th width=\"5%\"><big><big>&#8209;</big></big>8</th>\n");
-	printf("        <th width=\"5%\"><big><big>&#8209;</big></big>9</th>\n");
-	printf("        <th width=\"5%\"><big><big>&#8209;</big></big>A</th>\n");
-	printf("        <th width=\"5%\"><big><big>&#8209;</big></big>B</th>\n");
-	printf("        <th width=\"5%\"><big><big>&#8209;</big></big>C</th>\n");
-	printf("        <th width=\"5%\"><big><big>&#8209;</big></big>D</th>\n");
-	printf("        <th width=\"5%\"><big><big>&#8209;</big></big>E</th>\n");
-	printf("        <th width=\"5%\"><big><big>&#8209;</big></big>F</th>\n");
-	printf("        <th width=\"5%\">&nbsp;</th>\n");
-	printf("      </tr>\n");
-
-	// Foreach row
-	for (int i = 0;  i <= 0xFF;  NULL) {
-		// Row: begin
-		printf("\n");
-		printf("      <tr>\n");
-		printf("        <th align=\"center\">&nbsp;%X<big><big>&#8209;</big></big>&nbsp;</th>\n", i>>4);
-		
-		// Foreach column
-		do {
-			uint8_t   ins[3] = {i, 0xA5, 0xB6};
+	worker_t*  w  = arg;
+	batch_t*   b  = w->b;
+	obuf_t     ob = {malloc(DIS_OBUF_SZ), NULL, -1};
+	int        st = 0;                          // Jobs in the current slice were stolen
+
+	if (!ob.buf)  return perror("malloc"), NULL ;
+
+	for (;;) {
+		long     j = batch_pop(b, w->id);
+		job_t*   jb;
+		image_t  img;
+		char     fn[4096];
+		char*    base;
+
+		if (j < 0) {
+			if (!batch_steal(b, w->id))  break ;
+			st = 1;
+			continue;
+		}
+
+		jb   = &b->job[j];
+		base = strrchr(jb->fn, '/');
+		base = base ? base + 1 : jb->fn;
+		if (b->num)  snprintf(fn, sizeof(fn), "%s/%ld-%s.dis", b->out, j + 1, base) ;
+		else         snprintf(fn, sizeof(fn), "%s/%s.dis", b->out, base) ;
+
+		if (image_open(&img, jb->fn) < 0)  continue ;
+		if ((ob.fd = open(fn, O_WRONLY | O_CREAT | O_TRUNC, 0644)) < 0) {
+			perror(fn);
+		} else {
+			ob.p = ob.buf;
+			disasm_var(&img, jb->org, &ob, b->var);
+			obuf_flush(&ob);
+			close(ob.fd);
+			jb->sz    = img.sz;
+			w->bytes += img.sz;
+			w->done++;
+			w->stolen += st;
+		}
+		image_close(&img);
+	}
+
+	free(ob.buf);
+	return NULL;
+}
+
+//+============================================================================ ========================================
+// Jobs from a directory (every regular file) or a list file ("file [org]" per line)
+// Returns the number of jobs  (-1 -> error)
+//
+static  long  batch_jobs (const char* src,  job_t** pjob,  int* num)
+{
+	struct stat  st;
+	size_t       n = 0,  cap = 1024;
+	job_t*       job = malloc(cap * sizeof(*job));
+	char         line[4096 + 16];
+
+	if (!job || (stat(src, &st) < 0))  return perror(src), free(job), -1 ;
+
+	#define BATCH_ADD(f, o)  do {                                         \
+			if ((n == cap) && !(job = realloc(job, (cap *= 2) * sizeof(*job))))  return perror("realloc"), -1 ;  \
+			job[n].fn  = strdup(f);                                       \
+			job[n].org = (o);                                             \
+			job[n].sz  = 0;                                               \
+			n++;                                                          \
+		} while (0)
+
+	*num = !S_ISDIR(st.st_mode);
+	if (S_ISDIR(st.st_mode)) {
+		DIR*            d = opendir(src);
+		struct dirent*  de;
+
+		if (!d)  return perror(src), free(job), -1 ;
+		while ((de = readdir(d))) {
+			struct stat  fs;
+			snprintf(line, sizeof(line), "%s/%s", src, de->d_name);
+			if ((stat(line, &fs) == 0) && S_ISREG(fs.st_mode))  BATCH_ADD(line, 0) ;
+		}
+		closedir(d);
+
+	} else {
+		FILE*  fh = fopen(src, "r");
+
+		if (!fh)  return perror(src), free(job), -1 ;
+		while (fgets(line, sizeof(line), fh)) {
+			char*  org = strpbrk(line, " \t\r\n");
+			char*  eol;
+
+			if (org)  *org++ = '\0' ;
+			if (!*line || (*line == '#'))  continue ;
+			BATCH_ADD(line, org ? strtoul(org, &eol, 16) : 0);
+		}
+		fclose(fh);
+	}
+
+	#undef BATCH_ADD
+
+	*pjob = job;
+	return n;
+}
+
+//+============================================================================ ========================================
+// Disassemble a corpus on 'nthr' threads  (0 -> one per online CPU)
+//
+int  disasm_batch (const char* src,  const char* out,  int nthr,  cpu_var_t var)
+{
+	static batch_t  b;
+	worker_t        w[BATCH_MAX];
+	pthread_t       th[BATCH_MAX];
+	long            n;
+	double          t0, t;
+	size_t          bytes = 0,  stolen = 0;
+
+	if ((n = batch_jobs(src, &b.job, &b.num)) < 0)  return 1 ;
+	if (nthr <= 0)  nthr = sysconf(_SC_NPROCESSORS_ONLN) ;
+	if (nthr > BATCH_MAX)  nthr = BATCH_MAX ;
+	if (nthr < 1)  nthr = 1 ;
+
+	b.njob = n;
+	b.out  = out;
+	b.var  = var;
+	b.nthr = nthr;
+	for (int i = 0;  i < nthr;  i++)                       // Contiguous slices of (near) equal size
+		atomic_init(&b.slice[i], (n * i / nthr) | ((uint64_t)(n * (i + 1) / nthr) << 32));
+
+	t0 = now();
+	for (int i = 0;  i < nthr;  i++) {
+		w[i] = (worker_t){&b, i, 0, 0, 0};
+		if (pthread_create(&th[i], NULL, batch_worker, &w[i]) != 0)  return perror("pthread_create"), 1 ;
+	}
+	for (int i = 0;  i < nthr;  i++) {
+		pthread_join(th[i], NULL);
+		bytes  += w[i].bytes;
+		stolen += w[i].stolen;
+	}
+	t = now() - t0;
+
+	fprintf(stderr, "%ld images, %zu bytes, %d threads : %.3fs  %.2f MB/s  (%zu stolen)\n",
+	        n, bytes, nthr, t, t ? bytes / t / 1e6 : 0, stolen);
+
+	for (long i = 0;  i < n;  i++)  free(b.job[i].fn) ;
+	free(b.job);
+	return 0;
+}
+
+//+============================================================================ ========================================
+// Check the pre-scan (vector & scalar) against a decode() sweep, then time it
+//
+int  disasm_scan (const image_t* img)
+{
+	size_t     sz    = img->sz;
+	size_t     nw    = (sz + 63) / 64;
+	size_t     sync[SCAN_SYNC_MAX] = {0, 1, 2, sz / 3, sz / 2 + 1, sz - (sz > 5 ? 5 : sz)};
+	int        nsync = 6;
+	uint64_t*  ref[SCAN_SYNC_MAX];
+	uint64_t*  got[SCAN_SYNC_MAX];
+	int        bad   = 0;
+
+	for (int k = 0;  k < nsync;  k++) {
+		ref[k] = calloc(nw + 1, sizeof(uint64_t));
+		got[k] = calloc(nw + 1, sizeof(uint64_t));
+		if (!ref[k] || !got[k])  return perror("calloc"), 1 ;
+		if (sync[k] >= sz)  sync[k] = 0 ;
+
+		// Reference: what the disassembler does, one decode() at a time
+		for (size_t p = sync[k];  p < sz;  ) {
 			disasm_t  dis;
-			
-			if (decode(ins, &dis)) {
-				// Cell: begin
-				printf("        <td><table summary=\"\" align=\"center\" border=\"0\">\n");
-
-				// I-Len
-				printf("          <tr><td align=\"left\"><small><b>           %d       </b></small></td>\n", dis.len);
-				
-				// T-Cnt
-				printf("              <td align=\"right\"><small><b>          %d%.2s    </b></small></td></tr>\n", 
-				       (dis.t %10), &"  + ++"[(dis.t/10)*2]);
-
-				// Mnemonic
-				printf("          <tr><th colspan=\"2\">       <a href=\"#%s\">%s     </a></th></tr>\n", 
-				       dis.mnem, dis.mnem);
-
-				// Addressing mode
-				printf("          <tr><td align=\"center\" colspan=\"2\"><small>%s</small></td></tr>\n", amode[dis.am]);
-				
-				// Flags
-				printf("          <tr><td align=\"center\" colspan=\"2\"><small>");
-				printf("[");
-				for (int j = 7;  j > 0;  j--)
-					if (j == 5)  printf("&#8209;") ;
-					else         printf("%c", ((dis.flg[0] | dis.flg[1] | dis.flg[2]) & (1 << j)) ? "CZIDB-VN"[j] : "czidb-vn"[j]);
-				printf("]");
-				
-				// Cell: end
-				printf("        </table></td>\n");
-
-			} else {  // Invalid instruction
-				printf("        <td>&nbsp;</td>\n");
+			uint8_t   ins[3] = {img->buf[p], (p + 1 < sz) ? img->buf[p + 1] : 0, (p + 2 < sz) ? img->buf[p + 2] : 0};
+			size_t    len    = decode(ins, &dis).len;
+
+			ref[k][p >> 6] |= 1ULL << (p & 63);
+			p += (len && (p + len <= sz)) ? len : 1;
+		}
+	}
+
+	for (int v = 0;  v < 2;  v++) {
+		if (v && !scan_simd())  break ;
+		for (int k = 0;  k < nsync;  k++)  memset(got[k], 0, nw * sizeof(uint64_t)) ;
+		(v ? scan_starts : scan_starts_scalar)(img->buf, sz, sync, nsync, got);
+		for (int k = 0;  k < nsync;  k++)
+			if (memcmp(ref[k], got[k], nw * sizeof(uint64_t)))  bad = 1,  printf("%s : sync %zu MISMATCH\n", v ? "vector" : "scalar", sync[k]) ;
+	}
+	printf("check   : %s  (%d sync offsets, %s)\n", bad ? "FAILED" : "ok", nsync, scan_simd() ? "scalar & vector" : "scalar only");
+
+	// Where do sweeps from offsets 1 & 2 fall into step with offset 0?
+	for (int k = 1;  k <= 2;  k++)
+		for (size_t i = 0;  i < nw;  i++)
+			if (ref[0][i] & ref[k][i]) {
+				printf("sync %d  : joins sync 0 at +%zu\n", k, i * 64 + __builtin_ctzll(ref[0][i] & ref[k][i]));
+				break;
 			}
-		} while ((++i) & 0xF) ;
-
-		// Row: end
-		printf("        <th align=\"center\">&nbsp;%X<big><big>&#8209;</big></big>&nbsp;</th>\n", (i>>4)-1);
-		printf("      </tr>\n");
-	}// for i
-
-	// Table footer
-	printf("      <tr align=\"center\">\n");
-	printf("        <th width=\"7%\">&nbsp;</th>\n");
-	printf("        <th width=\"7%\"><big><big>&#8209;</big></big>0</th>\n");
-	printf("        <th width=\"7%\"><big><big>&#8209;</big></big>1</th>\n");
-	printf("        <th width=\"7%\"><big><big>&#8209;</big></big>2</th>\n");
-	printf("        <th width=\"7%\"><big><big>&#8209;</big></big>3</th>\n");
-	printf("        <th width=\"7%\"><big><big>&#8209;</big></big>4</th>\n");
-	printf("        <th width=\"7%\"><big><big>&#8209;</big></big>5</th>\n");
-	printf("        <th width=\"7%\"><big><big>&#8209;</big></big>6</th>\n");
-	printf("        <th width=\"7%\"><big><big>&#8209;</big></big>7</th>\n");
-	printf("        <th width=\"7%\"><big><big>&#8209;</big></big>8</th>\n");
-	printf("        <th width=\"7%\"><big><big>&#8209;</big></big>9</th>\n");
-	printf("        <th width=\"7%\"><big><big>&#8209;</big></big>A</th>\n");
-	printf("        <th width=\"7%\"><big><big>&#8209;</big></big>B</th>\n");
-	printf("        <th width=\"7%\"><big><big>&#8209;</big></big>C</th>\n");
-	printf("        <th width=\"7%\"><big><big>&#8209;</big></big>D</th>\n");
-	printf("        <th width=\"7%\"><big><big>&#8209;</big></big>E</th>\n");
-	printf("        <th width=\"7%\"><big><big>&#8209;</big></big>F</th>\n");
-	printf("        <th width=\"7%\">&nbsp;</th>\n");
-	printf("      </tr>\n");
-	printf("    </table>\n");
-	
-	// Credits
-	printf("\n");
-	printf("    <table summary=\"\" border=\"0\" cellpadding=\"0\" width=\"100%\">\n");
-	printf("      <tr><td align=\"right\">autogenerated from \n");
-	printf("        <a href=\"https://www.masswerk.at/6502/6502_instruction_set.html\" target=\"extern6502\">6502 Instruction Set</a>\n");
-	printf("        by <a href=\"https://masswerk.at/\" target=\"extern6502\">mass:werk</a>\n");
-	printf("      </td></tr>\n");
-	printf("    </table>\n");
 
+	// Throughput
+	for (int n = 1;  n <= 3;  n += 2)
+		for (int v = 0;  v < 2;  v++) {
+			int     reps = 0;
+			double  t0, t;
+
+			if (v && !scan_simd())  break ;
+			t0 = now();
+			do {
+				(v ? scan_starts : scan_starts_scalar)(img->buf, sz, sync, n, got);
+				reps++;
+			} while ((t = now() - t0) < 0.5) ;
+			printf("%s x%d : %10.2f MB/s\n", v ? "vector" : "scalar", n, (double)sz * reps / t / 1e6);
+		}
+
+	for (int k = 0;  k < nsync;  k++)  free(ref[k]),  free(got[k]) ;
+	return bad;
+}
+
+//+============================================================================ ========================================
+// Index every memory operand of an image & save it
+//
+int  disasm_xref (const image_t* img,  uint16_t org,  cpu_var_t var,  const char* out)
+{
+	xref_t  x;
+	double  t0 = now(), t;
+	int     rv = 0;
+
+	if (xref_build(&x, img->buf, img->sz, org, var) < 0)  return perror("xref_build"), 1 ;
+	t = now() - t0;
+
+	if (xref_save(&x, out) < 0)  perror(out),  rv = 1 ;
+	else  fprintf(stderr, "%u references, %zu bytes -> %s  (%.3fs, %.2f MB/s)\n",
+	              x.hdr->nref, x.bsz, out, t, t ? img->sz / t / 1e6 : 0) ;
+
+	xref_close(&x);
+	return rv;
+}
+
+//+============================================================================ ========================================
+// Query a saved index - every reference to lo..hi, as "K OOOOOOOO  AAAA  B0 B1 B2  MNM OPER"
+//   K : R(ead) W(rite) M(odify) J(ump)    O : image offset
+//   kinds : any of "rwmj"  (NULL -> all)
+//
+int  disasm_query (const char* fn,  const char* range,  const char* kinds)
+{
+	static const char  kc[] = "RWMJ";
+	xref_t           x;
+	obuf_t           ob   = {malloc(DIS_OBUF_SZ), NULL, STDOUT_FILENO};
+	char*            lim  = ob.buf + DIS_OBUF_SZ - DIS_LINE_MAX - 16;
+	char*            e;
+	unsigned long    lo   = strtoul(range, &e, 16);
+	unsigned long    hi   = (*e == '-') ? strtoul(e + 1, NULL, 16) : lo;
+	unsigned         mask = 0;
+	size_t           n    = 0;
+	double           t0   = now();
+	const decode_t*  tab;
+	int              nb;
+
+	if (!ob.buf)  return perror("malloc"), 1 ;
+	if (xref_open(&x, fn) < 0)  return perror(fn), free(ob.buf), 1 ;
+	tab = op2i_var[x.hdr->var];
+	nb  = (x.hdr->var == VAR_65816) ? 4 : 3;
+
+	for (const char* k = kinds;  k && *k;  k++)
+		for (int j = 0;  j < 4;  j++)
+			if ((*k | 0x20) == "rwmj"[j])  mask |= 1u << j ;
+	if (!mask)  mask = 0xF ;
+	if (hi > 0xFFFF)  hi = 0xFFFF ;
+
+	ob.p = ob.buf;
+	for (unsigned long a = lo;  a <= hi;  a++)
+		for (uint32_t i = x.dir[a];  i < x.dir[a + 1];  i++) {
+			uint8_t   ins[4];
+			uint16_t  addr;
+			uint32_t  off = XREF_OFF(x.ref[i]);
+
+			if (!(mask & (1u << XREF_KIND(x.ref[i]))))  continue ;
+			if (ob.p >= lim)  obuf_flush(&ob) ;
+
+			addr    = xref_ins(&x, a, i, ins);
+			*ob.p++ = kc[XREF_KIND(x.ref[i])];
+			*ob.p++ = ' ';
+			ob.p    = hex4(hex4(ob.p, off >> 16), off);
+			*ob.p++ = ' ';
+			*ob.p++ = ' ';
+			dis_line(&ob.p, ins, 4, addr, tab, nb);
+			n++;
+		}
+	obuf_flush(&ob);
+
+	fprintf(stderr, "%zu references  (%.3f ms)\n", n, (now() - t0) * 1e3);
+	xref_close(&x);
+	free(ob.buf);
+	return 0;
+}
+
+//+============================================================================ ========================================
+// Apply the edits on stdin one by one - after each, the lines that changed & the references & labels that did
+//   "; OOOOOO +N  lo-hi  T us"    - the patch, the bytes decoded again & how long that took
+//   "AAAA  B0 B1 B2  MNM OPER"     - the new listing of lo-hi
+//   "; -W $D020  @OOOOOO"          - a reference gone (-) or new (+), by the instruction at that offset
+//   "; +label $C012"               - a label  (a jump, call or branch target) new (+) or gone (-)
+//
+#define EDIT_MAX  (256)            // Bytes per edit
+
+int  disasm_edit (const image_t* img,  uint16_t org,  cpu_var_t var)
+{
+	static const char  kc[] = "RWMJ";
+	incr_t  x;
+	obuf_t  ob   = {malloc(DIS_OBUF_SZ), NULL, STDOUT_FILENO};
+	char*   lim  = ob.buf + DIS_OBUF_SZ - DIS_LINE_MAX - 64;
+	char    ln[EDIT_MAX * 3 + 64];
+	size_t  ned  = 0;
+	double  tsum = 0,  tmax = 0,  t0;
+	int     nb   = (var == VAR_65816) ? 4 : 3;
+
+	if (!ob.buf)  return perror("malloc"), 1 ;
+	t0 = now();
+	if (incr_init(&x, img->buf, img->sz, org, var) < 0)  return perror("incr_init"), free(ob.buf), 1 ;
+	fprintf(stderr, "indexed %zu bytes in %.3fs\n", img->sz, now() - t0);
+	ob.p = ob.buf;
+
+	while (fgets(ln, sizeof(ln), stdin)) {
+		uint8_t  b[EDIT_MAX];
+		size_t   n = 0,  off,  lo,  hi;
+		char*    s = ln;
+		char*    e;
+		double   t;
+
+		off = strtoul(s, &e, 16);
+		if (e == s)  continue ;                             // Blank or comment
+		for (s = e;  n < EDIT_MAX;  s = e) {
+			unsigned long  v = strtoul(s, &e, 16);
+			if (e == s)  break ;
+			b[n++] = v;
+		}
+
+		t0 = now();
+		if (incr_patch(&x, off, b, n, &lo, &hi) < 0) {
+			fprintf(stderr, "%zX: %s\n", off, strerror(errno));
+			continue;
+		}
+		t     = now() - t0;
+		tsum += t;
+		tmax  = (t > tmax) ? t : tmax;
+		ned++;
+
+		ob.p += sprintf(ob.p, "; %06zX +%zu  %06zX-%06zX  %.1f us\n", off, n, lo, hi, t * 1e6);
+		for (size_t p = lo;  p < hi;  ) {
+			if (ob.p >= lim)  obuf_flush(&ob) ;
+			p += dis_line(&ob.p, &x.buf[p], x.sz - p, org + p, x.tab, nb);
+		}
+		for (size_t i = 0;  i < x.nchg;  i++) {
+			const incr_chg_t*  c = &x.chg[i];
+
+			if (ob.p >= lim)  obuf_flush(&ob) ;
+			if (c->kind == INCR_LABEL)  ob.p += sprintf(ob.p, "; %clabel $%04X\n", (c->d > 0) ? '+' : '-', c->addr) ;
+			else  ob.p += sprintf(ob.p, "; %c%c $%04X  @%06X\n", (c->d > 0) ? '+' : '-', kc[c->kind], c->addr, c->off) ;
+		}
+		obuf_flush(&ob);
+	}
+
+	if (ned)  fprintf(stderr, "%zu edits : %.2f us mean, %.2f us worst\n", ned, tsum / ned * 1e6, tmax * 1e6) ;
+	incr_free(&x);
+	free(ob.buf);
 	return 0;
 }
+
+//+============================================================================ ========================================
+// Disassemble (or benchmark) a binary image
+//   -d file [org]   : disassemble to stdout
+//   -b file [org]   : hexfmt vs sprintf throughput
+//   -f file [org [entry ...]]  : control-flow listing
+//   -t file org lo hi [entry ...]  : static timing
+//   -s file         : pre-scan check & throughput
+//   -x file [org [out]]  : cross-reference index
+//   -e file [org]   : incremental re-disassembly of the edits on stdin
+//
+int  disasm_main (int argc,  char* argv[],  cpu_var_t var)
+{
+	image_t   img;
+	uint16_t  org = (argc > 3) ? strtoul(argv[3], NULL, 16) : 0;
+	int       rv  = 0;
+
+	if (image_open(&img, argv[2]) < 0)  return 1 ;
+
+	if (argv[1][1] == 'b') {
+		rv = disasm_bench(&img, org);
+	} else if (argv[1][1] == 's') {
+		rv = disasm_scan(&img);
+	} else if (argv[1][1] == 't') {
+		if (argc < 6)  fprintf(stderr, "use: %s -t file org lo hi [entry ...]\n", argv[0]),  rv = 1 ;
+		else           rv = disasm_time(&img, org, argc - 4, argv + 4) ;
+	} else if (argv[1][1] == 'f') {
+		rv = disasm_flow(&img, org, (argc > 4) ? argc - 4 : 0, argv + 4);
+	} else if (argv[1][1] == 'e') {
+		rv = disasm_edit(&img, org, var);
+	} else if (argv[1][1] == 'x') {
+		char  out[4096];
+
+		snprintf(out, sizeof(out), "%s.xrf", argv[2]);
+		rv = disasm_xref(&img, org, var, (argc > 4) ? argv[4] : out);
+	} else {
+		obuf_t  ob = {malloc(DIS_OBUF_SZ), NULL, STDOUT_FILENO};
+
+		if (!ob.buf)  perror("malloc"),  rv = 1 ;
+		else {
+			ob.p = ob.buf;
+			disasm_var(&img, org, &ob, var);
+			obuf_flush(&ob);
+			free(ob.buf);
+		}
+	}
+
+	image_close(&img);
+	return rv;
+}
+
+//+============================================================================ ========================================
+// Every format of the opcode table, in one pass :  <pfx>.htm .json .csv .h
+//
+int  emit_files (const char* pfx,  cpu_var_t var)
+{
+	static const char* const  ext[EMIT_MAX] = { [EMIT_HTML] = ".htm",  [EMIT_JSON] = ".json",  [EMIT_CSV] = ".csv",  [EMIT_HDR] = ".h" };
+	int                       fd[EMIT_MAX];
+	char                      fn[4096];
+	int                       rv = 0;
+	double                    t0;
+
+	for (int f = 0;  f < EMIT_MAX;  f++) {
+		snprintf(fn, sizeof(fn), "%s%s", pfx, ext[f]);
+		if ((fd[f] = open(fn, O_WRONLY | O_CREAT | O_TRUNC, 0644)) < 0) {
+			perror(fn);
+			while (f--)  close(fd[f]) ;
+			return 1;
+		}
+	}
+
+	t0 = now();
+	if (emit_table(var, fd) < 0)  perror(pfx),  rv = 1 ;
+	fprintf(stderr, "%s%s .json .csv .h  (%.1f us)\n", pfx, ext[EMIT_HTML], (now() - t0) * 1e6);
+
+	for (int f = 0;  f < EMIT_MAX;  f++)  if (close(fd[f]) < 0)  rv = 1 ;
+	return rv;
+}
+
+//+============================================================================ ========================================
+int  main (int argc,  char* argv[],  char* envp[])
+{
+	int  var = VAR_6502;
+
+	if ((argc >= 3) && !strcmp(argv[1], "-v")) {
+		if ((var = var_find(argv[2])) < 0) {
+			fprintf(stderr, "%s: unknown variant '%s'  (", argv[0], argv[2]);
+			for (int v = 0;  v < VAR_MAX;  v++)  fprintf(stderr, v ? " %s" : "%s", var_name[v]) ;
+			fprintf(stderr, ")\n");
+			return 1;
+		}
+		argv[2] = argv[0];
+		argc   -= 2;
+		argv   += 2;
+	}
+
+	if ((argc >= 4) && !strcmp(argv[1], "-j"))  return disasm_batch(argv[2], argv[3], (argc > 4) ? atoi(argv[4]) : 0, var) ;
+	if ((argc >= 4) && !strcmp(argv[1], "-q"))  return disasm_query(argv[2], argv[3], (argc > 4) ? argv[4] : NULL) ;
+	if ((argc >= 3) && (!strcmp(argv[1], "-d") || !strcmp(argv[1], "-b") || !strcmp(argv[1], "-f") || !strcmp(argv[1], "-t") || !strcmp(argv[1], "-s") || !strcmp(argv[1], "-x") || !strcmp(argv[1], "-e")))  return disasm_main(argc, argv, var) ;
+
+	if ((argc >= 3) && !strcmp(argv[1], "-g"))  return emit_files(argv[2], var) ;
+
+	// The HTML table
+	return (emit_table(var, (int[EMIT_MAX]){ [EMIT_HTML] = STDOUT_FILENO,  [EMIT_JSON] = -1,  [EMIT_CSV] = -1,  [EMIT_HDR] = -1 }) < 0) ? 1 : 0;
+}
@@ -0,0 +1,424 @@
+//----------------------------------------------------------------------------- ----------------------------------------
+// The lockstep loop - #included by 6502-batch.c once per vector width
+//
+//   GRP_RUN  : name of the function to generate  (runs a whole group)
+//   GRP_SH   : lanes per vector  (1 << GRP_SH, at most BATCH_W) - a group is run as BATCH_W >> GRP_SH slices
+//   GRP_ATTR : target attribute of GRP_RUN
+//
+// A slice's memory is still the group's : a row is BATCH_W bytes, the slice uses its own GRP_W of them.
+//
+#define GRP_W         (1 << GRP_SH)
+
+// Names of their own for each build  (vb_t -> vb_t_grp_run_512 ...)
+#define GRP_CAT(n, w)   n##_##w
+#define GRP_NAME(n, w)  GRP_CAT(n, w)        // (w expanded first)
+#define vb_t          GRP_NAME(vb_t,      GRP_RUN)
+#define vsb_t         GRP_NAME(vsb_t,     GRP_RUN)
+#define vw_t          GRP_NAME(vw_t,      GRP_RUN)
+#define vsw_t         GRP_NAME(vsw_t,     GRP_RUN)
+#define vd_t          GRP_NAME(vd_t,      GRP_RUN)
+#define vsd_t         GRP_NAME(vsd_t,     GRP_RUN)
+#define lanes_t       GRP_NAME(lanes_t,   GRP_RUN)
+#define grp_exec      GRP_NAME(grp_exec,  GRP_RUN)
+#define grp_slice     GRP_NAME(grp_slice, GRP_RUN)
+
+typedef  uint8_t   vb_t   __attribute__((vector_size(GRP_W)));            // A byte per lane
+typedef  int8_t    vsb_t  __attribute__((vector_size(GRP_W)));
+typedef  uint16_t  vw_t   __attribute__((vector_size(GRP_W * 2)));        // A word per lane
+typedef  int16_t   vsw_t  __attribute__((vector_size(GRP_W * 2)));
+typedef  uint32_t  vd_t   __attribute__((vector_size(GRP_W * 4)));        // A dword per lane
+typedef  int32_t   vsd_t  __attribute__((vector_size(GRP_W * 4)));
+
+typedef
+	struct {
+		vb_t  a, x, y, s, p, jam;
+		vw_t  pc;
+		vd_t  cy;                          // Cycles into this chunk
+	}
+lanes_t;
+
+// Is any lane set?  (a macro :  a vector argument sets off -Wpsabi)
+#define any(v)  ({                                                      \
+		vb_t      v_ = (v);                                             \
+		uint64_t  q_[GRP_W / 8], o_ = 0;                                \
+		memcpy(q_, &v_, sizeof(q_));                                    \
+		for (int k_ = 0;  k_ < GRP_W / 8;  k_++)  o_ |= q_[k_] ;        \
+		!!o_;                                                           \
+	})
+
+//+============================================================================ ========================================
+// Run the instruction at 'pc' on the lanes in mk  (0xFF -> runs;  'lead' is one of them)
+//
+static inline  __attribute__((always_inline))
+void  grp_exec (lanes_t* r,  uint8_t* mem,  const vb_t* pmk,  int lead,  uint16_t pc,  const decode_t* d,  uint8_t o1,  uint8_t o2)
+{
+	vb_t      mk   = *pmk;                                 // (a pointer :  a vector argument sets off -Wpsabi)
+	uint16_t  oper = o1 | (o2 << 8);
+	uint16_t  npc  = pc + d->len;
+	vw_t      mkw  = MASKW(mk);
+	vw_t      ea   = {0};
+	vb_t      v    = {0}, w, f, px = {0};
+	int       mrd  = 1;                                    // Operand comes from memory
+	int       uni  = 0;                                    // ...at the same address in every lane that runs
+	uint16_t  e0;
+	uint8_t   s0;                                          // S of the lanes that run  (SUNI)
+
+	r->cy += WIDED(mk & (d->t % 10));
+	r->pc  = (r->pc & ~mkw) | (npc & mkw);
+
+	//------------------------------------------------------------------------- ----------------------------------------
+	// Effective address & operand
+	switch (d->am) {
+		case AM_ZP  :  ea = ea + o1;                                                 break ;
+		case AM_ZPX :  ea = WIDE((vb_t)(r->x + o1));                                 break ;
+		case AM_ZPY :  ea = WIDE((vb_t)(r->y + o1));                                 break ;
+		case AM_ABS :  ea = ea + oper;                                               break ;
+		case AM_ABSX:  ea = WIDE(r->x) + oper;  px = NARROW(((ea ^ oper) >> 8) & 1);  break ;
+		case AM_ABSY:  ea = WIDE(r->y) + oper;  px = NARROW(((ea ^ oper) >> 8) & 1);  break ;
+		case AM_INDX:  LANE {
+		                   uint8_t  b = o1 + r->x[i];
+		                   ea[i] = M(i, b) | (M(i, (uint8_t)(b + 1)) << 8);
+		               }
+		               break ;
+		case AM_INDY: {
+			vw_t  b = WIDE(ROW(o1)) | (WIDE(ROW((uint8_t)(o1 + 1))) << 8);
+			ea = b + WIDE(r->y);
+			px = NARROW(((b ^ ea) >> 8) & 1);
+			break;
+		}
+		case AM_IMM :  v = v + o1;
+		               mrd = 0;
+		               break ;
+		case AM_ACC :  v = r->a;
+		               // fallthrough
+		default     :  mrd = 0;
+		               break ;
+	}
+
+	// One address for all -> a row of memory, not a gather / scatter
+	e0 = ea[lead];
+	if (mrd) {
+		uni = !any(mk & NARROW((vw_t)(ea != e0)));
+		if (uni)  v = ROW(e0) ;
+		else      LANE  v[i] = M(i, ea[i]) ;
+	}
+	if (d->t >= 10)  r->cy += WIDED(mk & px) ;                                      // Footnote [1]
+
+	//------------------------------------------------------------------------- ----------------------------------------
+	// Operation
+#	define PUT(R)      do {                                                            \
+	                       if (uni)  ROW(e0) = SEL(ROW(e0), (R)) ;                     \
+	                       else      LANE  if (mk[i])  M(i, ea[i]) = (R)[i] ;          \
+	                   } while (0)
+#	define LD(R)       {  R = SEL(R, v);  r->p = SEL(r->p, NZ(r->p, v));  }
+#	define ALU(e)      {  w = (e);  r->a = SEL(r->a, w);  r->p = SEL(r->p, NZ(r->p, w));  }
+#	define CMP(R)      {  w = R - v;  r->p = SEL(r->p, (NZ(r->p, w) & ~FLG_C) | (B(R >= v) & FLG_C));  }
+#	define REG(R, e)   {  w = (e);  R = SEL(R, w);  r->p = SEL(r->p, NZ(r->p, w));  }
+#	define FLAG(c, s)  {  r->p = SEL(r->p, (r->p & ~(c)) | (s));  }
+#	define BR(fl, on)  {                                                               \
+	                       uint16_t  t  = npc + (int8_t)o1;                            \
+	                       vb_t      fs = B((r->p & (fl)) != 0);                       \
+	                       vb_t      tk = mk & ((on) ? fs : ~fs);                      \
+	                       vw_t      tw = MASKW(tk);                                   \
+	                       r->pc  = (r->pc & ~tw) | (t & tw);                          \
+	                       r->cy += WIDED(tk & (uint8_t)(1 + (((npc ^ t) >> 8) & 1))); \
+	                   }
+#	define PUSH(i, b)  (M(i, 0x100 | r->s[i]) = (b),  r->s[i]--)
+#	define PULL(i)     (r->s[i]++,  M(i, 0x100 | r->s[i]))
+#	define SUNI        (s0 = r->s[lead],  !any(mk & B(r->s != s0)))                // Same S in every lane that runs
+#	define SROW(k)     ROW(0x100 | (uint8_t)(s0 + (k)))                            // The stack row at S + k
+
+	// Read-modify-write : w & f are the result & flags, back to A or memory
+#	define RMW(e, c)   do {                                                            \
+	                       w = (e);                                                    \
+	                       f = (NZ(r->p, w) & ~FLG_C) | (c);                           \
+	                       RMW_PUT();                                                  \
+	                   } while (0)
+#	define RMW_PUT()   do {                                                            \
+	                       if (d->am == AM_ACC)  r->a = SEL(r->a, w) ;                 \
+	                       else                  PUT(w) ;                              \
+	                       r->p = SEL(r->p, f);                                        \
+	                   } while (0)
+
+	switch (d->mnem) {
+		case MN_LDA :  LD(r->a)       break ;
+		case MN_LDX :  LD(r->x)       break ;
+		case MN_LDY :  LD(r->y)       break ;
+		case MN_STA :  PUT(r->a);     break ;
+		case MN_STX :  PUT(r->x);     break ;
+		case MN_STY :  PUT(r->y);     break ;
+
+		case MN_AND :  ALU(r->a & v)  break ;
+		case MN_ORA :  ALU(r->a | v)  break ;
+		case MN_EOR :  ALU(r->a ^ v)  break ;
+		case MN_CMP :  CMP(r->a)      break ;
+		case MN_CPX :  CMP(r->x)      break ;
+		case MN_CPY :  CMP(r->y)      break ;
+		case MN_BIT :  r->p = SEL(r->p, (r->p & ~(FLG_N | FLG_V | FLG_Z)) | (v & (FLG_N | FLG_V)) | (B((r->a & v) == 0) & FLG_Z));
+		               break ;
+
+		case MN_ADC :
+		case MN_SBC : {
+			vb_t  dm = mk & B((r->p & FLG_D) != 0);            // Lanes in decimal mode
+			vb_t  dv = v;                                       // The operand as read
+			vw_t  s;
+
+			if (d->mnem == MN_SBC)  v = ~v ;                    // Binary SBC is ADC of the complement
+			s = WIDE(r->a) + WIDE(v) + WIDE(r->p & FLG_C);
+			w = NARROW(s);
+			f = (r->p & ~(FLG_N | FLG_V | FLG_Z | FLG_C))
+			  | (w & FLG_N) | (B(w == 0) & FLG_Z) | NARROW(s >> 8)
+			  | ((~(r->a ^ v) & (r->a ^ w) & 0x80) >> 1);
+
+			// Decimal mode, in signed words  (Bruce Clark's Appendix A - the same as adc_bcd() & sbc_bcd())
+			//   ADC : N & V from the sum before the high digit is adjusted, C after it, Z the binary one
+			//   SBC : only the result is decimal
+			if (any(dm)) {
+				vsw_t  da = (vsw_t)WIDE(r->a),  dd = (vsw_t)WIDE(dv),  dc = (vsw_t)WIDE(r->p & FLG_C);
+				vsw_t  lo, sd;
+				vb_t   df = f;
+
+				if (d->mnem == MN_ADC) {
+					lo  = (da & 0x0F) + (dd & 0x0F) + dc;
+					lo  = (lo & ~(lo >= 10)) | ((((lo + 6) & 0x0F) + 0x10) & (lo >= 10));
+					sd  = (da & 0xF0) + (dd & 0xF0) + lo;
+					df  = (f & ~(FLG_N | FLG_V | FLG_C)) | NARROW((vw_t)sd & FLG_N) | NARROW((vw_t)(~(da ^ dd) & (da ^ sd) & 0x80) >> 1);
+					sd += (sd >= 0xA0) & 0x60;
+					df |= NARROW((vw_t)(sd >= 0x100) & FLG_C);
+				} else {
+					lo  = (da & 0x0F) - (dd & 0x0F) + dc - 1;
+					lo  = (lo & ~(lo < 0)) | ((((lo - 6) & 0x0F) - 0x10) & (lo < 0));
+					sd  = (da & 0xF0) - (dd & 0xF0) + lo;
+					sd -= (sd < 0) & 0x60;
+				}
+				w = (w & ~dm) | (NARROW((vw_t)sd) & dm);
+				f = (f & ~dm) | (df & dm);
+			}
+
+			r->a = SEL(r->a, w);
+			r->p = SEL(r->p, f);
+			break;
+		}
+
+		case MN_ASL :  RMW(v << 1,                        v >> 7);  break ;
+		case MN_LSR :  RMW(v >> 1,                        v & 1);   break ;
+		case MN_ROL :  RMW((v << 1) | (r->p & FLG_C),     v >> 7);  break ;
+		case MN_ROR :  RMW((v >> 1) | (r->p << 7),        v & 1);   break ;
+		case MN_INC :  w = v + 1;  f = NZ(r->p, w);  RMW_PUT();  break ;
+		case MN_DEC :  w = v - 1;  f = NZ(r->p, w);  RMW_PUT();  break ;
+
+		case MN_INX :  REG(r->x, r->x + 1)  break ;
+		case MN_INY :  REG(r->y, r->y + 1)  break ;
+		case MN_DEX :  REG(r->x, r->x - 1)  break ;
+		case MN_DEY :  REG(r->y, r->y - 1)  break ;
+		case MN_TAX :  REG(r->x, r->a)      break ;
+		case MN_TAY :  REG(r->y, r->a)      break ;
+		case MN_TXA :  REG(r->a, r->x)      break ;
+		case MN_TYA :  REG(r->a, r->y)      break ;
+		case MN_TSX :  REG(r->x, r->s)      break ;
+		case MN_TXS :  r->s = SEL(r->s, r->x);  break ;
+
+		case MN_CLC :  FLAG(FLG_C, 0)      break ;
+		case MN_CLD :  FLAG(FLG_D, 0)      break ;
+		case MN_CLI :  FLAG(FLG_I, 0)      break ;
+		case MN_CLV :  FLAG(FLG_V, 0)      break ;
+		case MN_SEC :  FLAG(0, FLG_C)      break ;
+		case MN_SED :  FLAG(0, FLG_D)      break ;
+		case MN_SEI :  FLAG(0, FLG_I)      break ;
+		case MN_NOP :                      break ;
+
+		case MN_BPL :  BR(FLG_N, 0)  break ;
+		case MN_BMI :  BR(FLG_N, 1)  break ;
+		case MN_BVC :  BR(FLG_V, 0)  break ;
+		case MN_BVS :  BR(FLG_V, 1)  break ;
+		case MN_BCC :  BR(FLG_C, 0)  break ;
+		case MN_BCS :  BR(FLG_C, 1)  break ;
+		case MN_BNE :  BR(FLG_Z, 0)  break ;
+		case MN_BEQ :  BR(FLG_Z, 1)  break ;
+
+		case MN_JMP :
+			if (d->am == AM_ABS)  r->pc = (r->pc & ~mkw) | (oper & mkw) ;
+			else                  LANE  if (mk[i])                           // NMOS bug: the pointer never crosses a page
+				r->pc[i] = M(i, oper) | (M(i, (oper & 0xFF00) | ((oper + 1) & 0xFF)) << 8);
+			break;
+
+		// Stack : a row when every lane that runs has the same S  (lockstep code), else per lane
+		case MN_JSR :  if (SUNI) {
+		                   SROW(0)  = SEL(SROW(0),  (uint8_t)((npc - 1) >> 8));
+		                   SROW(-1) = SEL(SROW(-1), (uint8_t)(npc - 1));
+		                   r->s  = SEL(r->s, r->s - 2);
+		                   r->pc = (r->pc & ~mkw) | (oper & mkw);
+		               } else LANE  if (mk[i]) {  PUSH(i, (npc - 1) >> 8);  PUSH(i, (npc - 1) & 0xFF);  r->pc[i] = oper;  }
+		               break ;
+		case MN_RTS :  if (SUNI) {
+		                   vw_t  ra = (WIDE(SROW(1)) | (WIDE(SROW(2)) << 8)) + 1;
+		                   r->s  = SEL(r->s, r->s + 2);
+		                   r->pc = (r->pc & ~mkw) | (ra & mkw);
+		               } else LANE  if (mk[i]) {  uint8_t lo = PULL(i);  r->pc[i] = (lo | (PULL(i) << 8)) + 1;  }
+		               break ;
+		case MN_RTI :  LANE  if (mk[i]) {
+		                   uint8_t  lo;
+		                   r->p[i]  = (PULL(i) & ~FLG_B) | FLG_X;
+		                   lo       = PULL(i);
+		                   r->pc[i] = lo | (PULL(i) << 8);
+		               }
+		               break ;
+		case MN_BRK :  LANE  if (mk[i]) {                                        // BRK has a padding byte
+		                   PUSH(i, (npc + 1) >> 8);
+		                   PUSH(i, (npc + 1) & 0xFF);
+		                   PUSH(i, r->p[i] | FLG_X | FLG_B);
+		                   r->p[i] |= FLG_I;
+		                   r->pc[i] = M(i, VEC_IRQ) | (M(i, VEC_IRQ + 1) << 8);
+		               }
+		               break ;
+		case MN_PHA :  if (SUNI)  SROW(0) = SEL(SROW(0), r->a),  r->s = SEL(r->s, r->s - 1) ;
+		               else       LANE  if (mk[i])  PUSH(i, r->a[i]) ;
+		               break ;
+		case MN_PHP :  if (SUNI)  SROW(0) = SEL(SROW(0), r->p | FLG_X | FLG_B),  r->s = SEL(r->s, r->s - 1) ;
+		               else       LANE  if (mk[i])  PUSH(i, r->p[i] | FLG_X | FLG_B) ;
+		               break ;
+		case MN_PLA :  if (SUNI) {  v = SROW(1);  r->s = SEL(r->s, r->s + 1);  LD(r->a)  }
+		               else LANE  if (mk[i]) {  r->a[i] = PULL(i);  r->p[i] = (r->p[i] & ~(FLG_N | FLG_Z)) | (r->a[i] & FLG_N) | (!r->a[i] << 1);  }
+		               break ;
+		case MN_PLP :  if (SUNI)  r->p = SEL(r->p, (SROW(1) & ~FLG_B) | FLG_X),  r->s = SEL(r->s, r->s + 1) ;
+		               else       LANE  if (mk[i])  r->p[i] = (PULL(i) & ~FLG_B) | FLG_X ;
+		               break ;
+
+		default     :  break ;
+	}
+
+#	undef PUT
+#	undef LD
+#	undef ALU
+#	undef CMP
+#	undef REG
+#	undef FLAG
+#	undef BR
+#	undef PUSH
+#	undef PULL
+#	undef SUNI
+#	undef SROW
+#	undef RMW
+#	undef RMW_PUT
+}
+
+//+============================================================================ ========================================
+// Run the slice of a group from lane 'h' for 'ncyc' cycles  -> cycles run
+//
+static inline  __attribute__((always_inline))
+uint64_t  grp_slice (batch_grp_t* g,  int h,  uint64_t ncyc)
+{
+	uint8_t*  mem = g->mem + h;          // M() & ROW() of the slice's lanes
+	uint64_t  n   = 0;
+	vd_t      c0  = {0};                 // Overshoot of the last chunk  (counted already; the lane starts the next one there)
+	lanes_t   r;
+
+	memcpy(&r.a,   g->a   + h,  GRP_W);
+	memcpy(&r.x,   g->x   + h,  GRP_W);
+	memcpy(&r.y,   g->y   + h,  GRP_W);
+	memcpy(&r.s,   g->s   + h,  GRP_W);
+	memcpy(&r.p,   g->p   + h,  GRP_W);
+	memcpy(&r.jam, g->jam + h,  GRP_W);
+	memcpy(&r.pc,  g->pc  + h,  sizeof(r.pc));
+
+	while (ncyc) {
+		uint32_t  lim   = (ncyc > BATCH_CHUNK) ? BATCH_CHUNK : ncyc;
+		int64_t   slack = 0;               // Every live lane has at least this many cycles of budget left
+		int       conv  = 0;               // Every live lane is at r.pc[lead]
+		int       lead  = 0;
+		vb_t      live  = {0};
+
+		r.cy  = c0;
+		ncyc -= lim;
+
+		for (;;) {
+			const decode_t*  d;
+			unsigned         lpc;
+			uint8_t          op, o1, o2, split;
+			vb_t             mk;
+
+			// 1. Lowest live PC  (skipped while the group is converged & no lane can reach its budget)
+			if (conv && (slack > 0)) {
+				lpc = r.pc[lead];
+			} else {
+				uint32_t  hi = 0;
+
+				live = NARROW((vw_t)__builtin_convertvector((vsd_t)(r.cy < lim), vsw_t)) & B(r.jam == 0);
+				lpc  = 0x10000;
+				LANE {
+					if (!live[i])  continue ;
+					if (r.pc[i] < lpc)  lpc = r.pc[i],  lead = i ;
+					if (r.cy[i] > hi)   hi  = r.cy[i] ;
+				}
+				if (lpc == 0x10000)  break ;
+				slack = (int64_t)lim - hi;
+			}
+
+			// 2. Who runs it
+			op = M(lead, lpc);
+			o1 = M(lead, lpc + 1);
+			o2 = M(lead, lpc + 2);
+			d  = &op2i[op];
+			mk = live & NARROW((vw_t)(r.pc == (uint16_t)lpc)) & B(ROW(lpc) == op);
+			if (d->len >= 2)  mk &= B(ROW(lpc + 1) == o1) ;
+			if (d->len >= 3)  mk &= B(ROW(lpc + 2) == o2) ;
+
+			if (!d->len) {                                      // Invalid opcode
+				r.jam |= mk;
+				conv = 0;
+				continue;
+			}
+
+			// 3. Run it
+			grp_exec(&r, mem, &mk, lead, lpc, d, o1, o2);
+
+			// Still converged if every live lane ran it, and it can not have sent them different ways
+			split  = (d->am == AM_REL) || (d->mnem == MN_RTS) || (d->mnem == MN_RTI) || (d->mnem == MN_BRK)
+			      || ((d->mnem == MN_JMP) && (d->am == AM_IND));
+			conv   = !split && !any(mk ^ live);
+			slack -= BATCH_TMAX;
+		}
+
+		LANE {
+			g->cyc[h + i] += r.cy[i] - c0[i];
+			n             += r.cy[i] - c0[i];
+			c0[i]          = (r.cy[i] > lim) ? r.cy[i] - lim : 0;
+		}
+	}
+
+	memcpy(g->a   + h,  &r.a,   GRP_W);
+	memcpy(g->x   + h,  &r.x,   GRP_W);
+	memcpy(g->y   + h,  &r.y,   GRP_W);
+	memcpy(g->s   + h,  &r.s,   GRP_W);
+	memcpy(g->p   + h,  &r.p,   GRP_W);
+	LANE  g->jam[h + i] = !!r.jam[i];
+	memcpy(g->pc  + h,  &r.pc,  sizeof(r.pc));
+	return n;
+}
+
+//+============================================================================ ========================================
+// Every lane of a group, a slice at a time  -> cycles run
+//
+GRP_ATTR
+static  uint64_t  GRP_RUN (batch_grp_t* g,  uint64_t ncyc)
+{
+	uint64_t  n = 0;
+
+	for (int h = 0;  h < BATCH_W;  h += GRP_W)  n += grp_slice(g, h, ncyc) ;
+	return n;
+}
+
+
+#undef GRP_W
+#undef GRP_CAT
+#undef GRP_NAME
+#undef vb_t
+#undef vsb_t
+#undef vw_t
+#undef vsw_t
+#undef vd_t
+#undef vsd_t
+#undef lanes_t
+#undef any
+#undef grp_exec
+#undef grp_slice
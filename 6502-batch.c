@@ -0,0 +1,209 @@
+//----------------------------------------------------------------------------- ----------------------------------------
+// Lockstep batch execution  (see 6502-batch.h)
+//
+// Registers of a slice are gcc vectors, one lane per element:  A, X, Y, S & P are GRP_W bytes, PC is GRP_W words, the
+// cycle counts GRP_W dwords.  A slice is the whole group with AVX-512 (32 lanes), half of it with AVX2 or plain SSE
+// (16 - see 6502-batch-run.h, which is built once per width;  the widest the CPU has is picked at run time).
+// Memory is interleaved, so one address in every lane is one aligned vector too (a "row") - an operand at the same
+// address in all lanes is a single load or blended store;  so is the stack, while every lane that runs has the same S.
+// Only per-lane addresses (indexed by X/Y that differ, pointers, S that differ) fall back to a loop across the lanes.
+//
+// One step of a group:
+//   1. live lanes (not jammed, inside their cycle budget) -> lowest PC
+//   2. mask : live lanes at that PC whose instruction bytes match the leader's
+//   3. one op2i decode & dispatch, then the addressing mode & the operation on whole vectors, selected by the mask
+// The lowest-PC rule lets lanes that took the other side of a branch catch up, so a group reconverges at the join.
+// While every live lane is at the same PC (the usual case) step 1 is skipped.
+//
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "6502.h"
+#include "6502-cpu.h"
+#include "6502-batch.h"
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#	define BATCH_X86  1
+#	define BATCH_512  __attribute__((target("avx512f,avx512bw,avx512vl")))
+#	define BATCH_256  __attribute__((target("avx2")))
+#else
+#	define BATCH_X86  0
+#endif
+
+#define BATCH_TMAX  (7 + 2)                // More cycles than one instruction can take
+#define BATCH_CHUNK (0x40000000)           // Largest budget for one pass  (lane cycle counts are 32 bits inside)
+
+#define LANE        for (int i = 0;  i < GRP_W;  i++)                       // Every lane of a slice
+#define M(i, ad)    mem[((unsigned)(uint16_t)(ad) << BATCH_SH) | (i)]         // Lane i's byte at 'ad'
+#define ROW(ad)     (*(vb_t*)&mem[(unsigned)(uint16_t)(ad) << BATCH_SH])     // 'ad' in every lane
+
+#define B(x)        ((vb_t)(x))                                             // Comparison -> 0xFF / 0x00 bytes
+#define WIDE(v)     __builtin_convertvector((v), vw_t)
+#define NARROW(w)   __builtin_convertvector((w), vb_t)
+#define MASKW(m)    ((vw_t)__builtin_convertvector((vsb_t)(m), vsw_t))     // Byte mask -> word mask
+#define WIDED(v)    __builtin_convertvector(WIDE(v), vd_t)                  // Bytes -> dwords, by way of words
+                                                                            //   (gcc does bytes -> dwords lane by lane)
+#define SEL(o, n)   (((o) & ~mk) | ((n) & mk))                              // Only lanes that run take the new value
+#define NZ(p, r)    (((p) & ~(FLG_N | FLG_Z)) | ((r) & FLG_N) | (B((r) == 0) & FLG_Z))
+
+typedef  uint64_t (*grp_run_t)(batch_grp_t*, uint64_t);
+
+// 16 lanes to an SSE / AVX2 build, all 32 to AVX-512  (32 in two SSE / AVX2 registers costs more than it saves)
+#define GRP_RUN   grp_run_def
+#define GRP_SH    (4)
+#define GRP_ATTR
+#include "6502-batch-run.h"
+#undef  GRP_RUN
+#undef  GRP_SH
+#undef  GRP_ATTR
+
+#if BATCH_X86
+#define GRP_RUN   grp_run_256
+#define GRP_SH    (4)
+#define GRP_ATTR  BATCH_256
+#include "6502-batch-run.h"
+#undef  GRP_RUN
+#undef  GRP_SH
+#undef  GRP_ATTR
+
+#define GRP_RUN   grp_run_512
+#define GRP_SH    (5)
+#define GRP_ATTR  BATCH_512
+#include "6502-batch-run.h"
+#undef  GRP_RUN
+#undef  GRP_SH
+#undef  GRP_ATTR
+#endif
+
+//+============================================================================ ========================================
+// Widest build this CPU can run
+//
+static  grp_run_t  grp_pick (void)
+{
+#if BATCH_X86
+	if (__builtin_cpu_supports("avx512bw") && __builtin_cpu_supports("avx512vl"))  return grp_run_512 ;
+	if (__builtin_cpu_supports("avx2"))                                          return grp_run_256 ;
+#endif
+	return grp_run_def;
+}
+
+//+============================================================================ ========================================
+batch_t*  batch_new (int n)
+{
+	batch_t*  b = calloc(1, sizeof(*b));
+
+	if (!b)  return NULL ;
+	b->n    = n;
+	b->ngrp = (n + BATCH_W - 1) / BATCH_W;
+	if (!(b->grp = calloc(b->ngrp, sizeof(*b->grp))))  return free(b), NULL ;
+
+	for (int k = 0;  k < b->ngrp;  k++) {
+		batch_grp_t*  g = &b->grp[k];
+
+		if (!(g->mem = aligned_alloc(64, BATCH_W * 0x10000)))  return batch_free(b), NULL ;   // Rows are vector loads
+		memset(g->mem, 0, BATCH_W * 0x10000);
+		for (int i = 0;  i < BATCH_W;  i++) {
+			g->p[i]   = FLG_X | FLG_I;
+			g->jam[i] = (k * BATCH_W + i >= n);
+		}
+	}
+	return b;
+}
+
+//+============================================================================ ========================================
+void  batch_free (batch_t* b)
+{
+	if (!b)  return ;
+	for (int k = 0;  k < b->ngrp;  k++)  free(b->grp[k].mem) ;
+	free(b->grp);
+	free(b);
+}
+
+//+============================================================================ ========================================
+uint8_t  batch_peek (const batch_t* b,  int i,  uint16_t ad)
+{
+	const uint8_t*  mem = b->grp[i / BATCH_W].mem;
+
+	return M(i % BATCH_W, ad);
+}
+
+//+============================================================================ ========================================
+void  batch_poke (batch_t* b,  int i,  uint16_t ad,  uint8_t v)
+{
+	uint8_t*  mem = b->grp[i / BATCH_W].mem;
+
+	M(i % BATCH_W, ad) = v;
+}
+
+//+============================================================================ ========================================
+void  batch_load (batch_t* b,  int i,  uint16_t ad,  const uint8_t* src,  size_t sz)
+{
+	uint8_t*  mem = b->grp[i / BATCH_W].mem;
+
+	for (size_t k = 0;  k < sz;  k++)  M(i % BATCH_W, ad + k) = src[k] ;
+}
+
+//+============================================================================ ========================================
+void  batch_get (const batch_t* b,  int i,  cpu_t* c)
+{
+	const batch_grp_t*  g = &b->grp[i / BATCH_W];
+	int                 l = i % BATCH_W;
+
+	c->a   = g->a[l];
+	c->x   = g->x[l];
+	c->y   = g->y[l];
+	c->s   = g->s[l];
+	c->p   = g->p[l];
+	c->jam = g->jam[l];
+	c->pc  = g->pc[l];
+	c->cyc = g->cyc[l];
+	for (unsigned ad = 0;  ad < 0x10000;  ad++)  c->mem[ad] = g->mem[(ad << BATCH_SH) | l] ;
+	cpu_invalidate(c, 0x0000, 0xFFFF);
+}
+
+//+============================================================================ ========================================
+void  batch_put (batch_t* b,  int i,  const cpu_t* c)
+{
+	batch_grp_t*  g = &b->grp[i / BATCH_W];
+	int           l = i % BATCH_W;
+
+	g->a[l]   = c->a;
+	g->x[l]   = c->x;
+	g->y[l]   = c->y;
+	g->s[l]   = c->s;
+	g->p[l]   = c->p;
+	g->jam[l] = c->jam;
+	g->pc[l]  = c->pc;
+	g->cyc[l] = c->cyc;
+	for (unsigned ad = 0;  ad < 0x10000;  ad++)  g->mem[(ad << BATCH_SH) | l] = c->mem[ad] ;
+}
+
+//+============================================================================ ========================================
+void  batch_reset (batch_t* b)
+{
+	for (int k = 0;  k < b->ngrp;  k++) {
+		batch_grp_t*  g   = &b->grp[k];
+		uint8_t*      mem = g->mem;
+
+		for (int i = 0;  i < BATCH_W;  i++) {
+			if (k * BATCH_W + i >= b->n)  continue ;
+			g->s[i]   -= 3;                                     // As cpu_reset()
+			g->p[i]   |= FLG_X | FLG_I;
+			g->pc[i]   = M(i, VEC_RST) | (M(i, VEC_RST + 1) << 8);
+			g->jam[i]  = 0;
+			g->cyc[i] += 7;
+		}
+	}
+}
+
+//+============================================================================ ========================================
+uint64_t  batch_run (batch_t* b,  uint64_t ncyc)
+{
+	grp_run_t  run = grp_pick();
+	uint64_t   n   = 0;
+
+	for (int k = 0;  k < b->ngrp;  k++)  n += run(&b->grp[k], ncyc) ;
+	return n;
+}
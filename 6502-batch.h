@@ -0,0 +1,59 @@
+#ifndef  _6502_BATCH_H_
+#define  _6502_BATCH_H_
+
+//----------------------------------------------------------------------------- ----------------------------------------
+#include <stddef.h>
+#include <stdint.h>
+
+#include "6502.h"
+#include "6502-cpu.h"
+
+//----------------------------------------------------------------------------- ----------------------------------------
+// Lockstep batch of independent NMOS 6502s
+//
+// Instances are held in groups of BATCH_W lanes, registers in structure-of-arrays layout;  a group is run as one
+// 32-lane vector slice (AVX-512) or two of 16 (AVX2, SSE).
+// Each step of a group takes the lowest PC among its live lanes; every lane at that PC with the same instruction bytes
+// runs the op2i-decoded instruction together (one decode & dispatch, then masked vector operations across the lanes).
+// Lanes that have diverged are masked out and catch up on a later step.
+//
+// Per instance, the results are exactly those of cpu_run(c, ncyc).
+//
+#define BATCH_SH  (5)
+#define BATCH_W   (1 << BATCH_SH)   // Lanes per group
+
+typedef
+	struct batch_grp {
+		uint8_t   a[BATCH_W], x[BATCH_W], y[BATCH_W];
+		uint8_t   s[BATCH_W];
+		uint8_t   p[BATCH_W];
+		uint8_t   jam[BATCH_W];         // (lanes past the last instance are permanently jammed)
+		uint16_t  pc[BATCH_W];
+		uint64_t  cyc[BATCH_W];
+		uint8_t*  mem;                  // 64K x BATCH_W : byte 'ad' of lane i at mem[ad * BATCH_W + i]
+		                                //   (so one address across all lanes is one vector)
+	}
+batch_grp_t;
+
+typedef
+	struct batch {
+		int           n;                // Instances
+		int           ngrp;
+		batch_grp_t*  grp;
+	}
+batch_t;
+
+//----------------------------------------------------------------------------- ----------------------------------------
+batch_t*  batch_new   (int n) ;                     // Memory zeroed, P = X | I
+void      batch_free  (batch_t* b) ;
+
+uint8_t   batch_peek  (const batch_t* b,  int i,  uint16_t ad) ;                      // Memory of instance i
+void      batch_poke  (batch_t* b,  int i,  uint16_t ad,  uint8_t v) ;
+void      batch_load  (batch_t* b,  int i,  uint16_t ad,  const uint8_t* src,  size_t sz) ;
+void      batch_get   (const batch_t* b,  int i,  cpu_t* c) ;       // Instance i -> c  (registers & memory)
+void      batch_put   (batch_t* b,  int i,  const cpu_t* c) ;       // c -> instance i
+
+void      batch_reset (batch_t* b) ;                // Every instance, as cpu_reset()
+uint64_t  batch_run   (batch_t* b,  uint64_t ncyc) ; // Every instance, as cpu_run()  -> total cycles run
+
+#endif //_6502_BATCH_H_
@@ -0,0 +1,387 @@
+// gcc  6502-bench.c  6502-cpu.c  6502-bus.c  6502-trace.c  6502-prof.c  6502-op2i.c  -o bench  -O2  -pthread
+//   ./bench [-s secs] [-f functional.bin] [rom.bin ...] > now.json
+//        decode() calls per second                          random bytes & each rom
+//        disassembly bytes per second, text on & off        random bytes & each rom
+//        emulated cycles per second, every core             built-in workloads & the functional test
+//     -s secs        : time per measurement  (default 1; the best of 3 thirds is kept)
+//     -f file.bin    : 64K functional test image  (eg. Klaus Dormann's), loaded at $0000 & run from $0400 to its trap
+//   ./bench -c old.json new.json [pct]  : compare two runs - lists every result, flags those more than pct (default 5)
+//                                         percent slower & exits 1 if there are any
+//
+// Results : one JSON object per line, on stdout  (progress on stderr)
+//   {"bench": "6502", "cc": "...", "time": 1760000000, "secs": 1.0}                        <- first line : the run
+//   {"name": "decode/random", "value": 123.45, "unit": "Mcall/s"}                          <- every result
+// Every value is a rate - bigger is better.  "name" is stable between releases, so runs can be diffed by name.
+
+//----------------------------------------------------------------------------- ----------------------------------------
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "6502.h"
+#include "6502-cpu.h"
+#include "6502-bus.h"
+#include "6502-work.h"
+
+#define RAND_SZ     (1 << 20)      // Random byte stream
+#define PAD         (4)            // Slack after a stream, so the decoders may read a whole instruction past the end
+#define SLICE       (1000000)      // Cycles per cpu_run() call
+#define FUNC_MAX    (2000000000)   // Functional test : give up after this many cycles
+#define FUNC_PC     (0x0400)       //                   start
+
+typedef  uint64_t (*run_t)(cpu_t*, uint64_t);
+
+static const struct {
+	const char*     name;
+	const uint8_t*  prg;
+	size_t          sz;
+}
+work[] = {
+	{"mixed" , bench_mix   , sizeof(bench_mix)   },
+	{"alu"   , bench_alu   , sizeof(bench_alu)   },
+	{"bcd"   , bench_bcd   , sizeof(bench_bcd)   },
+	{"branch", bench_branch, sizeof(bench_branch)},
+	{"mem"   , bench_mem   , sizeof(bench_mem)   },
+};
+
+static const struct {
+	const char*  name;
+	run_t        run;
+}
+core[] = {
+	{"eager" , cpu_run       },
+	{"lazy"  , cpu_run_lazy  },
+	{"cached", cpu_run_cached},
+	{"bus"   , cpu_run_bus   },
+};
+
+typedef
+	struct stream {
+		const char*  name;
+		uint8_t*     buf;        // sz + PAD bytes
+		size_t       sz;
+	}
+stream_t;
+
+static  double    secs = 1.0;
+static  unsigned  sink;          // Results the compiler must not throw away
+
+//+============================================================================ ========================================
+static  double  now (void)
+{
+	struct timespec  ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+//+============================================================================ ========================================
+static  void  result (const char* grp,  const char* name,  const char* sub,  double v,  const char* unit)
+{
+	char  nm[128];
+
+	snprintf(nm, sizeof(nm), "%s/%s%s%s", grp, name, sub ? "/" : "", sub ? sub : "");
+	printf("{\"name\": \"%s\", \"value\": %.3f, \"unit\": \"%s\"}\n", nm, v, unit);
+	fprintf(stderr, "%-32s %12.3f %s\n", nm, v, unit);
+	fflush(stdout);
+}
+
+//+============================================================================ ========================================
+// Best rate of 3 : fn() does one pass & returns how much it did
+//
+static  double  best3 (double (*fn)(const void*),  const void* arg)
+{
+	double  best = 0;
+
+	for (int k = 0;  k < 3;  k++) {
+		double  n  = 0,  t;
+		double  t0 = now();
+
+		do  n += fn(arg) ;  while ((t = now() - t0) < secs / 3) ;
+		if (n / t > best)  best = n / t ;
+	}
+	return best;
+}
+
+//----------------------------------------------------------------------------- ----------------------------------------
+// Decode
+//
+//+============================================================================ ========================================
+// decode() : the full decode, text operand & all
+//
+static  double  pass_decode (const void* arg)
+{
+	const stream_t*  st = arg;
+	size_t           n  = 0;
+
+	for (size_t p = 0;  p < st->sz;  n++) {
+		disasm_t  dis;
+		int       len = decode(&st->buf[p], &dis).len;
+
+		sink += dis.mnem[0];
+		p    += len ? len : 1;
+	}
+	return n;
+}
+
+//+============================================================================ ========================================
+// Text off : the instruction fields only  (decode_insn_tab())
+//
+static  double  pass_insn (const void* arg)
+{
+	const stream_t*  st = arg;
+
+	for (size_t p = 0;  p < st->sz;  ) {
+		insn_t  in = decode_insn_tab(op2i, &st->buf[p]);
+
+		sink += in.oper + in.mn;
+		p    += in.len ? in.len : 1;
+	}
+	return st->sz;
+}
+
+//+============================================================================ ========================================
+// Text on : every line rendered by dis_line()  (as ./table -d), into a buffer that is thrown away
+//
+static  double  pass_text (const void* arg)
+{
+	const stream_t*  st = arg;
+	static char      ob[1 << 16];
+	char*            s  = ob;
+
+	for (size_t p = 0;  p < st->sz;  ) {
+		if (s > ob + sizeof(ob) - DIS_LINE_MAX)  sink += s[-2],  s = ob ;
+		p += dis_line(&s, &st->buf[p], st->sz - p, (uint16_t)p, op2i, 3);
+	}
+	return st->sz;
+}
+
+//+============================================================================ ========================================
+static  void  bench_decode (const stream_t* st)
+{
+	result("decode", st->name, NULL, best3(pass_decode, st) / 1e6, "Mcall/s");
+	result("disasm", st->name, "text", best3(pass_text, st) / 1e6, "MB/s");
+	result("disasm", st->name, "notext", best3(pass_insn, st) / 1e6, "MB/s");
+}
+
+//----------------------------------------------------------------------------- ----------------------------------------
+// Emulation
+//
+typedef
+	struct emu {
+		const uint8_t*  prg;
+		size_t          sz;
+		run_t           run;
+	}
+emu_t;
+
+//+============================================================================ ========================================
+static  cpu_t*  emu_new (bus_t* b,  bus_map_t* map)
+{
+	cpu_t*  c = cpu_new();
+
+	if (!c)  return perror("cpu_new"), exit(1), NULL ;
+	bus_init(b, map);                                       // (only cpu_run_bus() uses it)
+	bus_map_ram(map, 0x00, 256, c->mem);
+	c->bus = b;
+	return c;
+}
+
+//+============================================================================ ========================================
+static  double  pass_emu (const void* arg)
+{
+	const emu_t*  e = arg;
+	cpu_t*        c;
+	bus_t         b;
+	bus_map_t     map;
+	uint64_t      n;
+
+	c = emu_new(&b, &map);
+	memcpy(&c->mem[0xC000], e->prg, e->sz);
+	c->mem[VEC_RST]     = 0x00;
+	c->mem[VEC_RST + 1] = 0xC0;
+	cpu_reset(c);
+	n = e->run(c, 20 * SLICE);
+	cpu_free(c);
+	return n;
+}
+
+//+============================================================================ ========================================
+// The functional test runs once per core, start to trap  (where it stopped is on stderr - check it against the listing)
+//
+static  void  bench_func (const uint8_t* img)
+{
+	for (size_t k = 0;  k < sizeof(core) / sizeof(*core);  k++) {
+		cpu_t*     c;
+		bus_t      b;
+		bus_map_t  map;
+		uint64_t   n = 0;
+		double     t0, t;
+
+		c = emu_new(&b, &map);
+		memcpy(c->mem, img, 0x10000);
+		cpu_reset(c);
+		c->pc = FUNC_PC;
+
+		t0 = now();
+		while (!c->jam && !cpu_trapped(c) && (n < FUNC_MAX))  n += core[k].run(c, SLICE) ;
+		t = now() - t0;
+
+		fprintf(stderr, "func %-6s : %llu cycles, stopped at $%04X%s\n",
+		        core[k].name, (unsigned long long)n, c->pc, c->jam ? " [JAM]" : (n >= FUNC_MAX) ? " [no trap]" : "");
+		result("emu", "func", core[k].name, n / t / 1e6, "MHz");
+		cpu_free(c);
+	}
+}
+
+//+============================================================================ ========================================
+static  void  bench_emu (void)
+{
+	for (size_t w = 0;  w < sizeof(work) / sizeof(*work);  w++)
+		for (size_t k = 0;  k < sizeof(core) / sizeof(*core);  k++) {
+			emu_t  e = {work[w].prg, work[w].sz, core[k].run};
+
+			result("emu", work[w].name, core[k].name, best3(pass_emu, &e) / 1e6, "MHz");
+		}
+}
+
+//----------------------------------------------------------------------------- ----------------------------------------
+// Compare two runs
+//
+#define CMP_MAX  (1024)            // Results per file
+
+typedef
+	struct res {
+		char    name[128];
+		double  value;
+	}
+res_t;
+
+//+============================================================================ ========================================
+// The result lines of a run  -> how many, or -1
+//
+static  int  load (const char* fn,  res_t* r)
+{
+	FILE*  fh = fopen(fn, "r");
+	char   ln[512];
+	int    n  = 0;
+
+	if (!fh)  return perror(fn), -1 ;
+	while (fgets(ln, sizeof(ln), fh) && (n < CMP_MAX)) {
+		const char*  nm = strstr(ln, "\"name\": \"");
+		const char*  v  = strstr(ln, "\"value\": ");
+
+		if (!nm || !v || (sscanf(nm + 9, "%127[^\"]", r[n].name) != 1))  continue ;
+		r[n++].value = strtod(v + 9, NULL);
+	}
+	fclose(fh);
+	return n;
+}
+
+//+============================================================================ ========================================
+static  int  compare (const char* old,  const char* new,  double pct)
+{
+	res_t*  a  = malloc(2 * CMP_MAX * sizeof(*a));
+	res_t*  b  = a + CMP_MAX;
+	int     na,  nb,  slow = 0;
+
+	if (!a)  return perror("malloc"), 2 ;
+	if (((na = load(old, a)) < 0) || ((nb = load(new, b)) < 0))  return free(a), 2 ;
+
+	printf("%-32s %12s %12s %8s\n", "", old, new, "");
+	for (int j = 0;  j < nb;  j++) {
+		int  i;
+
+		for (i = 0;  (i < na) && strcmp(a[i].name, b[j].name);  i++) ;
+		if (i == na) {
+			printf("%-32s %12s %12.3f %8s  new\n", b[j].name, "-", b[j].value, "");
+			continue;
+		}
+		{
+			double  r   = a[i].value ? b[j].value / a[i].value : 1;
+			int     bad = (r < 1 - pct / 100);
+
+			printf("%-32s %12.3f %12.3f %7.2fx%s\n", b[j].name, a[i].value, b[j].value, r, bad ? "  SLOWER" : "");
+			slow += bad;
+		}
+	}
+	for (int i = 0;  i < na;  i++) {
+		int  j;
+
+		for (j = 0;  (j < nb) && strcmp(a[i].name, b[j].name);  j++) ;
+		if (j == nb)  printf("%-32s %12.3f %12s %8s  gone\n", a[i].name, a[i].value, "-", "") ;
+	}
+
+	if (slow)  printf("%d result(s) more than %g%% slower\n", slow, pct) ;
+	free(a);
+	return !!slow;
+}
+
+//----------------------------------------------------------------------------- ----------------------------------------
+// Streams
+//
+//+============================================================================ ========================================
+static  int  stream_file (stream_t* st,  const char* fn)
+{
+	FILE*  fh = fopen(fn, "rb");
+	long   sz;
+
+	if (!fh)  return perror(fn), -1 ;
+	fseek(fh, 0, SEEK_END);
+	sz = ftell(fh);
+	rewind(fh);
+
+	st->name = strrchr(fn, '/') ? strrchr(fn, '/') + 1 : fn;
+	st->sz   = (sz > 0) ? sz : 0;
+	if (!(st->buf = calloc(st->sz + PAD, 1)) || (fread(st->buf, 1, st->sz, fh) != st->sz))
+		return perror(fn), fclose(fh), free(st->buf), -1 ;
+	fclose(fh);
+	return 0;
+}
+
+//+============================================================================ ========================================
+int  main (int argc,  char* argv[])
+{
+	char*     me   = argv[0];
+	char*     func = NULL;
+	stream_t  st;
+	uint32_t  x    = 0x6502;
+
+	if ((argc >= 4) && !strcmp(argv[1], "-c"))  return compare(argv[2], argv[3], (argc > 4) ? atof(argv[4]) : 5) ;
+
+	for (argc--, argv++;  argc && (**argv == '-');  argc--, argv++) {
+		if      (!strcmp(*argv, "-s") && (argc > 1))  secs = atof(*++argv),  argc-- ;
+		else if (!strcmp(*argv, "-f") && (argc > 1))  func = *++argv,  argc-- ;
+		else {
+			fprintf(stderr, "use: %s [-s secs] [-f functional.bin] [rom.bin ...]  |  %s -c old.json new.json [pct]\n", me, me);
+			return 1;
+		}
+	}
+
+	printf("{\"bench\": \"6502\", \"cc\": \"%s\", \"time\": %lld, \"secs\": %g}\n", __VERSION__, (long long)time(NULL), secs);
+
+	// Random bytes : the same every run  (xorshift32)
+	st.name = "random";
+	st.sz   = RAND_SZ;
+	if (!(st.buf = calloc(RAND_SZ + PAD, 1)))  return perror("calloc"), 1 ;
+	for (size_t i = 0;  i < RAND_SZ;  i++)  x ^= x << 13,  x ^= x >> 17,  x ^= x << 5,  st.buf[i] = x ;
+	bench_decode(&st);
+	free(st.buf);
+
+	if (func) {
+		if (stream_file(&st, func) < 0)  return 1 ;
+		if (st.sz != 0x10000)  return fprintf(stderr, "%s: not a 64K image\n", func), 1 ;
+		bench_decode(&st);
+		bench_func(st.buf);
+		free(st.buf);
+	}
+	for (int i = 0;  i < argc;  i++) {
+		if (stream_file(&st, argv[i]) < 0)  return 1 ;
+		bench_decode(&st);
+		free(st.buf);
+	}
+
+	bench_emu();
+	return sink == 0x12345678;                              // (never - keeps sink live)
+}
@@ -0,0 +1,69 @@
+//----------------------------------------------------------------------------- ----------------------------------------
+// Paged memory bus  (see 6502-bus.h)
+//
+#include <stdint.h>
+#include <string.h>
+
+#include "6502-bus.h"
+
+//+============================================================================ ========================================
+void  bus_init (bus_t* b,  const bus_map_t* map)
+{
+	memset(b, 0, sizeof(*b));
+	b->nio = 1;                                        // Handler 0: open bus
+	b->map = map;
+}
+
+//+============================================================================ ========================================
+int  bus_handler (bus_t* b,  bus_rd_t rd,  bus_wr_t wr,  void* ctx)
+{
+	if (b->nio == BUS_IO_MAX)  return -1 ;
+	b->io[b->nio] = (bus_io_t){rd, wr, ctx};
+	return b->nio++;
+}
+
+//+============================================================================ ========================================
+void  bus_map_ram (bus_map_t* m,  unsigned pg,  unsigned npg,  uint8_t* host)
+{
+	for (unsigned i = 0;  (i < npg) && (pg + i < 256);  i++) {
+		m->rd[pg + i] = host + (i << 8);
+		m->wr[pg + i] = host + (i << 8);
+		m->io[pg + i] = 0;
+	}
+}
+
+//+============================================================================ ========================================
+void  bus_map_rom (bus_map_t* m,  unsigned pg,  unsigned npg,  const uint8_t* host,  bus_t* b)
+{
+	for (unsigned i = 0;  (i < npg) && (pg + i < 256);  i++) {
+		m->rd[pg + i] = host + (i << 8);
+		m->wr[pg + i] = b->sink;
+		m->io[pg + i] = 0;
+	}
+}
+
+//+============================================================================ ========================================
+void  bus_map_io (bus_map_t* m,  unsigned pg,  unsigned npg,  int h)
+{
+	for (unsigned i = 0;  (i < npg) && (pg + i < 256);  i++) {
+		m->rd[pg + i] = NULL;
+		m->wr[pg + i] = NULL;
+		m->io[pg + i] = h;
+	}
+}
+
+//+============================================================================ ========================================
+uint8_t  bus_rd_io (const bus_t* b,  uint16_t ad)
+{
+	const bus_io_t*  io = &b->io[b->map->io[ad >> 8]];
+
+	return io->rd ? io->rd(io->ctx, ad) : 0xFF ;
+}
+
+//+============================================================================ ========================================
+void  bus_wr_io (const bus_t* b,  uint16_t ad,  uint8_t v)
+{
+	const bus_io_t*  io = &b->io[b->map->io[ad >> 8]];
+
+	if (io->wr)  io->wr(io->ctx, ad, v) ;
+}
@@ -0,0 +1,87 @@
+#ifndef  _6502_BUS_H_
+#define  _6502_BUS_H_
+
+//----------------------------------------------------------------------------- ----------------------------------------
+#include <stdint.h>
+
+//----------------------------------------------------------------------------- ----------------------------------------
+// Paged memory bus
+//
+// A page table (bus_map_t) has one entry per 256-byte page:
+//   RAM  : rd & wr point at the host memory for the page        -> an access is one table load & one byte load/store
+//   ROM  : rd points at the host memory, wr at a scratch page    -> writes are dropped without a test
+//   I/O  : rd / wr are NULL, io[] names the handler to call      -> banking registers, devices, open bus
+//
+// A machine builds one bus_map_t per memory configuration and bus_switch() picks the live one,
+// so a bank switch is a single pointer store however many pages it remaps.
+// (Or patch pages of the live map in place, with bus_map_*(), for windows with too many combinations to build up front.)
+//
+#define BUS_IO_MAX  (64)            // Handlers per bus  (0 is the open bus: reads $FF, ignores writes)
+
+typedef  uint8_t (*bus_rd_t)(void* ctx,  uint16_t ad);
+typedef  void    (*bus_wr_t)(void* ctx,  uint16_t ad,  uint8_t v);
+
+typedef
+	struct bus_io {
+		bus_rd_t  rd;               // NULL -> open bus
+		bus_wr_t  wr;               // NULL -> ignored
+		void*     ctx;
+	}
+bus_io_t;
+
+typedef
+	struct bus_map {
+		const uint8_t*  rd[256];    // Host page to read  (NULL -> io[])
+		uint8_t*        wr[256];    // Host page to write (NULL -> io[])
+		uint8_t         io[256];    // Handler for the NULL entries
+	}
+bus_map_t;
+
+typedef
+	struct bus {
+		const bus_map_t*  map;      // The live page table
+		int               nio;
+		bus_io_t          io[BUS_IO_MAX];
+		uint8_t           sink[256];  // Where ROM writes go
+	}
+bus_t;
+
+//----------------------------------------------------------------------------- ----------------------------------------
+void  bus_init    (bus_t* b,  const bus_map_t* map) ;
+int   bus_handler (bus_t* b,  bus_rd_t rd,  bus_wr_t wr,  void* ctx) ;     // -> handler number, or -1 when full
+
+// Map 'npg' pages from page 'pg' ('host' is npg * 256 bytes)
+void  bus_map_ram (bus_map_t* m,  unsigned pg,  unsigned npg,  uint8_t* host) ;
+void  bus_map_rom (bus_map_t* m,  unsigned pg,  unsigned npg,  const uint8_t* host,  bus_t* b) ;
+void  bus_map_io  (bus_map_t* m,  unsigned pg,  unsigned npg,  int h) ;
+
+// Slow paths  (I/O pages)
+__attribute__((cold))  uint8_t  bus_rd_io (const bus_t* b,  uint16_t ad) ;
+__attribute__((cold))  void     bus_wr_io (const bus_t* b,  uint16_t ad,  uint8_t v) ;
+
+//+============================================================================ ========================================
+// Bank switch
+//
+static inline  void  bus_switch (bus_t* b,  const bus_map_t* map)
+{
+	b->map = map;
+}
+
+//+============================================================================ ========================================
+static inline  uint8_t  bus_rd (const bus_t* b,  uint16_t ad)
+{
+	const uint8_t*  pg = b->map->rd[ad >> 8];
+
+	return __builtin_expect(pg != NULL, 1) ? pg[ad & 0xFF] : bus_rd_io(b, ad) ;
+}
+
+//+============================================================================ ========================================
+static inline  void  bus_wr (const bus_t* b,  uint16_t ad,  uint8_t v)
+{
+	uint8_t*  pg = b->map->wr[ad >> 8];
+
+	if (__builtin_expect(pg != NULL, 1))  pg[ad & 0xFF] = v ;
+	else                                  bus_wr_io(b, ad, v) ;
+}
+
+#endif //_6502_BUS_H_
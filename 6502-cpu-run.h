@@ -0,0 +1,613 @@
+//----------------------------------------------------------------------------- ----------------------------------------
+// The interpreter loop - #included by 6502-cpu.c once per flag strategy
+//
+//   CPU_RUN   : name of the function to generate
+//   CPU_LAZY  : 0 -> P is updated as each instruction executes
+//               1 -> only the last result/operands are kept; N, Z, C & V are worked out when they are read
+//   CPU_BLOCK : 0 -> fetch & decode every instruction from memory
+//               1 -> execute pre-decoded blocks from the block cache (c->bc)
+//   CPU_BUS   : 0 -> memory is c->mem
+//               1 -> memory is c->bus  (page table; not with CPU_BLOCK)
+//   CPU_TRACE : 1 -> the instructions run are counted into c->trace, & what replay can not work out for itself
+//                    (cycles over op2i[].t, I/O reads) goes into its events  (eager flags on c->mem, lazy on a bus)
+//                    cpu_run_trace() records the state at either end of the run  (see 6502-trace.h)
+//   CPU_PROF  : 1 -> every instruction's cycles are charged to its address in c->prof, calls & returns go to its
+//                    call tree  (eager flags & c->mem only)
+//
+//+============================================================================ ========================================
+// Run for (at least) 'ncyc' cycles, or until an invalid opcode
+// Returns the number of cycles actually run
+//
+#if CPU_TRACE || CPU_PROF
+static
+#endif
+uint64_t  CPU_RUN (cpu_t* c,  uint64_t ncyc)
+{
+#	pragma GCC diagnostic push
+#	pragma GCC diagnostic ignored "-Woverride-init"        // [0x00 ... 0xFF] is the default, then overridden
+#	define L(o)   [o] = &&L_##o
+	static const void* const  jt[256] = {
+		[0x00 ... 0xFF] = &&ill,
+
+		L(OP_ADC_ABS ), L(OP_ADC_ABSX), L(OP_ADC_ABSY), L(OP_ADC_IMM ), L(OP_ADC_INDX), L(OP_ADC_INDY), L(OP_ADC_ZP  ), L(OP_ADC_ZPX ),
+		L(OP_AND_ABS ), L(OP_AND_ABSX), L(OP_AND_ABSY), L(OP_AND_IMM ), L(OP_AND_INDX), L(OP_AND_INDY), L(OP_AND_ZP  ), L(OP_AND_ZPX ),
+		L(OP_ASL_ABS ), L(OP_ASL_ABSX), L(OP_ASL_ACC ), L(OP_ASL_ZP  ), L(OP_ASL_ZPX ),
+		L(OP_BCC_REL ), L(OP_BCS_REL ), L(OP_BEQ_REL ), L(OP_BMI_REL ), L(OP_BNE_REL ), L(OP_BPL_REL ), L(OP_BVC_REL ), L(OP_BVS_REL ),
+		L(OP_BIT_ABS ), L(OP_BIT_ZP  ), L(OP_BRK_IMP ),
+		L(OP_CLC_IMP ), L(OP_CLD_IMP ), L(OP_CLI_IMP ), L(OP_CLV_IMP ),
+		L(OP_CMP_ABS ), L(OP_CMP_ABSX), L(OP_CMP_ABSY), L(OP_CMP_IMM ), L(OP_CMP_INDX), L(OP_CMP_INDY), L(OP_CMP_ZP  ), L(OP_CMP_ZPX ),
+		L(OP_CPX_ABS ), L(OP_CPX_IMM ), L(OP_CPX_ZP  ), L(OP_CPY_ABS ), L(OP_CPY_IMM ), L(OP_CPY_ZP  ),
+		L(OP_DEC_ABS ), L(OP_DEC_ABSX), L(OP_DEC_ZP  ), L(OP_DEC_ZPX ), L(OP_DEX_IMP ), L(OP_DEY_IMP ),
+		L(OP_EOR_ABS ), L(OP_EOR_ABSX), L(OP_EOR_ABSY), L(OP_EOR_IMM ), L(OP_EOR_INDX), L(OP_EOR_INDY), L(OP_EOR_ZP  ), L(OP_EOR_ZPX ),
+		L(OP_INC_ABS ), L(OP_INC_ABSX), L(OP_INC_ZP  ), L(OP_INC_ZPX ), L(OP_INX_IMP ), L(OP_INY_IMP ),
+		L(OP_JMP_ABS ), L(OP_JMP_IND ), L(OP_JSR_ABS ),
+		L(OP_LDA_ABS ), L(OP_LDA_ABSX), L(OP_LDA_ABSY), L(OP_LDA_IMM ), L(OP_LDA_INDX), L(OP_LDA_INDY), L(OP_LDA_ZP  ), L(OP_LDA_ZPX ),
+		L(OP_LDX_ABS ), L(OP_LDX_ABSY), L(OP_LDX_IMM ), L(OP_LDX_ZP  ), L(OP_LDX_ZPY ),
+		L(OP_LDY_ABS ), L(OP_LDY_ABSX), L(OP_LDY_IMM ), L(OP_LDY_ZP  ), L(OP_LDY_ZPX ),
+		L(OP_LSR_ABS ), L(OP_LSR_ABSX), L(OP_LSR_IMM ), L(OP_LSR_ZP  ), L(OP_LSR_ZPX ),
+		L(OP_NOP_IMP ),
+		L(OP_ORA_ABS ), L(OP_ORA_ABSX), L(OP_ORA_ABSY), L(OP_ORA_IMM ), L(OP_ORA_INDX), L(OP_ORA_INDY), L(OP_ORA_ZP  ), L(OP_ORA_ZPX ),
+		L(OP_PHA_IMP ), L(OP_PHP_IMP ), L(OP_PLA_IMP ), L(OP_PLP_IMP ),
+		L(OP_ROL_ABS ), L(OP_ROL_ABSX), L(OP_ROL_ACC ), L(OP_ROL_ZP  ), L(OP_ROL_ZPX ),
+		L(OP_ROR_ABS ), L(OP_ROR_ABSX), L(OP_ROR_ACC ), L(OP_ROR_ZP  ), L(OP_ROR_ZPX ),
+		L(OP_RTI_IMP ), L(OP_RTS_IMP ),
+		L(OP_SBC_ABS ), L(OP_SBC_ABSX), L(OP_SBC_ABSY), L(OP_SBC_IMM ), L(OP_SBC_INDX), L(OP_SBC_INDY), L(OP_SBC_ZP  ), L(OP_SBC_ZPX ),
+		L(OP_SEC_IMP ), L(OP_SED_IMP ), L(OP_SEI_IMP ),
+		L(OP_STA_ABS ), L(OP_STA_ABSX), L(OP_STA_ABSY), L(OP_STA_INDX), L(OP_STA_INDY), L(OP_STA_ZP  ), L(OP_STA_ZPX ),
+		L(OP_STX_ABS ), L(OP_STX_ZP  ), L(OP_STX_ZPY ), L(OP_STY_ABS ), L(OP_STY_ZP  ), L(OP_STY_ZPX ),
+		L(OP_TAX_IMP ), L(OP_TAY_IMP ), L(OP_TSX_IMP ), L(OP_TXA_IMP ), L(OP_TXS_IMP ), L(OP_TYA_IMP ),
+	};
+#	undef L
+#	pragma GCC diagnostic pop
+
+#if CPU_BLOCK
+	if (!c->bc && !(c->bc = calloc(1, sizeof(*c->bc))))  return 0 ;
+#endif
+
+	uint8_t*  dt  = c->dirty;           // Pages written
+#if CPU_BUS
+	const bus_t*      bus = c->bus;
+	const bus_map_t*  pt  = bus->map;      // Live page table  (reloaded after every I/O access)
+#else
+	uint8_t*  m   = c->mem;
+#endif
+#if CPU_TRACE
+	trace_t*  tr  = c->trace;
+	uint64_t  ni  = tr->n;              // Instructions run  (the one running is ni - 1)
+	uint64_t  nev = tr->nev;            // Instruction of the last event
+	uint8_t*  ev  = tr->wp;             // Next event
+	uint8_t*  evl = tr->el;             //   ...the run stops once past here
+#endif
+#if CPU_PROF
+	prof_t*   pf  = c->prof;
+	uint16_t  ipc;                      // The instruction running  (where it started
+	uint64_t  icyc;                     //   & the cycle count before it)
+#endif
+	uint8_t   a   = c->a,  x = c->x,  y = c->y,  s = c->s,  p = c->p;
+	uint16_t  pc  = c->pc;
+	uint64_t  cyc = c->cyc;
+	uint64_t  end = cyc + ncyc;
+	uint8_t   t, v;
+	uint16_t  ea, b;
+#if !CPU_BLOCK
+	uint8_t   op;
+#endif
+#if CPU_BLOCK
+	bcache_t*        bc  = c->bc;
+	const uint8_t*   cp  = bc->code;       // Pages that hold cached code
+	const bc_ins_t*  ip  = NULL;           // Executing
+	const bc_ins_t*  ipe = NULL;           // Last instruction of the block
+#endif
+#if CPU_LAZY
+	uint8_t   fn, fz, fc;               // N = fn.7    Z = (fz == 0)    C = fc
+	uint8_t   va, vb, vr;               // V = ((va ^ vr) & (vb ^ vr)).7    <- operands & result of the last ADC/SBC
+	unsigned  r;
+#endif
+
+	//------------------------------------------------------------------------- ----------------------------------------
+	// Trace events  (an expression)
+#if CPU_TRACE
+#	define EVENT(k)     (ev = trace_ev(ev, ((ni - 1 - nev) << 2) | (k)),  nev = ni - 1,  (ev >= evl) ? (end = 0) : 0)
+#	define TAKEN(pg)    EVENT(TRACE_EV_CY1 + (pg))
+#else
+#	define TAKEN(pg)
+#endif
+
+	//------------------------------------------------------------------------- ----------------------------------------
+	// Bus & stack
+#if CPU_BUS && CPU_TRACE
+	// Replay has no devices, so I/O reads are recorded.  A handler that switched the map ends the run after this
+	// instruction  (the next key frame has the new one)
+#	define IO_DONE()    ((bus->map != pt) ? (pt = bus->map,  end = 0) : 0)
+#	define RD(ad)       ({                                              \
+			uint16_t        ra_ = (ad);                                 \
+			const uint8_t*  rp_ = pt->rd[ra_ >> 8];                     \
+			uint8_t         rv_;                                        \
+			if (__builtin_expect(rp_ != NULL, 1)) {                     \
+				rv_ = rp_[ra_ & 0xFF];                                  \
+			} else {                                                    \
+				rv_ = bus_rd_io(bus, ra_);                              \
+				EVENT(TRACE_EV_IO);                                     \
+				*ev++ = rv_;                                            \
+				IO_DONE();                                              \
+			}                                                           \
+			rv_;                                                        \
+		})
+#	define PULL()       RD(0x100 | ++s)
+#elif CPU_BUS
+#	define RD(ad)       bus_rd_pt(bus, &pt, (uint16_t)(ad))
+#	define PULL()       RD(0x100 | ++s)
+#else
+#	define RD(ad)       (m[(uint16_t)(ad)])
+#	define PULL()       (m[0x100 | ++s])
+#endif
+#	define RD16(ad)     (RD(ad) | (RD((ad) + 1) << 8))
+#	define RD16ZP(zp)   (RD((uint8_t)(zp)) | (RD((uint8_t)((zp) + 1)) << 8))     // Pointer wraps within page 0
+// Every write marks its page in dt[]  (a traced write is replayed, so is not the host's)
+#if CPU_TRACE
+#	define DIRTY        (DIRTY_ALL & ~DIRTY_HOST)
+#else
+#	define DIRTY        DIRTY_ALL
+#endif
+#if CPU_BUS && CPU_TRACE
+#	define WR(ad, v)    do {                                            \
+			uint16_t  wa_ = (ad);                                       \
+			uint8_t*  wp_ = pt->wr[wa_ >> 8];                           \
+			dt[wa_ >> 8] = DIRTY;                                       \
+			if (__builtin_expect(wp_ != NULL, 1))  wp_[wa_ & 0xFF] = (v) ;  \
+			else                                   bus_wr_io(bus, wa_, (v)),  IO_DONE() ;  \
+		} while (0)
+#	define PUSH(v)      WR(0x100 | s--, v)
+#elif CPU_BUS
+#	define WR(ad, v)    do {                                            \
+			uint16_t  wa_ = (ad);                                       \
+			dt[wa_ >> 8] = DIRTY;                                       \
+			bus_wr_pt(bus, &pt, wa_, (v));                              \
+		} while (0)
+#	define PUSH(v)      WR(0x100 | s--, v)
+#elif CPU_BLOCK
+	// A write to a page with cached code kills its blocks, and ends this block after the current instruction
+#	define WR(ad, v)    do {                                            \
+			uint16_t  wa_ = (ad);                                       \
+			m[wa_] = (v);                                               \
+			dt[wa_ >> 8] = DIRTY;                                       \
+			if (cp[wa_ >> 8])  bc_smc(bc, wa_ >> 8),  ipe = ip ;        \
+		} while (0)
+#	define PUSH(v)      WR(0x100 | s--, v)
+#else
+#	define WR(ad, v)    (dt[(uint16_t)(ad) >> 8] = DIRTY,  m[(uint16_t)(ad)] = (v))
+#	define PUSH(v)      (dt[1] = DIRTY,  m[0x100 | s--] = (v))
+#endif
+
+	// Operand fetch  (leaves pc at the next instruction)
+#if CPU_BLOCK
+#	define FETCH8()     ((uint8_t)ip->oper)
+#	define FETCH16()    (ip->oper)
+#	define EA_IMM       (ea = pc - 1)
+#else
+#	define FETCH8()     RD(pc++)
+#	define FETCH16()    (pc += 2,  RD16(pc - 2))
+#	define EA_IMM       (ea = pc++)
+#endif
+
+	// Footnote [1]
+#if CPU_TRACE
+#	define PAGEX(b, ea) (((t >= 10) & ((((b) ^ (ea)) >> 8) & 1)) ? (cyc++,  EVENT(TRACE_EV_CY1)) : 0)
+#else
+#	define PAGEX(b, ea) (cyc += (t >= 10) & ((((b) ^ (ea)) >> 8) & 1))
+#endif
+
+	// Effective address
+#	define EA_ZP        (ea = FETCH8())
+#	define EA_ZPX       (ea = (uint8_t)(FETCH8() + x))
+#	define EA_ZPY       (ea = (uint8_t)(FETCH8() + y))
+#	define EA_ABS       (ea = FETCH16())
+#	define EA_ABSX      (b  = FETCH16(), ea = b + x, PAGEX(b, ea))
+#	define EA_ABSY      (b  = FETCH16(), ea = b + y, PAGEX(b, ea))
+#	define EA_INDX      (b  = (uint8_t)(FETCH8() + x), ea = RD16ZP(b))
+#	define EA_INDY      (b  = FETCH8(), b = RD16ZP(b), ea = b + y, PAGEX(b, ea))
+
+	// Flags
+#if CPU_LAZY
+	// Only the inputs are recorded, P is rebuilt when something reads it as a whole (PHP, BRK, leaving the core)
+#	define SETNZ(r)     (fn = fz = (r))
+#	define SETC(cond)   (fc = !!(cond))
+#	define SETV(f)      (va = vb = 0,  vr = (f) ? 0x80 : 0)
+#	define IS_N         (fn & 0x80)
+#	define IS_V         ((va ^ vr) & (vb ^ vr) & 0x80)
+#	define IS_Z         (!fz)
+#	define IS_C         (fc)
+#	define LAZY_F       (FLG_N | FLG_V | FLG_Z | FLG_C)
+#	define GET_P()      ( (p & ~LAZY_F) | (fn & FLG_N) | (IS_V ? FLG_V : 0) | (IS_Z << 1) | fc | FLG_X )
+#	define SET_P(v)     (p = (v),  fn = p,  fz = !(p & FLG_Z),  fc = p & FLG_C,  SETV(p & FLG_V))
+	// Decimal mode straight from the tables : ADC's N, V & C are the table's, Z the binary sum's;  SBC's flags are binary
+#	define ADC(EA)      { EA;  v = RD(ea);                                                     \
+	                      if (p & FLG_D) {  r = adc_bcd(a, v, fc);  fz = a + v + fc;  fn = r >> 8;  fc = (r >> 8) & FLG_C;  \
+	                                        SETV(r & (FLG_V << 8));  a = r;  }               \
+	                      else {  r = a + v + fc;         va = a;  vb =  v;  vr = r;  fc = r >> 8;  a = r;  SETNZ(a);  } \
+	                      NEXT; }
+#	define SBC(EA)      { EA;  v = RD(ea);  r = a + (uint8_t)~v + fc;                          \
+	                      b  = (p & FLG_D) ? sbc_bcd(a, v, fc) : (uint8_t)r;                   \
+	                      va = a;  vb = ~v;  vr = r;  fc = r >> 8;  SETNZ((uint8_t)r);  a = b;  \
+	                      NEXT; }
+#	define BIT(EA)      { EA;  v = RD(ea);  fn = v;  fz = a & v;  SETV(v & FLG_V);  NEXT; }
+#else
+#	define SETNZ(r)     (p = (p & ~(FLG_N | FLG_Z)) | ((r) & FLG_N) | (!(r) << 1))
+#	define SETC(cond)   (p = (p & ~FLG_C) | !!(cond))
+#	define SETV(f)      (p = (p & ~FLG_V) | ((f) ? FLG_V : 0))
+#	define IS_N         (p & FLG_N)
+#	define IS_V         (p & FLG_V)
+#	define IS_Z         (p & FLG_Z)
+#	define IS_C         (p & FLG_C)
+#	define GET_P()      (p | FLG_X)
+#	define SET_P(v)     (p = (v))
+#	define ADC(EA)      { EA;  a = adc(a, RD(ea), &p);                          NEXT; }
+#	define SBC(EA)      { EA;  a = sbc(a, RD(ea), &p);                          NEXT; }
+#	define BIT(EA)      { EA;  v = RD(ea);  p = (p & ~(FLG_N | FLG_V | FLG_Z)) | (v & (FLG_N | FLG_V)) | (!(a & v) << 1);  NEXT; }
+#endif
+
+	// Fetch, add the base Tcnt, dispatch
+#if CPU_BLOCK
+	// The cycle budget is only checked between blocks
+#	define NEXT  do {                                       \
+			if (ip == ipe)  goto block ;                    \
+			ip++;                                           \
+			goto dispatch;                                  \
+		} while (0)
+#elif CPU_TRACE
+#	define NEXT  do {                                       \
+			if (cyc >= end)  goto out ;                     \
+			ni++;                                           \
+			op   = RD(pc++);                                \
+			t    = op2i[op].t;                              \
+			cyc += t % 10;                                  \
+			goto *jt[op];                                   \
+		} while (0)
+#elif CPU_PROF
+#	define NEXT  goto next
+#else
+#	define NEXT  do {                                       \
+			if (cyc >= end)  goto out ;                     \
+			op   = RD(pc++);                                \
+			t    = op2i[op].t;                              \
+			cyc += t % 10;                                  \
+			goto *jt[op];                                   \
+		} while (0)
+#endif
+
+	//------------------------------------------------------------------------- ----------------------------------------
+	// Instruction bodies
+#	define LD(r, EA)    { EA;  r = RD(ea);  SETNZ(r);                           NEXT; }
+#	define ST(r, EA)    { EA;  WR(ea, r);                                       NEXT; }
+#	define ALU(expr,EA) { EA;  v = RD(ea);  a = (expr);  SETNZ(a);              NEXT; }
+#	define CMP(r, EA)   { EA;  v = RD(ea);  SETC(r >= v);  v = r - v;  SETNZ(v); NEXT; }
+#	define RMW(expr,EA) { EA;  v = RD(ea);  expr;  WR(ea, v);  SETNZ(v);        NEXT; }
+#	define BR(cond)     { v = FETCH8();                                         \
+	                      if (cond) {                                           \
+	                          b    = pc;                                        \
+	                          pc  += (int8_t)v;                                 \
+	                          cyc += 1 + (((b ^ pc) >> 8) & 1);                 \
+	                          TAKEN(((b ^ pc) >> 8) & 1);                       \
+	                      }                                                     \
+	                      NEXT; }
+
+	// Call tree  (pc : where it went, sr : S once it returns)
+#if CPU_PROF
+#	define CALLED(k, sr)  prof_call(pf, pc, k, sr, cyc)
+#	define RETURNED()     prof_ret(pf, s, cyc)
+#else
+#	define CALLED(k, sr)
+#	define RETURNED()
+#endif
+
+	// Shifts & rotates on 'v'
+#	define DO_ASL       (SETC(v & 0x80),  v <<= 1)
+#	define DO_LSR       (SETC(v & 0x01),  v >>= 1)
+#	define DO_ROL       (b = !!IS_C,  SETC(v & 0x80),  v = (v << 1) | b)
+#	define DO_ROR       (b = !!IS_C,  SETC(v & 0x01),  v = (v >> 1) | (b << 7))
+
+#if CPU_LAZY
+	SET_P(p);
+#endif
+
+#if CPU_BLOCK
+block:
+	if (cyc >= end)  goto out ;
+	{
+		const bc_blk_t*  blk = bc_get(bc, m, pc, jt);
+
+		if (!blk)  goto jam ;                                // Invalid opcode at pc
+		ip  = blk->ins;
+		ipe = blk->ins + blk->n - 1;
+	}
+dispatch:
+	t    = ip->t;
+	pc   = ip->next;
+	cyc += ip->tb;
+	goto *ip->h;
+#elif CPU_PROF
+	if (cyc >= end)  goto out ;                             // As NEXT :  no budget, no instruction
+	goto first;
+next:
+	pf->pc[ipc].n++;
+	pf->pc[ipc].cyc += cyc - icyc;
+	if (cyc >= end)  goto out ;
+first:
+	ipc  = pc;
+	icyc = cyc;
+	op   = RD(pc++);
+	t    = op2i[op].t;
+	cyc += t % 10;
+	goto *jt[op];
+#else
+	NEXT;
+#endif
+
+	L_OP_ADC_IMM :  ADC(EA_IMM )
+	L_OP_ADC_ZP  :  ADC(EA_ZP  )
+	L_OP_ADC_ZPX :  ADC(EA_ZPX )
+	L_OP_ADC_ABS :  ADC(EA_ABS )
+	L_OP_ADC_ABSX:  ADC(EA_ABSX)
+	L_OP_ADC_ABSY:  ADC(EA_ABSY)
+	L_OP_ADC_INDX:  ADC(EA_INDX)
+	L_OP_ADC_INDY:  ADC(EA_INDY)
+
+	L_OP_SBC_IMM :  SBC(EA_IMM )
+	L_OP_SBC_ZP  :  SBC(EA_ZP  )
+	L_OP_SBC_ZPX :  SBC(EA_ZPX )
+	L_OP_SBC_ABS :  SBC(EA_ABS )
+	L_OP_SBC_ABSX:  SBC(EA_ABSX)
+	L_OP_SBC_ABSY:  SBC(EA_ABSY)
+	L_OP_SBC_INDX:  SBC(EA_INDX)
+	L_OP_SBC_INDY:  SBC(EA_INDY)
+
+	L_OP_AND_IMM :  ALU(a & v, EA_IMM )
+	L_OP_AND_ZP  :  ALU(a & v, EA_ZP  )
+	L_OP_AND_ZPX :  ALU(a & v, EA_ZPX )
+	L_OP_AND_ABS :  ALU(a & v, EA_ABS )
+	L_OP_AND_ABSX:  ALU(a & v, EA_ABSX)
+	L_OP_AND_ABSY:  ALU(a & v, EA_ABSY)
+	L_OP_AND_INDX:  ALU(a & v, EA_INDX)
+	L_OP_AND_INDY:  ALU(a & v, EA_INDY)
+
+	L_OP_ORA_IMM :  ALU(a | v, EA_IMM )
+	L_OP_ORA_ZP  :  ALU(a | v, EA_ZP  )
+	L_OP_ORA_ZPX :  ALU(a | v, EA_ZPX )
+	L_OP_ORA_ABS :  ALU(a | v, EA_ABS )
+	L_OP_ORA_ABSX:  ALU(a | v, EA_ABSX)
+	L_OP_ORA_ABSY:  ALU(a | v, EA_ABSY)
+	L_OP_ORA_INDX:  ALU(a | v, EA_INDX)
+	L_OP_ORA_INDY:  ALU(a | v, EA_INDY)
+
+	L_OP_EOR_IMM :  ALU(a ^ v, EA_IMM )
+	L_OP_EOR_ZP  :  ALU(a ^ v, EA_ZP  )
+	L_OP_EOR_ZPX :  ALU(a ^ v, EA_ZPX )
+	L_OP_EOR_ABS :  ALU(a ^ v, EA_ABS )
+	L_OP_EOR_ABSX:  ALU(a ^ v, EA_ABSX)
+	L_OP_EOR_ABSY:  ALU(a ^ v, EA_ABSY)
+	L_OP_EOR_INDX:  ALU(a ^ v, EA_INDX)
+	L_OP_EOR_INDY:  ALU(a ^ v, EA_INDY)
+
+	L_OP_CMP_IMM :  CMP(a, EA_IMM )
+	L_OP_CMP_ZP  :  CMP(a, EA_ZP  )
+	L_OP_CMP_ZPX :  CMP(a, EA_ZPX )
+	L_OP_CMP_ABS :  CMP(a, EA_ABS )
+	L_OP_CMP_ABSX:  CMP(a, EA_ABSX)
+	L_OP_CMP_ABSY:  CMP(a, EA_ABSY)
+	L_OP_CMP_INDX:  CMP(a, EA_INDX)
+	L_OP_CMP_INDY:  CMP(a, EA_INDY)
+	L_OP_CPX_IMM :  CMP(x, EA_IMM )
+	L_OP_CPX_ZP  :  CMP(x, EA_ZP  )
+	L_OP_CPX_ABS :  CMP(x, EA_ABS )
+	L_OP_CPY_IMM :  CMP(y, EA_IMM )
+	L_OP_CPY_ZP  :  CMP(y, EA_ZP  )
+	L_OP_CPY_ABS :  CMP(y, EA_ABS )
+
+	L_OP_BIT_ZP  :  BIT(EA_ZP  )
+	L_OP_BIT_ABS :  BIT(EA_ABS )
+
+	L_OP_LDA_IMM :  LD(a, EA_IMM )
+	L_OP_LDA_ZP  :  LD(a, EA_ZP  )
+	L_OP_LDA_ZPX :  LD(a, EA_ZPX )
+	L_OP_LDA_ABS :  LD(a, EA_ABS )
+	L_OP_LDA_ABSX:  LD(a, EA_ABSX)
+	L_OP_LDA_ABSY:  LD(a, EA_ABSY)
+	L_OP_LDA_INDX:  LD(a, EA_INDX)
+	L_OP_LDA_INDY:  LD(a, EA_INDY)
+	L_OP_LDX_IMM :  LD(x, EA_IMM )
+	L_OP_LDX_ZP  :  LD(x, EA_ZP  )
+	L_OP_LDX_ZPY :  LD(x, EA_ZPY )
+	L_OP_LDX_ABS :  LD(x, EA_ABS )
+	L_OP_LDX_ABSY:  LD(x, EA_ABSY)
+	L_OP_LDY_IMM :  LD(y, EA_IMM )
+	L_OP_LDY_ZP  :  LD(y, EA_ZP  )
+	L_OP_LDY_ZPX :  LD(y, EA_ZPX )
+	L_OP_LDY_ABS :  LD(y, EA_ABS )
+	L_OP_LDY_ABSX:  LD(y, EA_ABSX)
+
+	// Stores have no footnote, so PAGEX adds nothing (their Tcnt already includes the fix-up cycle)
+	L_OP_STA_ZP  :  ST(a, EA_ZP  )
+	L_OP_STA_ZPX :  ST(a, EA_ZPX )
+	L_OP_STA_ABS :  ST(a, EA_ABS )
+	L_OP_STA_ABSX:  ST(a, EA_ABSX)
+	L_OP_STA_ABSY:  ST(a, EA_ABSY)
+	L_OP_STA_INDX:  ST(a, EA_INDX)
+	L_OP_STA_INDY:  ST(a, EA_INDY)
+	L_OP_STX_ZP  :  ST(x, EA_ZP  )
+	L_OP_STX_ZPY :  ST(x, EA_ZPY )
+	L_OP_STX_ABS :  ST(x, EA_ABS )
+	L_OP_STY_ZP  :  ST(y, EA_ZP  )
+	L_OP_STY_ZPX :  ST(y, EA_ZPX )
+	L_OP_STY_ABS :  ST(y, EA_ABS )
+
+	L_OP_ASL_ACC :  v = a;  DO_ASL;  a = v;  SETNZ(a);  NEXT;
+	L_OP_ASL_ZP  :  RMW(DO_ASL, EA_ZP  )
+	L_OP_ASL_ZPX :  RMW(DO_ASL, EA_ZPX )
+	L_OP_ASL_ABS :  RMW(DO_ASL, EA_ABS )
+	L_OP_ASL_ABSX:  RMW(DO_ASL, EA_ABSX)
+	L_OP_LSR_IMM :  v = a;  DO_LSR;  a = v;  SETNZ(a);  NEXT;    // (Accumulator)
+	L_OP_LSR_ZP  :  RMW(DO_LSR, EA_ZP  )
+	L_OP_LSR_ZPX :  RMW(DO_LSR, EA_ZPX )
+	L_OP_LSR_ABS :  RMW(DO_LSR, EA_ABS )
+	L_OP_LSR_ABSX:  RMW(DO_LSR, EA_ABSX)
+	L_OP_ROL_ACC :  v = a;  DO_ROL;  a = v;  SETNZ(a);  NEXT;
+	L_OP_ROL_ZP  :  RMW(DO_ROL, EA_ZP  )
+	L_OP_ROL_ZPX :  RMW(DO_ROL, EA_ZPX )
+	L_OP_ROL_ABS :  RMW(DO_ROL, EA_ABS )
+	L_OP_ROL_ABSX:  RMW(DO_ROL, EA_ABSX)
+	L_OP_ROR_ACC :  v = a;  DO_ROR;  a = v;  SETNZ(a);  NEXT;
+	L_OP_ROR_ZP  :  RMW(DO_ROR, EA_ZP  )
+	L_OP_ROR_ZPX :  RMW(DO_ROR, EA_ZPX )
+	L_OP_ROR_ABS :  RMW(DO_ROR, EA_ABS )
+	L_OP_ROR_ABSX:  RMW(DO_ROR, EA_ABSX)
+	L_OP_INC_ZP  :  RMW(v++, EA_ZP  )
+	L_OP_INC_ZPX :  RMW(v++, EA_ZPX )
+	L_OP_INC_ABS :  RMW(v++, EA_ABS )
+	L_OP_INC_ABSX:  RMW(v++, EA_ABSX)
+	L_OP_DEC_ZP  :  RMW(v--, EA_ZP  )
+	L_OP_DEC_ZPX :  RMW(v--, EA_ZPX )
+	L_OP_DEC_ABS :  RMW(v--, EA_ABS )
+	L_OP_DEC_ABSX:  RMW(v--, EA_ABSX)
+
+	L_OP_INX_IMP :  x++;  SETNZ(x);  NEXT;
+	L_OP_INY_IMP :  y++;  SETNZ(y);  NEXT;
+	L_OP_DEX_IMP :  x--;  SETNZ(x);  NEXT;
+	L_OP_DEY_IMP :  y--;  SETNZ(y);  NEXT;
+
+	L_OP_TAX_IMP :  x = a;  SETNZ(x);  NEXT;
+	L_OP_TAY_IMP :  y = a;  SETNZ(y);  NEXT;
+	L_OP_TXA_IMP :  a = x;  SETNZ(a);  NEXT;
+	L_OP_TYA_IMP :  a = y;  SETNZ(a);  NEXT;
+	L_OP_TSX_IMP :  x = s;  SETNZ(x);  NEXT;
+	L_OP_TXS_IMP :  s = x;             NEXT;
+
+	L_OP_CLC_IMP :  SETC(0);      NEXT;
+	L_OP_CLD_IMP :  p &= ~FLG_D;  NEXT;
+	L_OP_CLI_IMP :  p &= ~FLG_I;  NEXT;
+	L_OP_CLV_IMP :  SETV(0);      NEXT;
+	L_OP_SEC_IMP :  SETC(1);      NEXT;
+	L_OP_SED_IMP :  p |=  FLG_D;  NEXT;
+	L_OP_SEI_IMP :  p |=  FLG_I;  NEXT;
+
+	L_OP_NOP_IMP :  NEXT;
+
+	L_OP_BPL_REL :  BR(!IS_N)
+	L_OP_BMI_REL :  BR( IS_N)
+	L_OP_BVC_REL :  BR(!IS_V)
+	L_OP_BVS_REL :  BR( IS_V)
+	L_OP_BCC_REL :  BR(!IS_C)
+	L_OP_BCS_REL :  BR( IS_C)
+	L_OP_BNE_REL :  BR(!IS_Z)
+	L_OP_BEQ_REL :  BR( IS_Z)
+
+	L_OP_JMP_ABS :  pc = FETCH16();  NEXT;
+	L_OP_JMP_IND :  b  = FETCH16();                                  // NMOS bug: the pointer never crosses a page
+	                pc = RD(b) | (RD((b & 0xFF00) | ((b + 1) & 0xFF)) << 8);
+	                NEXT;
+
+	L_OP_JSR_ABS :  ea = FETCH16();
+	                pc--;                                            // Return address is the last byte of the JSR
+	                PUSH(pc >> 8);
+	                PUSH(pc & 0xFF);
+	                pc = ea;
+	                CALLED(PROF_JSR, (uint8_t)(s + 2));
+	                NEXT;
+
+	L_OP_RTS_IMP :  pc  = PULL();
+	                pc |= PULL() << 8;
+	                pc++;
+	                RETURNED();
+	                NEXT;
+
+	L_OP_RTI_IMP :  SET_P((PULL() & ~FLG_B) | FLG_X);
+	                pc  = PULL();
+	                pc |= PULL() << 8;
+	                RETURNED();
+	                NEXT;
+
+	L_OP_BRK_IMP :  pc++;                                            // BRK has a padding byte
+	                PUSH(pc >> 8);
+	                PUSH(pc & 0xFF);
+	                PUSH(GET_P() | FLG_B);
+	                p |= FLG_I;
+	                pc = RD16(VEC_IRQ);
+	                CALLED(PROF_BRK, (uint8_t)(s + 3));
+	                NEXT;
+
+	L_OP_PHA_IMP :  PUSH(a);                       NEXT;
+	L_OP_PHP_IMP :  PUSH(GET_P() | FLG_B);  NEXT;
+	L_OP_PLA_IMP :  a = PULL();  SETNZ(a);         NEXT;
+	L_OP_PLP_IMP :  SET_P((PULL() & ~FLG_B) | FLG_X);  NEXT;
+
+ill:
+	pc--;
+#if CPU_BLOCK
+jam:
+#endif
+	c->jam = 1;
+
+out:
+#if CPU_TRACE
+	tr->n   = ni;
+	tr->nev = nev;
+	tr->wp  = ev;
+#endif
+	c->a   = a;
+	c->x   = x;
+	c->y   = y;
+	c->s   = s;
+	c->p   = GET_P();
+	c->pc  = pc;
+	ncyc   = cyc - c->cyc;
+	c->cyc = cyc;
+	return ncyc;
+
+#	undef RD
+#	undef WR
+#	undef DIRTY
+#	undef EVENT
+#	undef TAKEN
+#	undef IO_DONE
+#	undef FETCH8
+#	undef FETCH16
+#	undef RD16
+#	undef RD16ZP
+#	undef PUSH
+#	undef PULL
+#	undef PAGEX
+#	undef EA_IMM
+#	undef EA_ZP
+#	undef EA_ZPX
+#	undef EA_ZPY
+#	undef EA_ABS
+#	undef EA_ABSX
+#	undef EA_ABSY
+#	undef EA_INDX
+#	undef EA_INDY
+#	undef SETNZ
+#	undef SETC
+#	undef SETV
+#	undef IS_N
+#	undef IS_V
+#	undef IS_Z
+#	undef IS_C
+#	undef GET_P
+#	undef LAZY_F
+#	undef SET_P
+#	undef NEXT
+#	undef CALLED
+#	undef RETURNED
+#	undef LD
+#	undef ST
+#	undef ALU
+#	undef ADC
+#	undef SBC
+#	undef CMP
+#	undef BIT
+#	undef RMW
+#	undef BR
+#	undef DO_ASL
+#	undef DO_LSR
+#	undef DO_ROL
+#	undef DO_ROR
+}
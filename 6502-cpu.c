@@ -0,0 +1,389 @@
+//----------------------------------------------------------------------------- ----------------------------------------
+// NMOS 6502 interpreter core
+//
+// Dispatch is computed-goto (gcc/clang "labels as values") on the opcode byte.
+// Cycle counts come from op2i[].t :
+//   base  = t % 10
+//   [1]   : t >= 10  ->  +1 if the indexed address crosses a page
+//   [2]   : t >= 20  ->  +1 if the branch is taken, +1 more if it lands on a different page
+//
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "6502.h"
+#include "6502-cpu.h"
+#include "6502-bus.h"
+#include "6502-alu.h"
+#include "6502-trace.h"
+#include "6502-prof.h"
+
+//+============================================================================ ========================================
+cpu_t*  cpu_new (void)
+{
+	cpu_t*  c = calloc(1, sizeof(*c));
+
+	if (c)  c->p = FLG_X | FLG_I ;
+	return c;
+}
+
+//+============================================================================ ========================================
+void  cpu_free (cpu_t* c)
+{
+	if (c)  free(c->bc) ;
+	free(c);
+}
+
+//----------------------------------------------------------------------------- ----------------------------------------
+// Block cache
+//
+// A block is a run of pre-decoded instructions which ends after the first branch/jump/call/return, before an invalid
+// opcode, or at BC_INS instructions.  map[] finds the block that starts at any address.
+//
+// Every page has a generation number; a block remembers the generation of the (at most two) pages it was decoded
+// from, and is rebuilt when either has moved on.  code[] marks the pages that blocks have been built from, so a write
+// only has to bump the generation when it lands on one of those.
+//
+#define BC_INS   (32)
+#define BC_BLKS  (2048)     // When full, every block is dropped
+
+typedef
+	struct bc_ins {
+		const void*  h;             // Handler  (threaded dispatch)
+		uint16_t  oper;             // Operand  (byte or word)
+		uint16_t  next;             // Address of the following instruction
+		uint8_t   t;                // op2i[op].t
+		uint8_t   tb;               // Base Tcnt  (t % 10)
+	}
+bc_ins_t;
+
+typedef
+	struct bc_blk {
+		uint16_t  start;            // Address of the first instruction
+		uint8_t   n;                // Instructions  (0 -> invalid opcode at start)
+		uint8_t   pg[2];            // First & last page the bytes came from
+		uint32_t  gen[2];           // ...and their generations at the time
+		bc_ins_t  ins[BC_INS];
+	}
+bc_blk_t;
+
+typedef
+	struct bcache {
+		uint16_t  map[0x10000];     // Address -> block number + 1  (0 -> none)
+		uint8_t   code[256];        // !0 -> blocks have been decoded from this page
+		uint32_t  gen[256];         // Generation of each page
+		uint32_t  nblk;             // Blocks in use
+		bc_blk_t  blk[BC_BLKS];
+	}
+bcache_t;
+
+//+============================================================================ ========================================
+static inline  void  bc_smc (bcache_t* bc,  uint8_t pg)
+{
+	bc->gen[pg]++;
+	bc->code[pg] = 0;
+}
+
+//+============================================================================ ========================================
+void  cpu_invalidate (cpu_t* c,  uint16_t lo,  uint16_t hi)
+{
+	memset(&c->dirty[lo >> 8], DIRTY_ALL, (hi >> 8) - (lo >> 8) + 1);
+	if (!c->bc)  return ;
+	for (unsigned pg = lo >> 8;  pg <= (unsigned)(hi >> 8);  pg++)
+		if (c->bc->code[pg])  bc_smc(c->bc, pg) ;
+}
+
+//+============================================================================ ========================================
+static  const bc_blk_t*  bc_build (bcache_t* bc,  bc_blk_t* blk,  const uint8_t* m,  uint16_t pc,
+                                   const void* const* jt)
+{
+	uint16_t  ad   = pc;
+	uint16_t  last = pc;
+
+	blk->start = pc;
+	blk->n     = 0;
+
+	while (blk->n < BC_INS) {
+		uint8_t          op = m[ad];
+		const decode_t*  d  = &op2i[op];
+		bc_ins_t*        in = &blk->ins[blk->n++];
+
+		if (!d->len) {
+			blk->n--;
+			break;
+		}
+
+		in->h    = jt[op];
+		in->t    = d->t;
+		in->tb   = d->t % 10;
+		in->oper = (d->len < 2) ? 0 : m[(uint16_t)(ad + 1)] | ((d->len < 3) ? 0 : m[(uint16_t)(ad + 2)] << 8);
+
+		ad      += d->len;
+		last     = ad - 1;
+		in->next = ad;
+
+		if ((d->am == AM_REL) || (d->mnem == MN_JMP) || (d->mnem == MN_JSR) ||
+		    (d->mnem == MN_RTS) || (d->mnem == MN_RTI) || (d->mnem == MN_BRK))  break ;
+	}
+
+	blk->pg[0]  = pc   >> 8;
+	blk->pg[1]  = last >> 8;
+	blk->gen[0] = bc->gen[blk->pg[0]];
+	blk->gen[1] = bc->gen[blk->pg[1]];
+	bc->code[blk->pg[0]] = 1;
+	bc->code[blk->pg[1]] = 1;
+
+	return blk->n ? blk : NULL;
+}
+
+//+============================================================================ ========================================
+// The (current) block at pc, or NULL if pc is on an invalid opcode
+//   jt[] is the dispatch table of the core that will run it
+//
+static inline  const bc_blk_t*  bc_get (bcache_t* bc,  const uint8_t* m,  uint16_t pc,  const void* const* jt)
+{
+	bc_blk_t*  blk;
+
+	if (bc->map[pc]) {
+		blk = &bc->blk[bc->map[pc] - 1];
+		if ((blk->gen[0] == bc->gen[blk->pg[0]]) && (blk->gen[1] == bc->gen[blk->pg[1]]))
+			return blk->n ? blk : NULL ;
+
+	} else {
+		if (bc->nblk == BC_BLKS) {
+			memset(bc->map, 0, sizeof(bc->map));
+			bc->nblk = 0;
+		}
+		blk = &bc->blk[bc->nblk++];
+		bc->map[pc] = bc->nblk;
+	}
+
+	return bc_build(bc, blk, m, pc, jt);
+}
+
+//+============================================================================ ========================================
+// Host-side access  (through the bus if there is one)
+//
+static inline  uint8_t  rd8 (const cpu_t* c,  uint16_t ad)
+{
+	return c->bus ? bus_rd(c->bus, ad) : c->mem[ad] ;
+}
+
+static inline  void  wr8 (cpu_t* c,  uint16_t ad,  uint8_t v)
+{
+	if (c->bus)  bus_wr(c->bus, ad, v) ;
+	else         c->mem[ad] = v ;
+}
+
+static inline  uint16_t  rd16 (const cpu_t* c,  uint16_t ad)
+{
+	return rd8(c, ad) | (rd8(c, (uint16_t)(ad + 1)) << 8);
+}
+
+//+============================================================================ ========================================
+// Bus access for cpu_run_bus()
+//   *pt is the core's copy of the live page table - an I/O handler may bank switch, so it is refreshed after one
+//
+static inline  uint8_t  bus_rd_pt (const bus_t* b,  const bus_map_t** pt,  uint16_t ad)
+{
+	const uint8_t*  pg = (*pt)->rd[ad >> 8];
+	uint8_t         v;
+
+	if (__builtin_expect(pg != NULL, 1))  return pg[ad & 0xFF] ;
+	v   = bus_rd_io(b, ad);
+	*pt = b->map;
+	return v;
+}
+
+static inline  void  bus_wr_pt (const bus_t* b,  const bus_map_t** pt,  uint16_t ad,  uint8_t v)
+{
+	uint8_t*  pg = (*pt)->wr[ad >> 8];
+
+	if (__builtin_expect(pg != NULL, 1)) {
+		pg[ad & 0xFF] = v;
+		return;
+	}
+	bus_wr_io(b, ad, v);
+	*pt = b->map;
+}
+
+//+============================================================================ ========================================
+// Push PC & P, then load PC from a vector
+//
+static  void  interrupt (cpu_t* c,  uint16_t vec,  uint8_t brk)
+{
+	wr8(c, 0x100 | c->s--, c->pc >> 8);
+	wr8(c, 0x100 | c->s--, c->pc & 0xFF);
+	wr8(c, 0x100 | c->s--, c->p | FLG_X | brk);
+	cpu_invalidate(c, 0x0100, 0x01FF);
+	c->p  |= FLG_I;
+	c->pc  = rd16(c, vec);
+	c->cyc += 7;
+}
+
+//+============================================================================ ========================================
+void  cpu_reset (cpu_t* c)
+{
+	c->s   -= 3;                   // Reset runs the interrupt sequence with writes suppressed
+	c->p   |= FLG_X | FLG_I;
+	c->pc   = rd16(c, VEC_RST);
+	c->jam  = 0;
+	c->cyc += 7;
+}
+
+//+============================================================================ ========================================
+void  cpu_nmi (cpu_t* c)
+{
+	interrupt(c, VEC_NMI, 0);
+}
+
+//+============================================================================ ========================================
+void  cpu_irq (cpu_t* c)
+{
+	if (!(c->p & FLG_I))  interrupt(c, VEC_IRQ, 0) ;
+}
+
+//----------------------------------------------------------------------------- ----------------------------------------
+// The interpreter, built seven times
+//
+#define CPU_RUN    cpu_run
+#define CPU_LAZY   0
+#define CPU_BLOCK  0
+#define CPU_BUS    0
+#define CPU_TRACE  0
+#define CPU_PROF   0
+#include "6502-cpu-run.h"
+#undef  CPU_RUN
+#undef  CPU_LAZY
+#undef  CPU_BLOCK
+#undef  CPU_BUS
+#undef  CPU_TRACE
+#undef  CPU_PROF
+
+#define CPU_RUN    cpu_run_lazy
+#define CPU_LAZY   1
+#define CPU_BLOCK  0
+#define CPU_BUS    0
+#define CPU_TRACE  0
+#define CPU_PROF   0
+#include "6502-cpu-run.h"
+#undef  CPU_RUN
+#undef  CPU_LAZY
+#undef  CPU_BLOCK
+#undef  CPU_BUS
+#undef  CPU_TRACE
+#undef  CPU_PROF
+
+#define CPU_RUN    cpu_run_cached
+#define CPU_LAZY   1
+#define CPU_BLOCK  1
+#define CPU_BUS    0
+#define CPU_TRACE  0
+#define CPU_PROF   0
+#include "6502-cpu-run.h"
+#undef  CPU_RUN
+#undef  CPU_LAZY
+#undef  CPU_BLOCK
+#undef  CPU_BUS
+#undef  CPU_TRACE
+#undef  CPU_PROF
+
+#define CPU_RUN    cpu_run_bus
+#define CPU_LAZY   1
+#define CPU_BLOCK  0
+#define CPU_BUS    1
+#define CPU_TRACE  0
+#define CPU_PROF   0
+#include "6502-cpu-run.h"
+#undef  CPU_RUN
+#undef  CPU_LAZY
+#undef  CPU_BLOCK
+#undef  CPU_BUS
+#undef  CPU_TRACE
+#undef  CPU_PROF
+
+#define CPU_RUN    trace_run
+#define CPU_LAZY   0
+#define CPU_BLOCK  0
+#define CPU_BUS    0
+#define CPU_TRACE  1
+#define CPU_PROF   0
+#include "6502-cpu-run.h"
+#undef  CPU_RUN
+#undef  CPU_LAZY
+#undef  CPU_BLOCK
+#undef  CPU_BUS
+#undef  CPU_TRACE
+#undef  CPU_PROF
+
+#define CPU_RUN    trace_bus_run
+#define CPU_LAZY   1
+#define CPU_BLOCK  0
+#define CPU_BUS    1
+#define CPU_TRACE  1
+#define CPU_PROF   0
+#include "6502-cpu-run.h"
+#undef  CPU_RUN
+#undef  CPU_LAZY
+#undef  CPU_BLOCK
+#undef  CPU_BUS
+#undef  CPU_TRACE
+#undef  CPU_PROF
+
+//+============================================================================ ========================================
+// A span per TRACE_SPAN cycles at most, between a key & an end frame  (the core counts the instructions & writes the
+// events between them).  Every part is budgeted up to the same 'end', so the last stops where one cpu_run() would,
+// unless the core stopped early  (too many events, or the bus map switched) - then the next span carries on
+//
+uint64_t  cpu_run_trace (cpu_t* c,  uint64_t ncyc)
+{
+	uint64_t  end = c->cyc + ncyc;
+	uint64_t  n   = 0;
+
+	while (c->cyc < end) {
+		uint64_t  k = trace_key(c->trace, c);
+
+		k  = (end - c->cyc > k) ? k : end - c->cyc;
+		n += c->bus ? trace_bus_run(c, k) : trace_run(c, k);
+		trace_end(c->trace, c);
+		if (c->jam)  break ;
+	}
+	return n;
+}
+
+#define CPU_RUN    prof_run
+#define CPU_LAZY   0
+#define CPU_BLOCK  0
+#define CPU_BUS    0
+#define CPU_TRACE  0
+#define CPU_PROF   1
+#include "6502-cpu-run.h"
+#undef  CPU_RUN
+#undef  CPU_LAZY
+#undef  CPU_BLOCK
+#undef  CPU_BUS
+#undef  CPU_TRACE
+#undef  CPU_PROF
+
+//+============================================================================ ========================================
+// The core sees JSR & BRK, but not an interrupt the host took between runs  (cpu_irq(), cpu_nmi()) - that shows up
+// here as a PC that moved with the old one pushed, and opens its frame from the cycle the interrupt started on
+//
+uint64_t  cpu_run_prof (cpu_t* c,  uint64_t ncyc)
+{
+	prof_t*   pf = c->prof;
+	uint64_t  n;
+	uint16_t  ret = c->mem[0x100 | (uint8_t)(c->s + 2)] | (c->mem[0x100 | (uint8_t)(c->s + 3)] << 8);
+
+	if (!pf->seen)  pf->cyc0 = c->cyc ;
+	else if ((c->pc != pf->lpc) && (c->s == (uint8_t)(pf->ls - 3)) && (ret == pf->lpc))
+		prof_call(pf, c->pc, (c->pc == rd16(c, VEC_NMI)) ? PROF_NMI : PROF_IRQ, pf->ls, c->cyc - 7);
+
+	n = prof_run(c, ncyc);
+
+	pf->seen = 1;
+	pf->cyc1 = c->cyc;
+	pf->lpc  = c->pc;
+	pf->ls   = c->s;
+	return n;
+}
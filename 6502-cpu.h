@@ -0,0 +1,91 @@
+#ifndef  _6502_CPU_H_
+#define  _6502_CPU_H_
+
+//----------------------------------------------------------------------------- ----------------------------------------
+#include <stdint.h>
+
+#include "6502.h"
+
+//----------------------------------------------------------------------------- ----------------------------------------
+// Vectors
+//
+#define VEC_NMI  (0xFFFA)
+#define VEC_RST  (0xFFFC)
+#define VEC_IRQ  (0xFFFE)   // (and BRK)
+
+//----------------------------------------------------------------------------- ----------------------------------------
+// c->dirty[] : a bit per user.  Every write sets them all, each user clears only its own
+//
+#define DIRTY_SNAP   (0x01)     // Snapshots  (6502-snap.h)
+#define DIRTY_TRACE  (0x02)     // Trace key frames  (6502-trace.h)
+#define DIRTY_HOST   (0x04)     //   ...and not by cpu_run_trace()  (the only writer that does not set it)
+#define DIRTY_ALL    (0xFF)
+
+//----------------------------------------------------------------------------- ----------------------------------------
+// One NMOS 6502
+//
+// Everything the core touches lives in here, so any number of instances can run side-by-side (or on different threads)
+//
+typedef
+	struct cpu {
+		uint8_t   a, x, y;          // Registers
+		uint8_t   s;                // Stack pointer  (page 1)
+		uint8_t   p;                // Status  (flags_t)  - FLG_X always set, FLG_B never set
+		uint8_t   jam;              // !0 -> stopped on an invalid opcode  (pc points at it)
+		uint16_t  pc;               // Program counter
+		uint64_t  cyc;              // Cycles since power-on
+		struct bcache*  bc;         // Pre-decoded blocks for cpu_run_cached()  (allocated on first use)
+		struct bus*     bus;        // Page-table bus for cpu_run_bus()  (owned by the caller; NULL -> mem[])
+		struct trace*   trace;      // Recorder for cpu_run_trace()  (owned by the caller, 6502-trace.h)
+		struct prof*    prof;       // Profile for cpu_run_prof()  (owned by the caller, 6502-prof.h)
+		uint8_t   dirty[256];       // Per page :  DIRTY_* bits of the users that have not seen its last write
+		uint8_t   mem[0x10000];     // 64K bus
+	}
+cpu_t;
+
+//----------------------------------------------------------------------------- ----------------------------------------
+cpu_t*    cpu_new   (void) ;
+void      cpu_free  (cpu_t* c) ;
+
+void      cpu_reset (cpu_t* c) ;
+void      cpu_nmi   (cpu_t* c) ;
+void      cpu_irq   (cpu_t* c) ;
+
+// Identical results, different strategy :
+//   cpu_run()        : P is kept up to date by every instruction
+//   cpu_run_lazy()   : N/Z/C/V are derived from the last result & operands only when read
+//   cpu_run_cached() : lazy flags, and instructions are decoded once into basic blocks which are then replayed
+//                      the cycle budget is only checked between blocks, so it may overrun by one block
+//   cpu_run_bus()    : lazy flags, and every access goes through c->bus  (RAM/ROM pages direct, I/O pages to handlers)
+//                      the other cores only ever see c->mem
+//   cpu_run_trace()  : as cpu_run()  (cpu_run_bus() with c->bus), recorded to c->trace  (must be set) - the state at
+//                      either end of the run, extra cycles & I/O reads, from which replay runs every instruction again
+//                      (6502-trace.h)
+//   cpu_run_prof()   : as cpu_run(), and every instruction's cycles are added to c->prof  (must be set)
+uint64_t  cpu_run        (cpu_t* c,  uint64_t ncyc) ;
+uint64_t  cpu_run_lazy   (cpu_t* c,  uint64_t ncyc) ;
+uint64_t  cpu_run_cached (cpu_t* c,  uint64_t ncyc) ;
+uint64_t  cpu_run_bus    (cpu_t* c,  uint64_t ncyc) ;
+uint64_t  cpu_run_trace  (cpu_t* c,  uint64_t ncyc) ;
+uint64_t  cpu_run_prof   (cpu_t* c,  uint64_t ncyc) ;
+
+// The host changed c->mem[lo..hi] - mark the pages dirty & drop any cached blocks that were decoded from it
+//   (the CPU's own writes are tracked by the cores)
+void      cpu_invalidate (cpu_t* c,  uint16_t lo,  uint16_t hi) ;
+
+//+============================================================================ ========================================
+// Is the CPU sat on an instruction that jumps to itself?  ("JMP *", or "Bxx *" - taken or not, the caller stops)
+//   the operand bytes wrap at 64K, as the CPU reads them
+//
+static inline  int  cpu_trapped (const cpu_t* c)
+{
+	uint8_t  op = c->mem[c->pc];
+	uint8_t  b1 = c->mem[(uint16_t)(c->pc + 1)];
+	uint8_t  b2 = c->mem[(uint16_t)(c->pc + 2)];
+
+	if ((op == OP_JMP_ABS) && ((b1 | b2 << 8) == c->pc))  return 1 ;
+	if ((op2i[op].am == AM_REL) && (b1 == 0xFE))          return 1 ;
+	return 0;
+}
+
+#endif //_6502_CPU_H_
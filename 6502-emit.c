@@ -0,0 +1,254 @@
+//----------------------------------------------------------------------------- ----------------------------------------
+// Opcode table emitter  (see 6502-emit.h)
+//
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+
+#include <unistd.h>
+
+#include "6502.h"
+#include "6502-emit.h"
+
+// Largest output of one cell  (with slack)  &  of everything else, per format
+static const size_t  emit_cell_max [EMIT_MAX] = { [EMIT_HTML] = 640,   [EMIT_JSON] = 192,  [EMIT_CSV] = 64,   [EMIT_HDR] = 64   };
+static const size_t  emit_fixed_max[EMIT_MAX] = { [EMIT_HTML] = 16384, [EMIT_JSON] = 256,  [EMIT_CSV] = 128,  [EMIT_HDR] = 1024 };
+
+//+============================================================================ ========================================
+// strput() of a literal, its length known at compile time
+//
+#define PUT(s, lit)  put((s), (lit), sizeof(lit) - 1)
+
+static inline  char*  put (char* s,  const char* src,  size_t n)
+{
+	memcpy(s, src, n);
+	return s + n;
+}
+
+//+============================================================================ ========================================
+static inline  char*  dec (char* s,  unsigned v)
+{
+	if (v >= 100)  *s++ = '0' + v / 100 ;
+	if (v >= 10)   *s++ = '0' + v / 10 % 10 ;
+	*s++ = '0' + v % 10;
+	return s;
+}
+
+//+============================================================================ ========================================
+// The flag string : bits 7..0, upper case when set in m
+//
+static inline  void  flags (char* s,  uint8_t m)
+{
+	for (int j = 7;  j >= 0;  j--)  *s++ = (m & (1 << j)) ? "CZIDB-VN"[j] : "czidb-vn"[j] ;
+	*s = '\0';
+}
+
+//+============================================================================ ========================================
+int  emit_cell (const decode_t* tab,  uint8_t op,  emit_cell_t* c)
+{
+	const decode_t*  d = &tab[op];
+
+	c->d  = *d;
+	c->op = op;
+	if (!d->len)  return 0 ;
+
+	memcpy(c->mnem, mnem[d->mnem], 4);
+	if (MN_HASBIT(d->mnem))  c->mnem[3] = '0' + ((op >> 4) & 7),  c->mnem[4] = '\0' ;
+
+	c->cyc = d->t % 10;
+	memcpy(c->pen, &"\0\0\0+\0\0++\0"[(d->t / 10) * 3], 3);
+	c->am  = amode[d->am];
+	flags(c->flg, d->flg[0] | d->flg[1] | d->flg[2]);
+	flags(c->rd , d->rd);
+	return d->len;
+}
+
+//----------------------------------------------------------------------------- ----------------------------------------
+// HTML
+//
+//+============================================================================ ========================================
+// Column headings  (top : 5% wide, bottom : 7%)
+//
+static  char*  html_cols (char* s,  const char* w)
+{
+	s = PUT(s, "      <tr align=\"center\">\n");
+	s = PUT(strput(PUT(s, "        <th width=\""), w), "%\">&nbsp;</th>\n");
+	for (int i = 0;  i < 16;  i++) {
+		s    = PUT(strput(PUT(s, "        <th width=\""), w), "%\"><big><big>&#8209;</big></big>");
+		*s++ = hexdig[i];
+		s    = PUT(s, "</th>\n");
+	}
+	s = PUT(strput(PUT(s, "        <th width=\""), w), "%\">&nbsp;</th>\n");
+	return PUT(s, "      </tr>\n");
+}
+
+//+============================================================================ ========================================
+static  char*  html_row (char* s,  int r)
+{
+	s    = PUT(s, "        <th align=\"center\">&nbsp;");
+	*s++ = hexdig[r];
+	return PUT(s, "<big><big>&#8209;</big></big>&nbsp;</th>\n");
+}
+
+//+============================================================================ ========================================
+static  char*  html_cell (char* s,  const emit_cell_t* c)
+{
+	if (!c->d.len)  return PUT(s, "        <td>&nbsp;</td>\n") ;
+
+	s    = PUT(s, "        <td><table summary=\"\" align=\"center\" border=\"0\">\n");
+	s    = PUT(s, "          <tr><td align=\"left\"><small><b>           ");
+	s    = dec(s, c->d.len);
+	s    = PUT(s, "       </b></small></td>\n");
+	s    = PUT(s, "              <td align=\"right\"><small><b>          ");
+	s    = dec(s, c->cyc);
+	*s++ = c->pen[0] ? c->pen[0] : ' ';
+	*s++ = c->pen[1] ? c->pen[1] : ' ';
+	s    = PUT(s, "    </b></small></td></tr>\n");
+	s    = strput(PUT(strput(PUT(s, "          <tr><th colspan=\"2\">       <a href=\"#"), c->mnem), "\">"), c->mnem);
+	s    = PUT(s, "     </a></th></tr>\n");
+	s    = PUT(strput(PUT(s, "          <tr><td align=\"center\" colspan=\"2\"><small>"), c->am), "</small></td></tr>\n");
+
+	// Flags : bits 7..1, as the table has always shown them
+	s    = PUT(s, "          <tr><td align=\"center\" colspan=\"2\"><small>[");
+	for (int k = 0;  k < 7;  k++)
+		if (k == 2)  s = PUT(s, "&#8209;") ;
+		else         *s++ = c->flg[k] ;
+	return PUT(s, "]        </table></td>\n");
+}
+
+//+============================================================================ ========================================
+static  char*  html_end (char* s)
+{
+	s = html_cols(s, "7");
+	s = PUT(s, "    </table>\n");
+	s = PUT(s, "\n");
+	s = PUT(s, "    <table summary=\"\" border=\"0\" cellpadding=\"0\" width=\"100%\">\n");
+	s = PUT(s, "      <tr><td align=\"right\">autogenerated from \n");
+	s = PUT(s, "        <a href=\"https://www.masswerk.at/6502/6502_instruction_set.html\" target=\"extern6502\">6502 Instruction Set</a>\n");
+	s = PUT(s, "        by <a href=\"https://masswerk.at/\" target=\"extern6502\">mass:werk</a>\n");
+	s = PUT(s, "      </td></tr>\n");
+	return PUT(s, "    </table>\n");
+}
+
+//----------------------------------------------------------------------------- ----------------------------------------
+// JSON, CSV & C header
+//
+//+============================================================================ ========================================
+static  char*  json_cell (char* s,  const emit_cell_t* c)
+{
+	s = strput(s, c->op ? ",\n  " : "\n  ");
+	if (!c->d.len)  return PUT(s, "null") ;
+
+	s = dec(PUT(s, "{\"op\": "), c->op);
+	s = PUT(strput(PUT(s, ", \"mnem\": \""), c->mnem), "\"");
+	s = PUT(strput(PUT(s, ", \"mode\": \""), c->am), "\"");
+	s = dec(PUT(s, ", \"len\": "), c->d.len);
+	s = dec(PUT(s, ", \"cycles\": "), c->cyc);
+	s = PUT(strput(PUT(s, ", \"penalty\": \""), c->pen), "\"");
+	s = PUT(strput(PUT(s, ", \"flags\": \""), c->flg), "\"");
+	s = PUT(strput(PUT(s, ", \"reads\": \""), c->rd), "\"}");
+	return s;
+}
+
+//+============================================================================ ========================================
+static  char*  csv_cell (char* s,  const emit_cell_t* c)
+{
+	if (!c->d.len)  return s ;
+
+	s    = PUT(s, "0x");
+	s    = hex2(s, c->op);
+	s    = PUT(strput(PUT(s, ","), c->mnem), ",\"");   // (modes have commas)
+	s    = PUT(strput(s, c->am), "\",");
+	s    = dec(s, c->d.len);
+	*s++ = ',';
+	s    = dec(s, c->cyc);
+	s    = PUT(strput(PUT(s, ","), c->pen), ",");
+	s    = strput(PUT(strput(s, c->flg), ","), c->rd);
+	*s++ = '\n';
+	return s;
+}
+
+//+============================================================================ ========================================
+static  char*  hdr_cell (char* s,  const emit_cell_t* c)
+{
+	const decode_t*  d = &c->d;
+
+	s = PUT(s, "\t0x");
+	s = hex4(s, d->rd     << 8 | d->flg[2]);
+	s = hex4(s, d->flg[1] << 8 | d->flg[0]);
+	s = hex4(s, d->t      << 8 | d->len   );
+	s = hex4(s, d->am     << 8 | d->mnem  );
+	s = PUT(s, ",   // ");
+	s = hex2(s, c->op);
+	if (c->d.len)  s = PUT(strput(PUT(s, "  "), c->mnem), "  "),  s = strput(s, c->am) ;
+	*s++ = '\n';
+	return s;
+}
+
+//+============================================================================ ========================================
+static  int  flush (int fd,  const char* p,  const char* end)
+{
+	while (p < end) {
+		ssize_t  n = write(fd, p, end - p);
+		if (n <= 0)  return -1 ;
+		p += n;
+	}
+	return 0;
+}
+
+//+============================================================================ ========================================
+int  emit_table (cpu_var_t var,  const int fd[EMIT_MAX])
+{
+	const decode_t*  tab = op2i_var[var];
+	const char*      cpu = var_name[var];
+	char*            buf[EMIT_MAX] = {NULL};
+	char*            s  [EMIT_MAX];
+	int              rv = 0;
+
+	for (int f = 0;  f < EMIT_MAX;  f++) {
+		if (fd[f] < 0)  continue ;
+		if (!(buf[f] = malloc(emit_fixed_max[f] + 256 * emit_cell_max[f])))  {  rv = -1;  goto done;  }
+		s[f] = buf[f];
+	}
+
+	if (buf[EMIT_HTML]) {
+		s[EMIT_HTML] = PUT(s[EMIT_HTML], "    <table summary=\"\" border=\"1\" cellpadding=\"0\" width=\"100%\">\n");
+		s[EMIT_HTML] = html_cols(s[EMIT_HTML], "5");
+	}
+	if (buf[EMIT_JSON])  s[EMIT_JSON] = PUT(strput(PUT(s[EMIT_JSON], "{\"cpu\": \""), cpu), "\", \"ops\": [") ;
+	if (buf[EMIT_CSV ])  s[EMIT_CSV ] = PUT(s[EMIT_CSV], "op,mnem,mode,len,cycles,penalty,flags,reads\n") ;
+	if (buf[EMIT_HDR ]) {
+		s[EMIT_HDR] = PUT(strput(PUT(s[EMIT_HDR], "// Generated by ./table -g  :  "), cpu), " decode table\n");
+		s[EMIT_HDR] = PUT(s[EMIT_HDR], "// decode_t packed little-endian :  mnem | am << 8 | len << 16 | t << 24 | flg[0..2] << 32.. | rd << 56\n");
+		s[EMIT_HDR] = PUT(strput(PUT(s[EMIT_HDR], "\n#ifndef  _OP2I_PACKED_"), cpu), "_H_\n");
+		s[EMIT_HDR] = PUT(strput(PUT(s[EMIT_HDR], "#define  _OP2I_PACKED_"), cpu), "_H_\n\n#include <stdint.h>\n");
+		s[EMIT_HDR] = PUT(strput(PUT(s[EMIT_HDR], "\nstatic const uint64_t  op2i_packed_"), cpu), "[256] = {\n");
+	}
+
+	// The one walk
+	for (int op = 0;  op <= 0xFF;  op++) {
+		emit_cell_t  c;
+
+		emit_cell(tab, op, &c);
+		if (buf[EMIT_HTML]) {
+			if (!(op & 0xF))  s[EMIT_HTML] = html_row(PUT(s[EMIT_HTML], "\n      <tr>\n"), op >> 4) ;
+			s[EMIT_HTML] = html_cell(s[EMIT_HTML], &c);
+			if ((op & 0xF) == 0xF)  s[EMIT_HTML] = PUT(html_row(s[EMIT_HTML], op >> 4), "      </tr>\n") ;
+		}
+		if (buf[EMIT_JSON])  s[EMIT_JSON] = json_cell(s[EMIT_JSON], &c) ;
+		if (buf[EMIT_CSV ])  s[EMIT_CSV ] = csv_cell (s[EMIT_CSV ], &c) ;
+		if (buf[EMIT_HDR ])  s[EMIT_HDR ] = hdr_cell (s[EMIT_HDR ], &c) ;
+	}
+
+	if (buf[EMIT_HTML])  s[EMIT_HTML] = html_end(s[EMIT_HTML]) ;
+	if (buf[EMIT_JSON])  s[EMIT_JSON] = PUT(s[EMIT_JSON], "\n]}\n") ;
+	if (buf[EMIT_HDR ])  s[EMIT_HDR ] = PUT(s[EMIT_HDR], "};\n\n#endif\n") ;
+
+	for (int f = 0;  f < EMIT_MAX;  f++)
+		if (buf[f] && (flush(fd[f], buf[f], s[f]) < 0))  rv = -1 ;
+
+done:
+	for (int f = 0;  f < EMIT_MAX;  f++)  free(buf[f]) ;
+	return rv;
+}
@@ -0,0 +1,50 @@
+#ifndef  _6502_EMIT_H_
+#define  _6502_EMIT_H_
+
+//----------------------------------------------------------------------------- ----------------------------------------
+#include <stdint.h>
+
+#include "6502.h"
+
+//----------------------------------------------------------------------------- ----------------------------------------
+// Opcode table emitter
+//
+// One walk of a decode table;  each opcode is formatted once into an emit_cell_t, which every output then copies from.
+// Each output is built in its own buffer, sized up front for 256 of its largest cell, and written with one write().
+//
+//   HTML     : the opcode matrix  (./table)
+//   JSON     : {"cpu": "6502", "ops": [ {...} or null, x256 ]}
+//   CSV      : op,mnem,mode,len,cycles,penalty,flags,reads   - a line per valid opcode
+//   C header : the decode_t of every opcode packed into a uint64_t  (mnem in bits 0-7 ... rd in bits 56-63)
+//
+typedef
+	enum emit_fmt {
+		EMIT_HTML,
+		EMIT_JSON,
+		EMIT_CSV,
+		EMIT_HDR,
+		EMIT_MAX   // Must be last
+	}
+emit_fmt_t;
+
+typedef
+	struct emit_cell {
+		decode_t     d;
+		uint8_t      op;
+		uint8_t      cyc;          // Base cycles
+		char         pen[3];       // Footnotes : ""  "+" (page crossed)  "++" (branch)
+		char         mnem[6];      // With the bit number of RMBn/SMBn/BBRn/BBSn
+		const char*  am;           // amode[] name
+		char         flg[9];       // Bits 7..0  "NV-BDIZC" : upper case -> changed
+		char         rd[9];        // ... upper case -> read
+	}
+emit_cell_t;
+
+//----------------------------------------------------------------------------- ----------------------------------------
+// Format opcode 'op'  -> its length  (0 -> not an instruction;  only op & d are set)
+int  emit_cell  (const decode_t* tab,  uint8_t op,  emit_cell_t* c) ;
+
+// Write the table for a CPU variant to each fd[fmt] that is >= 0    -> 0, or -1 (errno)
+int  emit_table (cpu_var_t var,  const int fd[EMIT_MAX]) ;
+
+#endif //_6502_EMIT_H_
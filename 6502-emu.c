@@ -0,0 +1,445 @@
+// gcc  6502-emu.c  6502-cpu.c  6502-bus.c  6502-snap.c  6502-batch.c  6502-trace.c  6502-prof.c  6502-op2i.c  -o emu  -O2  -pthread
+//   ./emu file.bin org [pc]  : load at org (hex) & run from pc (default: reset vector)
+//                              until an invalid opcode or a "JMP *" / branch-to-self trap
+//   ./emu -b                 : built-in workloads, emulated MHz for each core  (eager, lazy, cached & bus)
+//                              aggregate MHz of a lockstep batch of instances vs the same run one by one
+//                              bank switches per second through the page-table bus
+//                              checkpoint restores per second, dirty pages vs a full copy
+//                              and the cost of recording a trace or a profile
+//   ./emu -l ...             : run with lazy flag evaluation
+//   ./emu -c ...             : run from the pre-decoded block cache
+//   ./emu -m ...             : run through the page-table bus  (all RAM)
+//   ./emu -t out.trc ...     : record a binary trace of every instruction  (see ./replay)
+//   ./emu -p out.folded ...  : profile : hottest blocks & the call tree to stdout, folded stacks to the file
+//                              (flamegraph.pl out.folded > out.svg)
+
+//----------------------------------------------------------------------------- ----------------------------------------
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "6502.h"
+#include "6502-cpu.h"
+#include "6502-bus.h"
+#include "6502-snap.h"
+#include "6502-batch.h"
+#include "6502-trace.h"
+#include "6502-prof.h"
+#include "6502-work.h"
+
+#define SLICE  (1000000)   // Cycles per cpu_run() call
+
+//----------------------------------------------------------------------------- ----------------------------------------
+// Bank switching : $DF00 selects which of 8 banks is seen at $8000-$BFFF, every pass of the loop
+static const uint8_t  bench_bank[] = {
+	0xA2, 0x00,             // C000  LDX #$00
+	0x8E, 0x00, 0xDF,       // C002  STX $DF00        <- I/O page : bank register
+	0xAD, 0x00, 0x80,       // C005  LDA $8000        <- banked
+	0x85, 0x10,             // C008  STA $10
+	0xE8,                   // C00A  INX
+	0x4C, 0x02, 0xC0,       // C00B  JMP $C002
+};
+
+#define NBANK  (8)
+
+typedef  uint64_t (*run_t)(cpu_t*, uint64_t);
+
+static const struct {
+	const char*     name;
+	const uint8_t*  prg;
+	size_t          sz;
+}
+work[] = {
+	{"mixed", bench_mix, sizeof(bench_mix)},
+	{"alu"  , bench_alu, sizeof(bench_alu)},
+	{"bcd"  , bench_bcd, sizeof(bench_bcd)},
+};
+
+static const struct {
+	const char*  name;
+	run_t        run;
+}
+core[] = {
+	{"eager" , cpu_run       },
+	{"lazy"  , cpu_run_lazy  },
+	{"cached", cpu_run_cached},
+	{"bus"   , cpu_run_bus   },
+};
+
+#define NCORE  (sizeof(core) / sizeof(*core))
+
+//+============================================================================ ========================================
+static  double  now (void)
+{
+	struct timespec  ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+//+============================================================================ ========================================
+static  void  regs (const cpu_t* c)
+{
+	printf("PC=%04X A=%02X X=%02X Y=%02X S=%02X P=", c->pc, c->a, c->x, c->y, c->s);
+	for (int j = 7;  j >= 0;  j--)  putchar((c->p & (1 << j)) ? "CZIDB-VN"[j] : "czidb-vn"[j]) ;
+	printf("  cyc=%llu%s\n", (unsigned long long)c->cyc, c->jam ? "  [JAM]" : "");
+}
+
+//+============================================================================ ========================================
+// All 64K as plain RAM over c->mem
+//
+static  void  bus_flat (cpu_t* c,  bus_t* b,  bus_map_t* map)
+{
+	bus_init(b, map);
+	bus_map_ram(map, 0x00, 256, c->mem);
+	c->bus = b;
+}
+
+//+============================================================================ ========================================
+static  double  bench1 (const uint8_t* prg,  size_t sz,  run_t run)
+{
+	cpu_t*     c = cpu_new();
+	uint64_t   n = 0;
+	double     t0, t;
+	bus_t      b;
+	bus_map_t  map;
+
+	bus_flat(c, &b, &map);                       // (only cpu_run_bus uses it)
+	memcpy(&c->mem[0xC000], prg, sz);
+	c->mem[VEC_RST] = 0x00;
+	c->mem[VEC_RST + 1] = 0xC0;
+	cpu_reset(c);
+
+	t0 = now();
+	do {
+		n += run(c, 100 * SLICE);
+	} while ((t = now() - t0) < 1.0) ;
+
+	cpu_free(c);
+	return n / t / 1e6;
+}
+
+//+============================================================================ ========================================
+// Bank switch benchmark
+//
+typedef
+	struct bank {
+		bus_t*      b;
+		bus_map_t   map[NBANK];             // One page table per bank
+		uint8_t     sel;
+		uint64_t    nsw;                    // Switches
+		uint8_t     ram[NBANK][0x4000];
+	}
+bank_t;
+
+static  uint8_t  bank_rd (void* ctx,  uint16_t ad)
+{
+	(void)ad;
+	return ((bank_t*)ctx)->sel;
+}
+
+static  void  bank_wr (void* ctx,  uint16_t ad,  uint8_t v)
+{
+	bank_t*  k = ctx;
+
+	(void)ad;
+	k->sel = v % NBANK;
+	k->nsw++;
+	bus_switch(k->b, &k->map[k->sel]);
+}
+
+//+============================================================================ ========================================
+static  void  bench_banks (void)
+{
+	cpu_t*    c = cpu_new();
+	bank_t*   k = calloc(1, sizeof(*k));
+	bus_t     b;
+	uint64_t  n = 0;
+	double    t0, t;
+	int       h;
+
+	memcpy(&c->mem[0xC000], bench_bank, sizeof(bench_bank));
+	c->mem[VEC_RST] = 0x00;
+	c->mem[VEC_RST + 1] = 0xC0;
+
+	bus_init(&b, &k->map[0]);
+	h    = bus_handler(&b, bank_rd, bank_wr, k);
+	k->b = &b;
+	for (int i = 0;  i < NBANK;  i++) {
+		bus_map_ram(&k->map[i], 0x00, 0x80, c->mem);                   // $0000-$7FFF : RAM
+		bus_map_ram(&k->map[i], 0x80, 0x40, k->ram[i]);                // $8000-$BFFF : bank i
+		bus_map_rom(&k->map[i], 0xC0, 0x40, &c->mem[0xC000], &b);      // $C000-$FFFF : ROM
+		bus_map_io (&k->map[i], 0xDF, 0x01, h);                        // $DF00-$DFFF : bank register
+		k->ram[i][0] = i;
+	}
+	c->bus = &b;
+	cpu_reset(c);
+
+	t0 = now();
+	do {
+		n += cpu_run_bus(c, 100 * SLICE);
+	} while ((t = now() - t0) < 1.0) ;
+
+	printf("banked bus    : %7.1f emulated MHz, %.1fM bank switches/s\n", n / t / 1e6, k->nsw / t / 1e6);
+
+	free(k);
+	cpu_free(c);
+}
+
+//+============================================================================ ========================================
+// Restore benchmark : run a short burst from a checkpoint, put it back, repeat
+//
+#define RUN_CYC  (2000)     // Cycles per burst
+
+static  void  bench_snap (void)
+{
+	cpu_t*    c    = cpu_new();
+	cpu_t*    base = cpu_new();
+	snap_t*   sn;
+	uint64_t  n;
+	double    t0, t;
+
+	memcpy(&c->mem[0xC000], bench_mix, sizeof(bench_mix));
+	c->mem[VEC_RST] = 0x00;
+	c->mem[VEC_RST + 1] = 0xC0;
+	cpu_reset(c);
+	sn = snap_new(c);
+
+	// Full copy of the machine
+	memcpy(base, c, sizeof(*c));
+	t0 = now();
+	for (n = 0;  (n & 0xFF) || ((t = now() - t0) < 1.0);  n++) {
+		cpu_run_lazy(c, RUN_CYC);
+		memcpy(c, base, sizeof(*c));
+	}
+	printf("restore copy  : %7.2fM restores/s\n", n / t / 1e6);
+
+	// Dirty pages only
+	t0 = now();
+	for (n = 0;  (n & 0xFF) || ((t = now() - t0) < 1.0);  n++) {
+		cpu_run_lazy(c, RUN_CYC);
+		snap_restore(sn);
+	}
+	printf("restore snap  : %7.2fM restores/s\n", n / t / 1e6);
+
+	snap_free(sn);
+	cpu_free(base);
+	cpu_free(c);
+}
+
+//+============================================================================ ========================================
+// Lockstep batch vs the same instances one after another on the lazy core  (each instance has its own data at $10-$12)
+// A first slice of equal budget on both checks the batch against the lazy core  (registers, cycles & memory)
+//
+#define NBATCH  (256)
+
+static  void  bench_batch (const char* name,  const uint8_t* prg,  size_t sz)
+{
+	batch_t*  b = batch_new(NBATCH);
+	cpu_t*    c[NBATCH];
+	cpu_t*    k = cpu_new();
+	uint64_t  n;
+	double    t0, t, mhz;
+	int       bad = 0;
+
+	for (int i = 0;  i < NBATCH;  i++) {
+		c[i] = cpu_new();
+		memcpy(&c[i]->mem[0xC000], prg, sz);
+		c[i]->mem[VEC_RST]     = 0x00;
+		c[i]->mem[VEC_RST + 1] = 0xC0;
+		c[i]->mem[0x10]        = i;
+		c[i]->mem[0x11]        = i * 7;
+		c[i]->mem[0x12]        = i ^ 0x5A;
+		cpu_reset(c[i]);
+		batch_put(b, i, c[i]);
+	}
+
+	batch_run(b, SLICE / 10);
+	for (int i = 0;  i < NBATCH;  i++) {
+		cpu_run_lazy(c[i], SLICE / 10);
+		batch_get(b, i, k);
+		if ((k->a != c[i]->a) || (k->x != c[i]->x) || (k->y != c[i]->y) || (k->s != c[i]->s) || (k->p != c[i]->p)
+		 || (k->pc != c[i]->pc) || (k->cyc != c[i]->cyc) || (k->jam != c[i]->jam) || memcmp(k->mem, c[i]->mem, 0x10000))  bad++ ;
+	}
+
+	t0 = now();
+	n  = 0;
+	do {
+		for (int i = 0;  i < NBATCH;  i++)  n += cpu_run_lazy(c[i], SLICE / 10) ;
+	} while ((t = now() - t0) < 1.0) ;
+	mhz = n / t / 1e6;
+
+	t0 = now();
+	n  = 0;
+	do {
+		n += batch_run(b, SLICE / 10);
+	} while ((t = now() - t0) < 1.0) ;
+
+	printf("%-6s batch  : %7.1f emulated MHz total, %d instances  (%.2fx lazy)  %s\n", name, n / t / 1e6, NBATCH,
+	       n / t / 1e6 / mhz, bad ? "MISMATCH" : "ok");
+
+	for (int i = 0;  i < NBATCH;  i++)  cpu_free(c[i]) ;
+	cpu_free(k);
+	batch_free(b);
+}
+
+//+============================================================================ ========================================
+// Trace recording : cpu_run_trace() to a scratch file vs cpu_run()
+//
+#define BENCH_TRC  "emu-bench.trc"
+
+static  void  bench_trace (const char* name,  const uint8_t* prg,  size_t sz)
+{
+	trace_t*  tr;
+	double    mhz = bench1(prg, sz, cpu_run), t0, t;
+	cpu_t*    c   = cpu_new();
+	uint64_t  n   = 0;
+	long      fsz = 0;
+	FILE*     fh;
+
+	if (!(tr = trace_open(BENCH_TRC)))  {  perror(BENCH_TRC);  cpu_free(c);  return;  }
+	memcpy(&c->mem[0xC000], prg, sz);
+	c->mem[VEC_RST] = 0x00;
+	c->mem[VEC_RST + 1] = 0xC0;
+	cpu_reset(c);
+	c->trace = tr;
+
+	t0 = now();
+	do {
+		n += cpu_run_trace(c, SLICE);
+	} while ((t = now() - t0) < 1.0) ;
+	if (trace_close(tr))  perror(BENCH_TRC) ;
+	t = now() - t0;                                         // (including draining the writer)
+	if ((fh = fopen(BENCH_TRC, "rb")))  fseek(fh, 0, SEEK_END),  fsz = ftell(fh),  fclose(fh) ;
+	remove(BENCH_TRC);
+
+	printf("%-6s trace  : %7.1f emulated MHz  (%.2fx eager), %.1f KB/s to disk\n",
+	       name, n / t / 1e6, n / t / 1e6 / mhz, fsz / t / 1e3);
+	cpu_free(c);
+}
+
+//+============================================================================ ========================================
+// Profiling core vs the eager core it is built from
+//
+static  void  bench_prof (const char* name,  const uint8_t* prg,  size_t sz)
+{
+	double   mhz = bench1(prg, sz, cpu_run);
+	prof_t*  pf  = prof_new();
+	cpu_t*   c   = cpu_new();
+	uint64_t n   = 0;
+	double   t0, t;
+
+	if (!pf || !c)  {  perror("prof");  prof_free(pf);  cpu_free(c);  return;  }
+	memcpy(&c->mem[0xC000], prg, sz);
+	c->mem[VEC_RST] = 0x00;
+	c->mem[VEC_RST + 1] = 0xC0;
+	cpu_reset(c);
+	c->prof = pf;
+
+	t0 = now();
+	do {
+		n += cpu_run_prof(c, SLICE);
+	} while ((t = now() - t0) < 1.0) ;
+
+	printf("%-6s prof   : %7.1f emulated MHz  (%.2fx eager), %u call paths\n", name, n / t / 1e6, n / t / 1e6 / mhz, pf->nnode);
+	prof_free(pf);
+	cpu_free(c);
+}
+
+//+============================================================================ ========================================
+static  int  bench (void)
+{
+	for (size_t w = 0;  w < sizeof(work) / sizeof(*work);  w++) {
+		double  mhz[NCORE];
+
+		for (size_t k = 0;  k < NCORE;  k++) {
+			mhz[k] = bench1(work[w].prg, work[w].sz, core[k].run);
+			printf("%-6s %-6s : %7.1f emulated MHz\n", work[w].name, core[k].name, mhz[k]);
+		}
+		for (size_t k = 1;  k < NCORE;  k++)
+			printf("%-6s %s/eager : %.2fx\n", work[w].name, core[k].name, mhz[k] / mhz[0]);
+	}
+	for (size_t w = 0;  w < sizeof(work) / sizeof(*work);  w++)  bench_batch(work[w].name, work[w].prg, work[w].sz) ;
+	bench_banks();
+	bench_snap();
+	for (size_t w = 0;  w < sizeof(work) / sizeof(*work);  w++)  bench_trace(work[w].name, work[w].prg, work[w].sz) ;
+	for (size_t w = 0;  w < sizeof(work) / sizeof(*work);  w++)  bench_prof(work[w].name, work[w].prg, work[w].sz) ;
+	return 0;
+}
+
+//+============================================================================ ========================================
+int  main (int argc,  char* argv[])
+{
+	cpu_t*    c;
+	FILE*     fh;
+	uint16_t  org;
+	size_t    sz;
+	uint64_t  n = 0;
+	double    t0, t;
+	int       rv;
+	run_t     run = cpu_run;
+	char*     me  = argv[0];
+	bus_t     b;
+	bus_map_t map;
+	trace_t*  tr  = NULL;
+	prof_t*   pf  = NULL;
+	char*     fold = NULL;
+
+	if ((argc == 2) && !strcmp(argv[1], "-b"))  return bench() ;
+	if ((argc >= 2) && !strcmp(argv[1], "-l"))  run = cpu_run_lazy, argc--, argv++ ;
+	else if ((argc >= 2) && !strcmp(argv[1], "-c"))  run = cpu_run_cached, argc--, argv++ ;
+	else if ((argc >= 2) && !strcmp(argv[1], "-m"))  run = cpu_run_bus, argc--, argv++ ;
+	else if ((argc >= 3) && !strcmp(argv[1], "-t")) {
+		if (!(tr = trace_open(argv[2])))  return perror(argv[2]), 1 ;
+		run   = cpu_run_trace;
+		argc -= 2;
+		argv += 2;
+	}
+	else if ((argc >= 3) && !strcmp(argv[1], "-p")) {
+		if (!(pf = prof_new()))  return perror("prof"), 1 ;
+		fold  = argv[2];
+		run   = cpu_run_prof;
+		argc -= 2;
+		argv += 2;
+	}
+
+	if (argc < 3) {
+		fprintf(stderr, "use: %s [-l|-c|-m|-t out.trc|-p out.folded] file.bin org [pc]  |  %s -b\n", me, me);
+		return 1;
+	}
+
+	if (!(c = cpu_new()))                   return perror("cpu_new"), 1 ;
+	if (run == cpu_run_bus)  bus_flat(c, &b, &map) ;
+	c->trace = tr;
+	c->prof  = pf;
+	if (!(fh = fopen(argv[1], "rb")))       return perror(argv[1]), 1 ;
+	org = strtoul(argv[2], NULL, 16);
+	sz  = fread(&c->mem[org], 1, 0x10000 - org, fh);
+	fclose(fh);
+	printf("Loaded %zu bytes at $%04X\n", sz, org);
+
+	cpu_reset(c);
+	if (argc > 3)  c->pc = strtoul(argv[3], NULL, 16) ;
+
+	t0 = now();
+	while (!c->jam && !cpu_trapped(c))  n += run(c, SLICE) ;
+	t = now() - t0;
+
+	regs(c);
+	printf("%llu cycles in %.3fs : %.1f emulated MHz\n", (unsigned long long)n, t, t ? n / t / 1e6 : 0);
+
+	if (pf) {
+		prof_blocks(pf, c->mem, 10, stdout);
+		putchar('\n');
+		prof_tree(pf, stdout);
+		if (!(fh = fopen(fold, "w")))  perror(fold) ;
+		else                           prof_folded(pf, fh),  fclose(fh) ;
+		prof_free(pf);
+	}
+
+	rv = c->jam;
+	if (tr && trace_close(tr))  perror("trace") ;
+	cpu_free(c);
+	return rv;
+}
@@ -0,0 +1,159 @@
+//----------------------------------------------------------------------------- ----------------------------------------
+// Recursive-descent (worklist) disassembly
+//
+// Each image byte carries a class (flow_cls_t); a byte is decoded at most once and queued at most once,
+// so the whole pass is linear in the size of the image.
+//
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "6502.h"
+#include "6502-flow.h"
+
+//+============================================================================ ========================================
+int  flow_init (flow_t* f,  const uint8_t* buf,  size_t sz,  uint16_t org)
+{
+	memset(f, 0, sizeof(*f));
+	f->buf = buf;
+	f->sz  = sz;
+	f->org = org;
+	f->bsz = 0x10000 - org;
+
+	if (!sz)  return 0 ;
+	f->cls = calloc(sz, 1);
+	f->wl  = malloc(sz * sizeof(*f->wl));
+	if (!f->cls || !f->wl)  return flow_free(f), -1 ;
+	return 0;
+}
+
+//+============================================================================ ========================================
+void  flow_free (flow_t* f)
+{
+	free(f->cls);
+	free(f->wl);
+	f->cls = NULL;
+	f->wl  = NULL;
+}
+
+//+============================================================================ ========================================
+// Label 'addr' (in 'bank') and queue it if it has not been seen
+//   mark : FL_LBL [| FL_SUB | FL_ENT]
+//
+void  flow_entry (flow_t* f,  size_t bank,  uint16_t addr,  uint8_t mark)
+{
+	long  off = flow_off(f, bank, addr);
+
+	if (off < 0) {
+		f->ext[addr >> 3] |= 1 << (addr & 7);
+		return;
+	}
+
+	f->cls[off] |= mark;
+	if (!(f->cls[off] & (FL_CLS | FL_QUED))) {
+		f->cls[off] |= FL_QUED;
+		f->wl[f->wlt++] = off;
+	}
+}
+
+//+============================================================================ ========================================
+// Mark a (little-endian) pointer as data, and return what it points at
+//   lo, hi : addresses of the two bytes  (JMP (ind) does not carry into the high byte of the pointer)
+// Returns -1 if either byte is outside the image, or already code
+//
+static  long  flow_word (flow_t* f,  size_t bank,  uint16_t lo,  uint16_t hi)
+{
+	long  ol = flow_off(f, bank, lo);
+	long  oh = flow_off(f, bank, hi);
+
+	if ((ol < 0) || (oh < 0))  return -1 ;
+	if (((f->cls[ol] & FL_CLS) | FL_WORD) != FL_WORD)  return -1 ;
+	if (((f->cls[oh] & FL_CLS) | FL_WORD) != FL_WORD)  return -1 ;
+
+	f->cls[ol] |= FL_WORD;
+	f->cls[oh] |= FL_WORD;
+	return f->buf[ol] | (f->buf[oh] << 8);
+}
+
+//+============================================================================ ========================================
+// Queue the NMI, RESET & IRQ/BRK handlers of every bank that maps the vectors
+//
+void  flow_vectors (flow_t* f)
+{
+	static const uint16_t  vec[3] = {0xFFFA, 0xFFFC, 0xFFFE};
+
+	for (size_t bank = 0;  bank * f->bsz < f->sz;  bank++)
+		for (int i = 0;  i < 3;  i++) {
+			long  to = flow_word(f, bank, vec[i], vec[i] + 1);
+			if (to >= 0)  flow_entry(f, bank, to, FL_LBL | FL_ENT) ;
+		}
+}
+
+//+============================================================================ ========================================
+// Follow one thread of execution until it leaves, stops, or joins code already seen
+//
+static  void  flow_trace (flow_t* f,  size_t off)
+{
+	size_t  bank = off / f->bsz;
+	size_t  lim  = (bank + 1) * f->bsz;                  // Instructions do not run off the end of a bank
+
+	if (lim > f->sz)  lim = f->sz ;
+
+	while (off < lim) {
+		const decode_t*  pDec = &op2i[f->buf[off]];
+		uint16_t         addr = flow_addr(f, off);
+		insn_t           in;
+
+		if (f->cls[off] & FL_CLS)                         return ;   // Joined known code (or ran into data)
+		if (!pDec->len || (off + pDec->len > lim))        return ;   // Invalid or truncated: leave it as data
+		for (int i = 1;  i < pDec->len;  i++)
+			if (f->cls[off + i] & FL_CLS)                 return ;   // Would overlap
+
+		in = decode_insn(&f->buf[off]);
+		f->cls[off] |= FL_CODE;
+		for (int i = 1;  i < in.len;  i++)  f->cls[off + i] |= FL_OPER ;
+		f->ninsn++;
+		off += in.len;
+
+		if (in.am == AM_REL)  flow_entry(f, bank, insn_target(in, addr), FL_LBL) ;
+
+		switch (pDec->mnem) {
+			case MN_JSR :  flow_entry(f, bank, in.oper, FL_LBL | FL_SUB);      break ;
+
+			case MN_JMP :
+				if (in.am == AM_ABS) {
+					flow_entry(f, bank, in.oper, FL_LBL);
+				} else {
+					long  to = flow_word(f, bank, in.oper, (in.oper & 0xFF00) | ((in.oper + 1) & 0xFF));
+					if (to >= 0)  flow_entry(f, bank, to, FL_LBL | FL_ENT) ;
+				}
+				return;
+
+			case MN_RTS :
+			case MN_RTI :
+			case MN_BRK :  return ;
+
+			default :      break ;
+		}
+	}
+}
+
+//+============================================================================ ========================================
+// Drain the worklist
+// Returns the number of instructions found so far
+//
+size_t  flow_run (flow_t* f)
+{
+	while (f->wlh < f->wlt)  flow_trace(f, f->wl[f->wlh++]) ;
+	return f->ninsn;
+}
+
+//+============================================================================ ========================================
+// Name of the label at 'addr' in 'bank'  (no NUL)
+//   "LC000", or "L01_C000" in a multi-bank image.  Targets outside the image are never bank-qualified.
+//
+char*  flow_label (char* s,  const flow_t* f,  size_t bank,  uint16_t addr)
+{
+	*s++ = 'L';
+	if ((f->sz > f->bsz) && (flow_off(f, bank, addr) >= 0))  s = hex2(s, bank),  *s++ = '_' ;
+	return hex4(s, addr);
+}
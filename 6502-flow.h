@@ -0,0 +1,76 @@
+#ifndef  _6502_FLOW_H_
+#define  _6502_FLOW_H_
+
+//----------------------------------------------------------------------------- ----------------------------------------
+#include <stddef.h>
+#include <stdint.h>
+
+#include "6502.h"
+
+//----------------------------------------------------------------------------- ----------------------------------------
+// Control-flow analysis of a binary image
+//
+// The image is a set of banks, each mapped at org..$FFFF  (so bank size = $10000 - org).
+// Starting from the entry points, every reachable instruction is decoded exactly once;
+// branch, JMP & JSR targets (and JMP (ind) targets, when the pointer is in the image) are queued and labelled.
+// Whatever is never reached is data.
+//
+typedef
+	enum flow_cls {
+		FL_NONE = 0,        // Not reached  (data)
+		FL_CODE = 1,        // First byte of an instruction
+		FL_OPER = 2,        // Operand byte
+		FL_WORD = 3,        // Half of a vector / JMP (ind) pointer
+
+		FL_CLS  = 0x03,     // Mask of the above
+		FL_ENT  = 0x10,     // Entry point, vector or JMP (ind) target  (reached from somewhere not in the code)
+		FL_QUED = 0x20,     // On the worklist  (never queued twice)
+		FL_SUB  = 0x40,     // JSR target
+		FL_LBL  = 0x80,     // Something transfers control here
+	}
+flow_cls_t;
+
+typedef
+	struct flow {
+		const uint8_t*  buf;                  // Image
+		size_t          sz;                   // bytes
+		uint16_t        org;                  // Start of the bank window
+		uint32_t        bsz;                  // Bank size  ($10000 - org)
+		uint8_t*        cls;                  // One flow_cls_t per image byte
+		uint32_t*       wl;                   // Worklist of image offsets  (FIFO: entry points are traced in the order given)
+		size_t          wlh, wlt;             // Head & tail
+		size_t          ninsn;                // Instructions found
+		uint8_t         ext[0x10000 / 8];     // Targets outside the image  (labelled, not followed)
+	}
+flow_t;
+
+//----------------------------------------------------------------------------- ----------------------------------------
+int     flow_init    (flow_t* f,  const uint8_t* buf,  size_t sz,  uint16_t org) ;
+void    flow_free    (flow_t* f) ;
+
+void    flow_entry   (flow_t* f,  size_t bank,  uint16_t addr,  uint8_t mark) ;
+void    flow_vectors (flow_t* f) ;
+size_t  flow_run     (flow_t* f) ;
+
+char*   flow_label   (char* s,  const flow_t* f,  size_t bank,  uint16_t addr) ;
+
+//+============================================================================ ========================================
+// Image offset of 'addr' in 'bank'  (-1 -> not in the image)
+//
+static inline  long  flow_off (const flow_t* f,  size_t bank,  uint16_t addr)
+{
+	size_t  off = bank * f->bsz + (addr - f->org);
+
+	if ((addr < f->org) || (off >= f->sz))  return -1 ;
+	return off;
+}
+
+//+============================================================================ ========================================
+// Address of an image offset
+//
+static inline  uint16_t  flow_addr (const flow_t* f,  size_t off)
+{
+	return f->org + (off % f->bsz);
+}
+
+#endif //_6502_FLOW_H_
@@ -0,0 +1,182 @@
+//----------------------------------------------------------------------------- ----------------------------------------
+// Incremental linear disassembly  (see 6502-incr.h)
+//
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+
+#include "6502.h"
+#include "6502-xref.h"
+#include "6502-incr.h"
+
+#define INCR_KEYS  (0x10000 << 2)  // (address, kind)
+#define INCR_PAD   (4)             // Slack after the image : decode_insn_tab() reads a whole instruction
+
+//+============================================================================ ========================================
+static  void  chg (incr_t* x,  uint32_t off,  uint16_t addr,  uint8_t kind,  int d)
+{
+	if (x->nchg == x->cap) {
+		incr_chg_t*  v = realloc(x->chg, (x->cap ? x->cap * 2 : 256) * sizeof(*v));
+
+		if (!v)  {  x->lost = 1;  return;  }
+		x->chg = v;
+		x->cap = x->cap ? x->cap * 2 : 256;
+	}
+	x->chg[x->nchg++] = (incr_chg_t){ off, addr, kind, d };
+}
+
+//+============================================================================ ========================================
+// Add (d +1) or remove (d -1) the references of the instruction at a boundary  (rec : note them in chg[])
+//
+static  void  refs (incr_t* x,  uint32_t off,  int d,  int rec)
+{
+	uint16_t  ad[2];
+	uint8_t   kd[2], aux[2];
+	int       nr;
+
+	if (incr_len(x, off) != x->tab[x->buf[off]].len)  return ;     // Data byte
+	nr = xref_of(decode_insn_tab(x->tab, &x->buf[off]), x->org + off, ad, kd, aux);
+
+	for (int r = 0;  r < nr;  r++) {
+		uint32_t  k  = (ad[r] << 2) | kd[r];
+		uint32_t  s  = INCR_SLOT(off, r);
+
+		if (d > 0) {
+			x->nxt[s] = x->head[k];
+			x->prv[s] = 0;
+			if (x->head[k])  x->prv[x->head[k] - 1] = s + 1 ;
+			x->head[k] = s + 1;
+			x->cnt[k]++;
+		} else {
+			if (x->prv[s])  x->nxt[x->prv[s] - 1] = x->nxt[s] ;
+			else            x->head[k] = x->nxt[s] ;
+			if (x->nxt[s])  x->prv[x->nxt[s] - 1] = x->prv[s] ;
+			x->cnt[k]--;
+		}
+
+		if (!rec)  continue ;
+		chg(x, off, ad[r], kd[r], d);
+		if ((kd[r] == XR_JMP) && (x->cnt[k] == (d > 0)))  chg(x, 0, ad[r], INCR_LABEL, d) ;    // 0 -> 1,  1 -> 0
+	}
+}
+
+//+============================================================================ ========================================
+static inline  void  bnd_set (incr_t* x,  size_t off)  {  x->bnd[off >> 3] |=  (1 << (off & 7));  }
+static inline  void  bnd_clr (incr_t* x,  size_t off)  {  x->bnd[off >> 3] &= ~(1 << (off & 7));  }
+
+//+============================================================================ ========================================
+int  incr_init (incr_t* x,  const uint8_t* buf,  size_t sz,  uint16_t org,  cpu_var_t var)
+{
+	memset(x, 0, sizeof(*x));
+	if (sz >= (1u << 30))  return errno = EFBIG, -1 ;
+
+	x->sz   = sz;
+	x->org  = org;
+	x->tab  = op2i_var[var];
+	x->buf  = calloc(sz + INCR_PAD, 1);
+	x->bnd  = calloc((sz + 7) / 8, 1);
+	x->head = calloc(INCR_KEYS, sizeof(*x->head));
+	x->cnt  = calloc(INCR_KEYS, sizeof(*x->cnt));
+	x->nxt  = malloc(2 * sz * sizeof(*x->nxt) + 1);
+	x->prv  = malloc(2 * sz * sizeof(*x->prv) + 1);
+	if (!x->buf || !x->bnd || !x->head || !x->cnt || !x->nxt || !x->prv)  return incr_free(x), errno = ENOMEM, -1 ;
+
+	memcpy(x->buf, buf, sz);
+	for (size_t p = 0;  p < sz;  p += incr_len(x, p)) {
+		bnd_set(x, p);
+		refs(x, p, +1, 0);
+	}
+	return 0;
+}
+
+//+============================================================================ ========================================
+void  incr_free (incr_t* x)
+{
+	free(x->buf);
+	free(x->bnd);
+	free(x->head);
+	free(x->cnt);
+	free(x->nxt);
+	free(x->prv);
+	free(x->chg);
+	memset(x, 0, sizeof(*x));
+}
+
+//+============================================================================ ========================================
+// By kind, address & offset
+//
+static  int  chg_key (const incr_chg_t* p,  const incr_chg_t* q)
+{
+	if (p->kind != q->kind)  return p->kind - q->kind ;
+	if (p->addr != q->addr)  return p->addr - q->addr ;
+	return (p->off > q->off) - (p->off < q->off);
+}
+
+// qsort: chg_key(), then gone before new
+static  int  chg_cmp (const void* a,  const void* b)
+{
+	int  k = chg_key(a, b);
+
+	return k ? k : ((const incr_chg_t*)a)->d - ((const incr_chg_t*)b)->d;
+}
+
+//+============================================================================ ========================================
+// Net the changes out :  gone & back again is no change
+//
+static  void  chg_net (incr_t* x)
+{
+	size_t  n = 0;
+
+	qsort(x->chg, x->nchg, sizeof(*x->chg), chg_cmp);
+	for (size_t i = 0;  i < x->nchg;  ) {
+		incr_chg_t  c = x->chg[i];
+		int         d = 0;
+
+		for (;  (i < x->nchg) && !chg_key(&c, &x->chg[i]);  i++)  d += x->chg[i].d ;
+		if (d)  c.d = (d > 0) ? 1 : -1,  x->chg[n++] = c ;
+	}
+	x->nchg = n;
+}
+
+//+============================================================================ ========================================
+int  incr_patch (incr_t* x,  size_t off,  const uint8_t* b,  size_t n,  size_t* lo,  size_t* hi)
+{
+	size_t  end = off + n;
+	size_t  s   = off,  p;
+
+	x->nchg = 0;
+	x->lost = 0;
+	if ((off > x->sz) || (n > x->sz - off))  return errno = EINVAL, -1 ;
+	if (!n)  return *lo = *hi = off, 0 ;
+
+	// The instructions that start before the end of the patch lose their references while they still have their bytes
+	while (!INCR_BND(x, s))  s-- ;                         // The one the patch starts in
+	for (size_t q = s;  q < end;  ) {
+		size_t  len = incr_len(x, q);
+
+		refs(x, q, -1, 1);
+		bnd_clr(x, q);
+		q += len;
+	}
+
+	memcpy(x->buf + off, b, n);
+
+	// Decode again until the stream is back on an old boundary past the patch
+	for (p = s;  p < x->sz;  ) {
+		size_t  len;
+
+		if ((p >= end) && INCR_BND(x, p))  break ;
+		len = incr_len(x, p);
+		for (size_t q = p + 1;  q < p + len;  q++)            // Old instructions (past the patch) this one swallows
+			if (INCR_BND(x, q))  refs(x, q, -1, 1),  bnd_clr(x, q) ;
+		bnd_set(x, p);
+		refs(x, p, +1, 1);
+		p += len;
+	}
+
+	*lo = s;
+	*hi = p;
+	chg_net(x);
+	return x->lost ? (errno = ENOMEM, -1) : 0;
+}
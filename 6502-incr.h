@@ -0,0 +1,77 @@
+#ifndef  _6502_INCR_H_
+#define  _6502_INCR_H_
+
+//----------------------------------------------------------------------------- ----------------------------------------
+#include <stddef.h>
+#include <stdint.h>
+
+#include "6502.h"
+#include "6502-xref.h"
+
+//----------------------------------------------------------------------------- ----------------------------------------
+// Incremental linear disassembly of an image that is being patched
+//
+// The instruction stream of a linear sweep is kept as a boundary bitmap  (one bit per byte : an instruction, or a data
+// byte, starts here) - so each instruction is the interval from its bit to the next.  Every reference it makes
+// (see 6502-xref.h) is linked into a list per (address, kind), and counted;  a label is an address with a jump.
+//
+// incr_patch() writes the bytes, then re-decodes from the boundary at or before the first of them, until the new
+// stream lands on an old boundary past the last - from there on, nothing can have changed.  Only the instructions in
+// between are unlinked & relinked.  A byte that is not an opcode changes no length, so that is usually a handful.
+//
+// What changed is left in chg[] :  references & labels gone (d -1) or new (d +1), an instruction that decoded to the
+// same thing again does not appear.
+//
+#define INCR_LABEL  (4)            // chg[].kind : a label  (else an xref_kind_t)
+
+typedef
+	struct incr_chg {
+		uint32_t  off;             // Image offset of the instruction  (labels : 0)
+		uint16_t  addr;            // Address named
+		uint8_t   kind;            // xref_kind_t or INCR_LABEL
+		int8_t    d;               // -1 gone, +1 new
+	}
+incr_chg_t;
+
+typedef
+	struct incr {
+		uint8_t*          buf;     // The image  (a copy;  incr_patch() writes here)
+		size_t            sz;
+		uint16_t          org;
+		const decode_t*   tab;
+
+		uint8_t*          bnd;     // Boundary bitmap  (sz bits)
+		uint32_t*         head;    // [address << 2 | kind]  first reference :  slot + 1, 0 -> none
+		uint32_t*         cnt;     // [address << 2 | kind]  references
+		uint32_t*         nxt;     // [slot]  slot + 1 of the next reference to the same (address, kind)
+		uint32_t*         prv;     // [slot]  ... & the one before  (0 -> head)
+
+		incr_chg_t*       chg;     // Changes made by the last incr_patch()
+		size_t            nchg, cap;
+		int               lost;    // !0 -> chg[] is short  (out of memory)
+	}
+incr_t;
+
+// Reference slots : two per byte  (BBRn/BBSn make two)
+#define INCR_SLOT(off, r)  ((off) * 2 + (r))
+#define INCR_OFF(s1)       (((s1) - 1) >> 1)           // From a head[] / nxt[] value
+
+#define INCR_BND(x, off)   (((x)->bnd[(off) >> 3] >> ((off) & 7)) & 1)
+
+//----------------------------------------------------------------------------- ----------------------------------------
+int     incr_init  (incr_t* x,  const uint8_t* buf,  size_t sz,  uint16_t org,  cpu_var_t var) ;   // -> 0, or -1 (errno)
+void    incr_free  (incr_t* x) ;
+
+// Write n bytes at off & bring the index up to date   -> 0, or -1 (EINVAL: past the end;  ENOMEM)
+//   [*lo, *hi) : the bytes that were decoded again  (the listing lines to replace)
+int     incr_patch (incr_t* x,  size_t off,  const uint8_t* b,  size_t n,  size_t* lo,  size_t* hi) ;
+
+// Instruction length at a boundary  (1 for a data byte)
+static inline  int  incr_len (const incr_t* x,  size_t off)
+{
+	int  len = x->tab[x->buf[off]].len;
+
+	return (!len || (off + len > x->sz)) ? 1 : len;
+}
+
+#endif //_6502_INCR_H_
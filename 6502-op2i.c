@@ -0,0 +1,351 @@
+//----------------------------------------------------------------------------- ----------------------------------------
+// Decode tables & the text decoder
+//
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "6502.h"
+
+//----------------------------------------------------------------------------- ----------------------------------------
+// Addressing mode names
+//
+const char  amode[AM_MAX][16] = {
+	[AM_IMP ] = "Implied", 
+	[AM_REL ] = "Relative", 
+	[AM_ACC ] = "Accum", 
+	[AM_IMM ] = "Immediate", 
+	[AM_ZP  ] = "ZeroPage", 
+	[AM_ZPX ] = "ZeroPage,X", 
+	[AM_ZPY ] = "ZeroPage,Y", 
+	[AM_ABS ] = "Abs", 
+	[AM_ABSX] = "Abs,X", 
+	[AM_ABSY] = "Abs.Y", 
+	[AM_IND ] = "(Ind)", 
+	[AM_INDX] = "(Ind,X)", 
+	[AM_INDY] = "(Ind),Y",
+	[AM_ZPI ] = "(ZeroPage)",
+	[AM_IAX ] = "(Abs,X)",
+	[AM_ZPR ] = "ZeroPage,Rel",
+	[AM_SR  ] = "Stack,S",
+	[AM_SRIY] = "(Stack,S),Y",
+	[AM_DIL ] = "[DirectPage]",
+	[AM_DILY] = "[DirectPage],Y",
+	[AM_LNG ] = "Long",
+	[AM_LNGX] = "Long,X",
+	[AM_RELL] = "RelLong",
+	[AM_BLK ] = "BlockMove",
+	[AM_IL  ] = "[Abs]",
+};
+
+//----------------------------------------------------------------------------- ----------------------------------------
+// Mnemonic string pool  (3 chars + NUL)
+//
+const char  mnem[MN_MAX][4] = {
+	[MN_ILL] = "???",
+	[MN_ADC] = "ADC", [MN_AND] = "AND", [MN_ASL] = "ASL", [MN_BCC] = "BCC",
+	[MN_BCS] = "BCS", [MN_BEQ] = "BEQ", [MN_BIT] = "BIT", [MN_BMI] = "BMI",
+	[MN_BNE] = "BNE", [MN_BPL] = "BPL", [MN_BRK] = "BRK", [MN_BVC] = "BVC",
+	[MN_BVS] = "BVS", [MN_CLC] = "CLC", [MN_CLD] = "CLD", [MN_CLI] = "CLI",
+	[MN_CLV] = "CLV", [MN_CMP] = "CMP", [MN_CPX] = "CPX", [MN_CPY] = "CPY",
+	[MN_DEC] = "DEC", [MN_DEX] = "DEX", [MN_DEY] = "DEY", [MN_EOR] = "EOR",
+	[MN_INC] = "INC", [MN_INX] = "INX", [MN_INY] = "INY", [MN_JMP] = "JMP",
+	[MN_JSR] = "JSR", [MN_LDA] = "LDA", [MN_LDX] = "LDX", [MN_LDY] = "LDY",
+	[MN_LSR] = "LSR", [MN_NOP] = "NOP", [MN_ORA] = "ORA", [MN_PHA] = "PHA",
+	[MN_PHP] = "PHP", [MN_PLA] = "PLA", [MN_PLP] = "PLP", [MN_ROL] = "ROL",
+	[MN_ROR] = "ROR", [MN_RTI] = "RTI", [MN_RTS] = "RTS", [MN_SBC] = "SBC",
+	[MN_SEC] = "SEC", [MN_SED] = "SED", [MN_SEI] = "SEI", [MN_STA] = "STA",
+	[MN_STX] = "STX", [MN_STY] = "STY", [MN_TAX] = "TAX", [MN_TAY] = "TAY",
+	[MN_TSX] = "TSX", [MN_TXA] = "TXA", [MN_TXS] = "TXS", [MN_TYA] = "TYA",
+
+	// NMOS undocumented  (the stable ones)
+	[MN_ALR] = "ALR", [MN_ANC] = "ANC", [MN_ARR] = "ARR", [MN_DCP] = "DCP",
+	[MN_ISC] = "ISC", [MN_LAX] = "LAX", [MN_RLA] = "RLA", [MN_RRA] = "RRA",
+	[MN_SAX] = "SAX", [MN_SBX] = "SBX", [MN_SLO] = "SLO", [MN_SRE] = "SRE",
+
+	// 65C02  (BBR..SMB carry a bit number: "RMB3")
+	[MN_BBR] = "BBR", [MN_BBS] = "BBS", [MN_RMB] = "RMB", [MN_SMB] = "SMB",
+	[MN_BRA] = "BRA", [MN_PHX] = "PHX", [MN_PHY] = "PHY", [MN_PLX] = "PLX",
+	[MN_PLY] = "PLY", [MN_STP] = "STP", [MN_STZ] = "STZ", [MN_TRB] = "TRB",
+	[MN_TSB] = "TSB", [MN_WAI] = "WAI",
+
+	// 65816
+	[MN_BRL] = "BRL", [MN_COP] = "COP", [MN_JML] = "JML", [MN_JSL] = "JSL",
+	[MN_MVN] = "MVN", [MN_MVP] = "MVP", [MN_PEA] = "PEA", [MN_PEI] = "PEI",
+	[MN_PER] = "PER", [MN_PHB] = "PHB", [MN_PHD] = "PHD", [MN_PHK] = "PHK",
+	[MN_PLB] = "PLB", [MN_PLD] = "PLD", [MN_REP] = "REP", [MN_RTL] = "RTL",
+	[MN_SEP] = "SEP", [MN_TCD] = "TCD", [MN_TCS] = "TCS", [MN_TDC] = "TDC",
+	[MN_TSC] = "TSC", [MN_TXY] = "TXY", [MN_TYX] = "TYX", [MN_WDM] = "WDM",
+	[MN_XBA] = "XBA", [MN_XCE] = "XCE",
+};
+
+//----------------------------------------------------------------------------- ----------------------------------------
+// Mnemonic -> mnem_t : perfect hash  (see MN_HASH in 6502.h)
+// A collision would initialise a slot twice, which -Wextra (-Woverride-init) reports at compile time
+//
+const uint8_t  mnem_hash[MN_HASH_SZ] = {
+	[MN_HASH('A','D','C')] = MN_ADC, [MN_HASH('A','N','D')] = MN_AND, [MN_HASH('A','S','L')] = MN_ASL, [MN_HASH('B','C','C')] = MN_BCC,
+	[MN_HASH('B','C','S')] = MN_BCS, [MN_HASH('B','E','Q')] = MN_BEQ, [MN_HASH('B','I','T')] = MN_BIT, [MN_HASH('B','M','I')] = MN_BMI,
+	[MN_HASH('B','N','E')] = MN_BNE, [MN_HASH('B','P','L')] = MN_BPL, [MN_HASH('B','R','K')] = MN_BRK, [MN_HASH('B','V','C')] = MN_BVC,
+	[MN_HASH('B','V','S')] = MN_BVS, [MN_HASH('C','L','C')] = MN_CLC, [MN_HASH('C','L','D')] = MN_CLD, [MN_HASH('C','L','I')] = MN_CLI,
+	[MN_HASH('C','L','V')] = MN_CLV, [MN_HASH('C','M','P')] = MN_CMP, [MN_HASH('C','P','X')] = MN_CPX, [MN_HASH('C','P','Y')] = MN_CPY,
+	[MN_HASH('D','E','C')] = MN_DEC, [MN_HASH('D','E','X')] = MN_DEX, [MN_HASH('D','E','Y')] = MN_DEY, [MN_HASH('E','O','R')] = MN_EOR,
+	[MN_HASH('I','N','C')] = MN_INC, [MN_HASH('I','N','X')] = MN_INX, [MN_HASH('I','N','Y')] = MN_INY, [MN_HASH('J','M','P')] = MN_JMP,
+	[MN_HASH('J','S','R')] = MN_JSR, [MN_HASH('L','D','A')] = MN_LDA, [MN_HASH('L','D','X')] = MN_LDX, [MN_HASH('L','D','Y')] = MN_LDY,
+	[MN_HASH('L','S','R')] = MN_LSR, [MN_HASH('N','O','P')] = MN_NOP, [MN_HASH('O','R','A')] = MN_ORA, [MN_HASH('P','H','A')] = MN_PHA,
+	[MN_HASH('P','H','P')] = MN_PHP, [MN_HASH('P','L','A')] = MN_PLA, [MN_HASH('P','L','P')] = MN_PLP, [MN_HASH('R','O','L')] = MN_ROL,
+	[MN_HASH('R','O','R')] = MN_ROR, [MN_HASH('R','T','I')] = MN_RTI, [MN_HASH('R','T','S')] = MN_RTS, [MN_HASH('S','B','C')] = MN_SBC,
+	[MN_HASH('S','E','C')] = MN_SEC, [MN_HASH('S','E','D')] = MN_SED, [MN_HASH('S','E','I')] = MN_SEI, [MN_HASH('S','T','A')] = MN_STA,
+	[MN_HASH('S','T','X')] = MN_STX, [MN_HASH('S','T','Y')] = MN_STY, [MN_HASH('T','A','X')] = MN_TAX, [MN_HASH('T','A','Y')] = MN_TAY,
+	[MN_HASH('T','S','X')] = MN_TSX, [MN_HASH('T','X','A')] = MN_TXA, [MN_HASH('T','X','S')] = MN_TXS, [MN_HASH('T','Y','A')] = MN_TYA,
+
+	// NMOS undocumented  (the stable ones)
+	[MN_HASH('A','L','R')] = MN_ALR, [MN_HASH('A','N','C')] = MN_ANC, [MN_HASH('A','R','R')] = MN_ARR, [MN_HASH('D','C','P')] = MN_DCP,
+	[MN_HASH('I','S','C')] = MN_ISC, [MN_HASH('L','A','X')] = MN_LAX, [MN_HASH('R','L','A')] = MN_RLA, [MN_HASH('R','R','A')] = MN_RRA,
+	[MN_HASH('S','A','X')] = MN_SAX, [MN_HASH('S','B','X')] = MN_SBX, [MN_HASH('S','L','O')] = MN_SLO, [MN_HASH('S','R','E')] = MN_SRE,
+
+	// 65C02  (BBR..SMB carry a bit number: "RMB3")
+	[MN_HASH('B','B','R')] = MN_BBR, [MN_HASH('B','B','S')] = MN_BBS, [MN_HASH('R','M','B')] = MN_RMB, [MN_HASH('S','M','B')] = MN_SMB,
+	[MN_HASH('B','R','A')] = MN_BRA, [MN_HASH('P','H','X')] = MN_PHX, [MN_HASH('P','H','Y')] = MN_PHY, [MN_HASH('P','L','X')] = MN_PLX,
+	[MN_HASH('P','L','Y')] = MN_PLY, [MN_HASH('S','T','P')] = MN_STP, [MN_HASH('S','T','Z')] = MN_STZ, [MN_HASH('T','R','B')] = MN_TRB,
+	[MN_HASH('T','S','B')] = MN_TSB, [MN_HASH('W','A','I')] = MN_WAI,
+
+	// 65816
+	[MN_HASH('B','R','L')] = MN_BRL, [MN_HASH('C','O','P')] = MN_COP, [MN_HASH('J','M','L')] = MN_JML, [MN_HASH('J','S','L')] = MN_JSL,
+	[MN_HASH('M','V','N')] = MN_MVN, [MN_HASH('M','V','P')] = MN_MVP, [MN_HASH('P','E','A')] = MN_PEA, [MN_HASH('P','E','I')] = MN_PEI,
+	[MN_HASH('P','E','R')] = MN_PER, [MN_HASH('P','H','B')] = MN_PHB, [MN_HASH('P','H','D')] = MN_PHD, [MN_HASH('P','H','K')] = MN_PHK,
+	[MN_HASH('P','L','B')] = MN_PLB, [MN_HASH('P','L','D')] = MN_PLD, [MN_HASH('R','E','P')] = MN_REP, [MN_HASH('R','T','L')] = MN_RTL,
+	[MN_HASH('S','E','P')] = MN_SEP, [MN_HASH('T','C','D')] = MN_TCD, [MN_HASH('T','C','S')] = MN_TCS, [MN_HASH('T','D','C')] = MN_TDC,
+	[MN_HASH('T','S','C')] = MN_TSC, [MN_HASH('T','X','Y')] = MN_TXY, [MN_HASH('T','Y','X')] = MN_TYX, [MN_HASH('W','D','M')] = MN_WDM,
+	[MN_HASH('X','B','A')] = MN_XBA, [MN_HASH('X','C','E')] = MN_XCE,
+};
+
+//----------------------------------------------------------------------------- ----------------------------------------
+// Instruction decoder table
+//
+// Built at compile time: lives in .rodata, needs no setup, and is safe to share between threads
+// Unlisted opcodes are zero-filled  (len == 0 -> invalid instruction)
+//
+// "flags read" are the flags an instruction consumes (C for ADC/ROL, N for BMI, all of P for PHP, ...)
+// Together with the reset/set/modify masks this gives flag liveness: an emulator or analyser can tell
+// which flag results are overwritten before anybody looks at them
+//
+// Footnotes:
+//   [1] : (Tcnt += 1) if page boundary is crossed         // +10
+//   [2] : (Tcnt += 1) if branch occurs on same page       // +20
+//       : (Tcnt += 2) if branch occurs to different page  // ...
+//
+const decode_t  op2i[256] = {
+	//                      addr    len TCnt |<----------------flags------------------->|   flags
+	//   opcode      mnem     mode   V  VV   | reset  |   set   |         modify        |   read
+	[OP_ADC_ABS ] = {MN_ADC, AM_ABS , 3,  4, {FLG_NONE, FLG_NONE, FLG_N|FLG_V|FLG_Z|FLG_C}, FLG_C|FLG_D},
+	[OP_ADC_ABSX] = {MN_ADC, AM_ABSX, 3, 14, {FLG_NONE, FLG_NONE, FLG_N|FLG_V|FLG_Z|FLG_C}, FLG_C|FLG_D},
+	[OP_ADC_ABSY] = {MN_ADC, AM_ABSY, 3, 14, {FLG_NONE, FLG_NONE, FLG_N|FLG_V|FLG_Z|FLG_C}, FLG_C|FLG_D},
+	[OP_ADC_IMM ] = {MN_ADC, AM_IMM , 2,  2, {FLG_NONE, FLG_NONE, FLG_N|FLG_V|FLG_Z|FLG_C}, FLG_C|FLG_D},
+	[OP_ADC_INDX] = {MN_ADC, AM_INDX, 2,  6, {FLG_NONE, FLG_NONE, FLG_N|FLG_V|FLG_Z|FLG_C}, FLG_C|FLG_D},
+	[OP_ADC_INDY] = {MN_ADC, AM_INDY, 2, 15, {FLG_NONE, FLG_NONE, FLG_N|FLG_V|FLG_Z|FLG_C}, FLG_C|FLG_D},
+	[OP_ADC_ZP  ] = {MN_ADC, AM_ZP  , 2,  3, {FLG_NONE, FLG_NONE, FLG_N|FLG_V|FLG_Z|FLG_C}, FLG_C|FLG_D},
+	[OP_ADC_ZPX ] = {MN_ADC, AM_ZPX , 2,  4, {FLG_NONE, FLG_NONE, FLG_N|FLG_V|FLG_Z|FLG_C}, FLG_C|FLG_D},
+	[OP_AND_ABS ] = {MN_AND, AM_ABS , 3,  4, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[OP_AND_ABSX] = {MN_AND, AM_ABSX, 3, 14, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[OP_AND_ABSY] = {MN_AND, AM_ABSY, 3, 14, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[OP_AND_IMM ] = {MN_AND, AM_IMM , 2,  2, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[OP_AND_INDX] = {MN_AND, AM_INDX, 2,  6, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[OP_AND_INDY] = {MN_AND, AM_INDY, 2, 15, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[OP_AND_ZP  ] = {MN_AND, AM_ZP  , 2,  3, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[OP_AND_ZPX ] = {MN_AND, AM_ZPX , 2,  4, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[OP_ASL_ABS ] = {MN_ASL, AM_ABS , 3,  6, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_NONE   },
+	[OP_ASL_ABSX] = {MN_ASL, AM_ABSX, 3,  7, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_NONE   },
+	[OP_ASL_ACC ] = {MN_ASL, AM_ACC , 1,  2, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_NONE   },
+	[OP_ASL_ZP  ] = {MN_ASL, AM_ZP  , 2,  5, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_NONE   },
+	[OP_ASL_ZPX ] = {MN_ASL, AM_ZPX , 2,  6, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_NONE   },
+	[OP_BCC_REL ] = {MN_BCC, AM_REL , 2, 22, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_C      },
+	[OP_BCS_REL ] = {MN_BCS, AM_REL , 2, 22, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_C      },
+	[OP_BEQ_REL ] = {MN_BEQ, AM_REL , 2, 22, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_Z      },
+	[OP_BIT_ABS ] = {MN_BIT, AM_ABS , 3,  4, {FLG_NONE, FLG_NONE, FLG_N|FLG_V|FLG_Z      }, FLG_NONE   },
+	[OP_BIT_ZP  ] = {MN_BIT, AM_ZP  , 2,  3, {FLG_NONE, FLG_NONE, FLG_N|FLG_V|FLG_Z      }, FLG_NONE   },
+	[OP_BMI_REL ] = {MN_BMI, AM_REL , 2, 22, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_N      },
+	[OP_BNE_REL ] = {MN_BNE, AM_REL , 2, 22, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_Z      },
+	[OP_BPL_REL ] = {MN_BPL, AM_REL , 2, 22, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_N      },
+	[OP_BRK_IMP ] = {MN_BRK, AM_IMP , 1,  7, {FLG_NONE, FLG_I,    FLG_NONE               }, FLG_ALL    },
+	[OP_BVC_REL ] = {MN_BVC, AM_REL , 2, 22, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_V      },
+	[OP_BVS_REL ] = {MN_BVS, AM_REL , 2, 22, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_V      },
+	[OP_CLC_IMP ] = {MN_CLC, AM_IMP , 1,  2, {FLG_C,    FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[OP_CLD_IMP ] = {MN_CLD, AM_IMP , 1,  2, {FLG_D,    FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[OP_CLI_IMP ] = {MN_CLI, AM_IMP , 1,  2, {FLG_I,    FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[OP_CLV_IMP ] = {MN_CLV, AM_IMP , 1,  2, {FLG_V,    FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[OP_CMP_ABS ] = {MN_CMP, AM_ABS , 3,  4, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_NONE   },
+	[OP_CMP_ABSX] = {MN_CMP, AM_ABSX, 3, 14, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_NONE   },
+	[OP_CMP_ABSY] = {MN_CMP, AM_ABSY, 3, 14, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_NONE   },
+	[OP_CMP_IMM ] = {MN_CMP, AM_IMM , 2,  2, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_NONE   },
+	[OP_CMP_INDX] = {MN_CMP, AM_INDX, 2,  6, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_NONE   },
+	[OP_CMP_INDY] = {MN_CMP, AM_INDY, 2, 15, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_NONE   },
+	[OP_CMP_ZP  ] = {MN_CMP, AM_ZP  , 2,  3, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_NONE   },
+	[OP_CMP_ZPX ] = {MN_CMP, AM_ZPX , 2,  4, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_NONE   },
+	[OP_CPX_ABS ] = {MN_CPX, AM_ABS , 3,  4, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_NONE   },
+	[OP_CPX_IMM ] = {MN_CPX, AM_IMM , 2,  2, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_NONE   },
+	[OP_CPX_ZP  ] = {MN_CPX, AM_ZP  , 2,  3, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_NONE   },
+	[OP_CPY_ABS ] = {MN_CPY, AM_ABS , 3,  4, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_NONE   },
+	[OP_CPY_IMM ] = {MN_CPY, AM_IMM , 2,  2, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_NONE   },
+	[OP_CPY_ZP  ] = {MN_CPY, AM_ZP  , 2,  3, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_NONE   },
+	[OP_DEC_ABS ] = {MN_DEC, AM_ABS , 3,  6, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[OP_DEC_ABSX] = {MN_DEC, AM_ABSX, 3,  7, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[OP_DEC_ZP  ] = {MN_DEC, AM_ZP  , 2,  5, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[OP_DEC_ZPX ] = {MN_DEC, AM_ZPX , 2,  6, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[OP_DEX_IMP ] = {MN_DEX, AM_IMP , 1,  2, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[OP_DEY_IMP ] = {MN_DEY, AM_IMP , 1,  2, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[OP_EOR_ABS ] = {MN_EOR, AM_ABS , 3,  4, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[OP_EOR_ABSX] = {MN_EOR, AM_ABSX, 3, 14, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[OP_EOR_ABSY] = {MN_EOR, AM_ABSY, 3, 14, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[OP_EOR_IMM ] = {MN_EOR, AM_IMM , 2,  2, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[OP_EOR_INDX] = {MN_EOR, AM_INDX, 2,  6, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[OP_EOR_INDY] = {MN_EOR, AM_INDY, 2, 15, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[OP_EOR_ZP  ] = {MN_EOR, AM_ZP  , 2,  3, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[OP_EOR_ZPX ] = {MN_EOR, AM_ZPX , 2,  4, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[OP_INC_ABS ] = {MN_INC, AM_ABS , 3,  6, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[OP_INC_ABSX] = {MN_INC, AM_ABSX, 3,  7, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[OP_INC_ZP  ] = {MN_INC, AM_ZP  , 2,  5, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[OP_INC_ZPX ] = {MN_INC, AM_ZPX , 2,  6, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[OP_INX_IMP ] = {MN_INX, AM_IMP , 1,  2, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[OP_INY_IMP ] = {MN_INY, AM_IMP , 1,  2, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[OP_JMP_ABS ] = {MN_JMP, AM_ABS , 3,  3, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },            
+	[OP_JMP_IND ] = {MN_JMP, AM_IND , 3,  5, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },            
+	[OP_JSR_ABS ] = {MN_JSR, AM_ABS , 3,  6, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },            
+	[OP_LDA_ABS ] = {MN_LDA, AM_ABS , 3,  4, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[OP_LDA_ABSX] = {MN_LDA, AM_ABSX, 3, 14, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[OP_LDA_ABSY] = {MN_LDA, AM_ABSY, 3, 14, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[OP_LDA_IMM ] = {MN_LDA, AM_IMM , 2,  2, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[OP_LDA_INDX] = {MN_LDA, AM_INDX, 2,  6, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[OP_LDA_INDY] = {MN_LDA, AM_INDY, 2, 15, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[OP_LDA_ZP  ] = {MN_LDA, AM_ZP  , 2,  3, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[OP_LDA_ZPX ] = {MN_LDA, AM_ZPX , 2,  4, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[OP_LDX_ABS ] = {MN_LDX, AM_ABS , 3,  4, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[OP_LDX_ABSY] = {MN_LDX, AM_ABSY, 3, 14, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[OP_LDX_IMM ] = {MN_LDX, AM_IMM , 2,  2, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[OP_LDX_ZP  ] = {MN_LDX, AM_ZP  , 2,  3, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[OP_LDX_ZPY ] = {MN_LDX, AM_ZPY , 2,  4, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[OP_LDY_ABS ] = {MN_LDY, AM_ABS , 3,  4, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[OP_LDY_ABSX] = {MN_LDY, AM_ABSX, 3, 14, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[OP_LDY_IMM ] = {MN_LDY, AM_IMM , 2,  2, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[OP_LDY_ZP  ] = {MN_LDY, AM_ZP  , 2,  3, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[OP_LDY_ZPX ] = {MN_LDY, AM_ZPX , 2,  4, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[OP_LSR_ABS ] = {MN_LSR, AM_ABS , 3,  6, {FLG_N,    FLG_NONE, FLG_Z            |FLG_C}, FLG_NONE   },
+	[OP_LSR_ABSX] = {MN_LSR, AM_ABSX, 3,  7, {FLG_N,    FLG_NONE, FLG_Z            |FLG_C}, FLG_NONE   },
+	[OP_LSR_IMM ] = {MN_LSR, AM_ACC , 1,  2, {FLG_N,    FLG_NONE, FLG_Z            |FLG_C}, FLG_NONE   },
+	[OP_LSR_ZP  ] = {MN_LSR, AM_ZP  , 2,  5, {FLG_N,    FLG_NONE, FLG_Z            |FLG_C}, FLG_NONE   },
+	[OP_LSR_ZPX ] = {MN_LSR, AM_ZPX , 2,  6, {FLG_N,    FLG_NONE, FLG_Z            |FLG_C}, FLG_NONE   },
+	[OP_NOP_IMP ] = {MN_NOP, AM_IMP , 1,  2, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[OP_ORA_ABS ] = {MN_ORA, AM_ABS , 3,  4, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[OP_ORA_ABSX] = {MN_ORA, AM_ABSX, 3, 14, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[OP_ORA_ABSY] = {MN_ORA, AM_ABSY, 3, 14, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[OP_ORA_IMM ] = {MN_ORA, AM_IMM , 2,  2, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[OP_ORA_INDX] = {MN_ORA, AM_INDX, 2,  6, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[OP_ORA_INDY] = {MN_ORA, AM_INDY, 2, 15, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[OP_ORA_ZP  ] = {MN_ORA, AM_ZP  , 2,  3, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[OP_ORA_ZPX ] = {MN_ORA, AM_ZPX , 2,  4, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[OP_PHA_IMP ] = {MN_PHA, AM_IMP , 1,  3, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[OP_PHP_IMP ] = {MN_PHP, AM_IMP , 1,  3, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_ALL    },
+	[OP_PLA_IMP ] = {MN_PLA, AM_IMP , 1,  4, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[OP_PLP_IMP ] = {MN_PLP, AM_IMP , 1,  4, {FLG_NONE, FLG_NONE, FLG_ALL                }, FLG_NONE   },
+	[OP_ROL_ABS ] = {MN_ROL, AM_ABS , 3,  6, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_C      },
+	[OP_ROL_ABSX] = {MN_ROL, AM_ABSX, 3,  7, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_C      },
+	[OP_ROL_ACC ] = {MN_ROL, AM_ACC , 1,  2, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_C      },
+	[OP_ROL_ZP  ] = {MN_ROL, AM_ZP  , 2,  5, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_C      },
+	[OP_ROL_ZPX ] = {MN_ROL, AM_ZPX , 2,  6, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_C      },
+	[OP_ROR_ABS ] = {MN_ROR, AM_ABS , 3,  6, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_C      },
+	[OP_ROR_ABSX] = {MN_ROR, AM_ABSX, 3,  7, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_C      },
+	[OP_ROR_ACC ] = {MN_ROR, AM_ACC , 1,  2, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_C      },
+	[OP_ROR_ZP  ] = {MN_ROR, AM_ZP  , 2,  5, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_C      },
+	[OP_ROR_ZPX ] = {MN_ROR, AM_ZPX , 2,  6, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_C      },
+	[OP_RTI_IMP ] = {MN_RTI, AM_IMP , 1,  6, {FLG_NONE, FLG_NONE, FLG_ALL                }, FLG_NONE   },
+	[OP_RTS_IMP ] = {MN_RTS, AM_IMP , 1,  6, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[OP_SBC_ABS ] = {MN_SBC, AM_ABS , 3,  4, {FLG_NONE, FLG_NONE, FLG_N|FLG_V|FLG_Z|FLG_C}, FLG_C|FLG_D},
+	[OP_SBC_ABSX] = {MN_SBC, AM_ABSX, 3, 14, {FLG_NONE, FLG_NONE, FLG_N|FLG_V|FLG_Z|FLG_C}, FLG_C|FLG_D},
+	[OP_SBC_ABSY] = {MN_SBC, AM_ABSY, 3, 14, {FLG_NONE, FLG_NONE, FLG_N|FLG_V|FLG_Z|FLG_C}, FLG_C|FLG_D},
+	[OP_SBC_IMM ] = {MN_SBC, AM_IMM , 2,  2, {FLG_NONE, FLG_NONE, FLG_N|FLG_V|FLG_Z|FLG_C}, FLG_C|FLG_D},
+	[OP_SBC_INDX] = {MN_SBC, AM_INDX, 2,  6, {FLG_NONE, FLG_NONE, FLG_N|FLG_V|FLG_Z|FLG_C}, FLG_C|FLG_D},
+	[OP_SBC_INDY] = {MN_SBC, AM_INDY, 2, 15, {FLG_NONE, FLG_NONE, FLG_N|FLG_V|FLG_Z|FLG_C}, FLG_C|FLG_D},
+	[OP_SBC_ZP  ] = {MN_SBC, AM_ZP  , 2,  3, {FLG_NONE, FLG_NONE, FLG_N|FLG_V|FLG_Z|FLG_C}, FLG_C|FLG_D},
+	[OP_SBC_ZPX ] = {MN_SBC, AM_ZPX , 2,  4, {FLG_NONE, FLG_NONE, FLG_N|FLG_V|FLG_Z|FLG_C}, FLG_C|FLG_D},
+	[OP_SEC_IMP ] = {MN_SEC, AM_IMP , 1,  2, {FLG_NONE, FLG_C,    FLG_NONE               }, FLG_NONE   },
+	[OP_SED_IMP ] = {MN_SED, AM_IMP , 1,  2, {FLG_NONE, FLG_D,    FLG_NONE               }, FLG_NONE   },
+	[OP_SEI_IMP ] = {MN_SEI, AM_IMP , 1,  2, {FLG_NONE, FLG_I,    FLG_NONE               }, FLG_NONE   },
+	[OP_STA_ABS ] = {MN_STA, AM_ABS , 3,  4, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[OP_STA_ABSX] = {MN_STA, AM_ABSX, 3,  5, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[OP_STA_ABSY] = {MN_STA, AM_ABSY, 3,  5, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[OP_STA_INDX] = {MN_STA, AM_INDX, 2,  6, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[OP_STA_INDY] = {MN_STA, AM_INDY, 2,  6, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[OP_STA_ZP  ] = {MN_STA, AM_ZP  , 2,  3, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[OP_STA_ZPX ] = {MN_STA, AM_ZPX , 2,  4, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[OP_STX_ABS ] = {MN_STX, AM_ABS , 3,  4, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[OP_STX_ZP  ] = {MN_STX, AM_ZP  , 2,  3, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[OP_STX_ZPY ] = {MN_STX, AM_ZPY , 2,  4, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[OP_STY_ABS ] = {MN_STY, AM_ABS , 3,  4, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[OP_STY_ZP  ] = {MN_STY, AM_ZP  , 2,  3, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[OP_STY_ZPX ] = {MN_STY, AM_ZPX , 2,  4, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[OP_TAX_IMP ] = {MN_TAX, AM_IMP , 1,  2, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[OP_TAY_IMP ] = {MN_TAY, AM_IMP , 1,  2, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[OP_TSX_IMP ] = {MN_TSX, AM_IMP , 1,  2, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[OP_TXA_IMP ] = {MN_TXA, AM_IMP , 1,  2, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[OP_TXS_IMP ] = {MN_TXS, AM_IMP , 1,  2, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[OP_TYA_IMP ] = {MN_TYA, AM_IMP , 1,  2, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+};
+
+//+============================================================================ ========================================
+// Returns the packed decode word  (.len == 0 -> invalid opcode)
+// Always renders the operand text - decode_insn() + insn_render() is the text-on-demand path
+//
+decode_t  decode (uint8_t* pc,  disasm_t* pDis)
+{
+	return decode_tab(op2i, pc, pDis);
+}
+
+//+============================================================================ ========================================
+// decode() through any decode table  (op2i, or a variant: op2i_var[])
+//   RMBn/SMBn/BBRn/BBSn get their bit number;  AM_REL, AM_RELL & the branch of AM_ZPR show "lbl"
+//
+decode_t  decode_tab (const decode_t* tab,  uint8_t* pc,  disasm_t* pDis)
+{
+	const decode_t*  pDec = &tab[*pc];
+
+	memcpy(pDis->mnem, mnem[pDec->mnem], 4);
+	if (MN_HASBIT(pDec->mnem))  pDis->mnem[3] = '0' + ((*pc >> 4) & 7),  pDis->mnem[4] = '\0' ;
+	*pDis->oper = '\0';
+
+	switch (pDis->am = pDec->am) {
+		case AM_IMP :  sprintf(pDis->oper, ""                          );  break ;
+		case AM_REL :  sprintf(pDis->oper, "lbl"                       );  break ;
+		case AM_ACC :  sprintf(pDis->oper, "A"                         );  break ;
+		case AM_IMM :  sprintf(pDis->oper, "#$%02X"    , PEEK8   (pc+1));  break ;
+		case AM_ZP  :  sprintf(pDis->oper, "$%02X"     , PEEK8   (pc+1));  break ;
+		case AM_ZPX :  sprintf(pDis->oper, "$%02X, X"  , PEEK8   (pc+1));  break ;
+		case AM_ZPY :  sprintf(pDis->oper, "$%02X, Y"  , PEEK8   (pc+1));  break ;
+		case AM_ABS :  sprintf(pDis->oper, "$%04X"     , PEEK16LE(pc+1));  break ;
+		case AM_ABSX:  sprintf(pDis->oper, "$%04X, X"  , PEEK16LE(pc+1));  break ;
+		case AM_ABSY:  sprintf(pDis->oper, "$%04X, Y"  , PEEK16LE(pc+1));  break ;
+		case AM_IND :  sprintf(pDis->oper, "($%04X)"   , PEEK16LE(pc+1));  break ;
+		case AM_INDX:  sprintf(pDis->oper, "($%02X, X)", PEEK8   (pc+1));  break ;
+		case AM_INDY:  sprintf(pDis->oper, "($%02X), Y", PEEK8   (pc+1));  break ;
+		case AM_ZPI :  sprintf(pDis->oper, "($%02X)"   , PEEK8   (pc+1));  break ;
+		case AM_IAX :  sprintf(pDis->oper, "($%04X, X)", PEEK16LE(pc+1));  break ;
+		case AM_ZPR :  sprintf(pDis->oper, "$%02X, lbl", PEEK8   (pc+1));  break ;
+		case AM_SR  :  sprintf(pDis->oper, "$%02X, S"  , PEEK8   (pc+1));  break ;
+		case AM_SRIY:  sprintf(pDis->oper, "($%02X, S), Y", PEEK8(pc+1));  break ;
+		case AM_DIL :  sprintf(pDis->oper, "[$%02X]"   , PEEK8   (pc+1));  break ;
+		case AM_DILY:  sprintf(pDis->oper, "[$%02X], Y", PEEK8   (pc+1));  break ;
+		case AM_LNG :  sprintf(pDis->oper, "$%02X%04X" , PEEK8(pc+3), PEEK16LE(pc+1));  break ;
+		case AM_LNGX:  sprintf(pDis->oper, "$%02X%04X, X", PEEK8(pc+3), PEEK16LE(pc+1));  break ;
+		case AM_RELL:  sprintf(pDis->oper, "lbl"                       );  break ;
+		case AM_BLK :  sprintf(pDis->oper, "$%02X, $%02X", PEEK8(pc+2), PEEK8(pc+1));  break ;
+		case AM_IL  :  sprintf(pDis->oper, "[$%04X]"   , PEEK16LE(pc+1));  break ;
+		default:       sprintf(pDis->oper, "???"                       );  break ;
+	}                                                                  
+
+	pDis->len    = pDec->len;     // iLen
+	pDis->t      = pDec->t;       // TCnt
+	pDis->flg[0] = pDec->flg[0];  // clear
+	pDis->flg[1] = pDec->flg[1];  // set
+	pDis->flg[2] = pDec->flg[2];  // modify
+
+	return *pDec;
+}
@@ -0,0 +1,284 @@
+//----------------------------------------------------------------------------- ----------------------------------------
+// Cycle profiler  (see 6502-prof.h)
+//
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "6502.h"
+#include "6502-prof.h"
+
+//+============================================================================ ========================================
+prof_t*  prof_new (void)
+{
+	prof_t*  pf = malloc(sizeof(*pf));
+
+	if (pf)  prof_clear(pf) ;
+	return pf;
+}
+
+//+============================================================================ ========================================
+void  prof_free (prof_t* pf)
+{
+	free(pf);
+}
+
+//+============================================================================ ========================================
+void  prof_clear (prof_t* pf)
+{
+	memset(pf, 0, sizeof(*pf));
+	pf->nnode = 1;                                          // The root
+	pf->node[0].calls = 1;
+}
+
+//----------------------------------------------------------------------------- ----------------------------------------
+// Call tree
+//
+//+============================================================================ ========================================
+// Close every frame the stack pointer has gone back past  (S is 's' once they have returned)
+//
+static  void  unwind (prof_t* pf,  uint8_t s,  uint64_t cyc)
+{
+	while (pf->depth && (pf->stk[pf->depth - 1].s <= s)) {
+		pf->depth--;
+		if (pf->stk[pf->depth].node < PROF_NODES)  pf->node[pf->stk[pf->depth].node].cyc += cyc - pf->stk[pf->depth].t0 ;
+	}
+}
+
+//+============================================================================ ========================================
+void  prof_ret (prof_t* pf,  uint8_t s,  uint64_t cyc)
+{
+	unwind(pf, s, cyc);
+}
+
+//+============================================================================ ========================================
+void  prof_call (prof_t* pf,  uint16_t to,  prof_kind_t kind,  uint8_t s,  uint64_t cyc)
+{
+	uint32_t  up, nd;
+
+	unwind(pf, s, cyc);                                     // Frames that were left without a return
+	if (pf->depth == PROF_DEPTH)  {  pf->lost++;  return;  }
+
+	up = pf->depth ? pf->stk[pf->depth - 1].node : 0;
+	nd = PROF_NODES;
+	if (up < PROF_NODES) {
+		for (nd = pf->node[up].child;  nd && ((pf->node[nd].addr != to) || (pf->node[nd].kind != kind));  nd = pf->node[nd].sib) ;
+		if (!nd && (pf->nnode < PROF_NODES)) {
+			nd = pf->nnode++;
+			pf->node[nd] = (prof_node_t){ .parent = up,  .sib = pf->node[up].child,  .addr = to,  .kind = kind };
+			pf->node[up].child = nd;
+		}
+		if (nd)  pf->node[nd].calls++ ;
+		else     nd = PROF_NODES,  pf->lost++ ;
+	}
+
+	pf->stk[pf->depth].node = nd;
+	pf->stk[pf->depth].s    = s;
+	pf->stk[pf->depth].t0   = cyc;
+	pf->depth++;
+}
+
+//+============================================================================ ========================================
+// Total cycles of every node  (the root : the whole profile; calls still open count up to the end of the last run)
+//
+static  uint64_t*  totals (const prof_t* pf)
+{
+	uint64_t*  tot = malloc(pf->nnode * sizeof(*tot));
+
+	if (!tot)  return NULL ;
+	for (uint32_t i = 0;  i < pf->nnode;  i++)  tot[i] = pf->node[i].cyc ;
+	tot[0] = pf->cyc1 - pf->cyc0;
+	for (uint32_t d = 0;  d < pf->depth;  d++)
+		if (pf->stk[d].node < PROF_NODES)  tot[pf->stk[d].node] += pf->cyc1 - pf->stk[d].t0 ;
+	return tot;
+}
+
+//+============================================================================ ========================================
+static  uint64_t  self (const prof_t* pf,  const uint64_t* tot,  uint32_t nd)
+{
+	uint64_t  ch = 0;
+
+	for (uint32_t k = pf->node[nd].child;  k;  k = pf->node[k].sib)  ch += tot[k] ;
+	return (tot[nd] > ch) ? tot[nd] - ch : 0;
+}
+
+//+============================================================================ ========================================
+static  int  name (char* buf,  const prof_node_t* n)
+{
+	static const char* const  pfx[] = { [PROF_JSR] = "sub", [PROF_BRK] = "brk", [PROF_IRQ] = "irq", [PROF_NMI] = "nmi" };
+
+	if (n->kind == PROF_ROOT)  return sprintf(buf, "main") ;
+	return sprintf(buf, "%s_%04X", pfx[n->kind], n->addr);
+}
+
+//----------------------------------------------------------------------------- ----------------------------------------
+// Call tree report
+//
+typedef
+	struct byc {
+		uint64_t  cyc;
+		uint32_t  nd;
+	}
+byc_t;
+
+// qsort: most cycles first
+static  int  byc_more (const void* a,  const void* b)
+{
+	uint64_t  ca = ((const byc_t*)a)->cyc,  cb = ((const byc_t*)b)->cyc;
+
+	return (ca < cb) - (ca > cb);
+}
+
+//+============================================================================ ========================================
+static  void  tree (const prof_t* pf,  const uint64_t* tot,  uint32_t nd,  int lvl,  FILE* fh)
+{
+	double    all = tot[0] ? tot[0] : 1;
+	uint32_t  nch = 0;
+	byc_t*    ch;
+	char      nm[16];
+
+	name(nm, &pf->node[nd]);
+	fprintf(fh, "%10llu %14llu %5.1f%% %14llu %5.1f%%  %*s%s\n",
+	        (unsigned long long)pf->node[nd].calls, (unsigned long long)tot[nd], 100 * tot[nd] / all,
+	        (unsigned long long)self(pf, tot, nd), 100 * self(pf, tot, nd) / all, lvl * 2, "", nm);
+
+	for (uint32_t k = pf->node[nd].child;  k;  k = pf->node[k].sib)  nch++ ;
+	if (!nch || !(ch = malloc(nch * sizeof(*ch))))  return ;
+	nch = 0;
+	for (uint32_t k = pf->node[nd].child;  k;  k = pf->node[k].sib)  ch[nch++] = (byc_t){ tot[k], k } ;
+	qsort(ch, nch, sizeof(*ch), byc_more);
+
+	for (uint32_t i = 0;  i < nch;  i++)  tree(pf, tot, ch[i].nd, lvl + 1, fh) ;
+	free(ch);
+}
+
+//+============================================================================ ========================================
+void  prof_tree (const prof_t* pf,  FILE* fh)
+{
+	uint64_t*  tot = totals(pf);
+
+	if (!tot)  return ;
+	fprintf(fh, "%10s %14s %6s %14s %6s  %s\n", "calls", "cycles", "", "self", "", "call path");
+	tree(pf, tot, 0, 0, fh);
+	if (pf->lost)  fprintf(fh, "(%llu calls past the table were charged to their caller)\n", (unsigned long long)pf->lost) ;
+	free(tot);
+}
+
+//----------------------------------------------------------------------------- ----------------------------------------
+// Folded stacks : one line per call path with self cycles, the path from the root joined by ';'
+//
+//+============================================================================ ========================================
+static  void  folded (const prof_t* pf,  const uint64_t* tot,  uint32_t nd,  char* path,  int len,  FILE* fh)
+{
+	uint64_t  cyc;
+
+	len += name(path + len, &pf->node[nd]);
+	if ((cyc = self(pf, tot, nd)))  fprintf(fh, "%s %llu\n", path, (unsigned long long)cyc) ;
+
+	path[len++] = ';';
+	for (uint32_t k = pf->node[nd].child;  k;  k = pf->node[k].sib)  folded(pf, tot, k, path, len, fh) ;
+}
+
+//+============================================================================ ========================================
+void  prof_folded (const prof_t* pf,  FILE* fh)
+{
+	uint64_t*  tot  = totals(pf);
+	char*      path = malloc((PROF_DEPTH + 1) * 16);
+
+	if (tot && path)  folded(pf, tot, 0, path, 0, fh) ;
+	free(path);
+	free(tot);
+}
+
+//----------------------------------------------------------------------------- ----------------------------------------
+// Basic blocks
+//
+// Worked out from the profile itself : a run of executed instructions that all ran the same number of times, up to
+// the first that can transfer control.  (The code may have changed since it ran - m is only used to find the lengths)
+//
+typedef
+	struct blk {
+		uint16_t  start, last;     // First & last instruction
+		uint64_t  n, cyc;
+	}
+blk_t;
+
+// qsort: most cycles first
+static  int  blk_more (const void* a,  const void* b)
+{
+	uint64_t  ca = ((const blk_t*)a)->cyc,  cb = ((const blk_t*)b)->cyc;
+
+	return (ca < cb) - (ca > cb);
+}
+
+//+============================================================================ ========================================
+static  int  ends_block (uint8_t op)
+{
+	const decode_t*  d = &op2i[op];
+
+	return !d->len || (d->am == AM_REL) || (d->mnem == MN_JMP) || (d->mnem == MN_JSR) ||
+	       (d->mnem == MN_RTS) || (d->mnem == MN_RTI) || (d->mnem == MN_BRK);
+}
+
+//+============================================================================ ========================================
+static  int  ins_len (const uint8_t* m,  uint16_t ad)
+{
+	return op2i[m[ad]].len ? op2i[m[ad]].len : 1;
+}
+
+//+============================================================================ ========================================
+void  prof_blocks (const prof_t* pf,  const uint8_t* m,  int top,  FILE* fh)
+{
+	uint8_t*  used = calloc(0x10000, 1);                    // Already in a block
+	blk_t*    blk  = malloc(0x10000 * sizeof(*blk));
+	uint32_t  nblk = 0;
+	uint64_t  all  = 0;
+
+	if (!used || !blk)  goto done ;
+
+	for (uint32_t ad = 0;  ad < 0x10000;  ad++) {
+		blk_t*  b = &blk[nblk];
+
+		if (!pf->pc[ad].n || used[ad])  continue ;
+		*b = (blk_t){ .start = ad,  .last = ad,  .n = pf->pc[ad].n };
+		for (uint32_t i = ad; ; ) {
+			used[i]  = 1;
+			b->last  = i;
+			b->cyc  += pf->pc[i].cyc;
+			if (ends_block(m[i]))  break ;
+			i += ins_len(m, i);
+			if ((i > 0xFFFF) || used[i] || (pf->pc[i].n != b->n))  break ;
+		}
+		all += b->cyc;
+		nblk++;
+	}
+	qsort(blk, nblk, sizeof(*blk), blk_more);
+
+	if (!all)  all = 1 ;
+	for (uint32_t k = 0;  (k < nblk) && ((int)k < top);  k++) {
+		const blk_t*  b = &blk[k];
+
+		fprintf(fh, "\n$%04X-$%04X  %llu cycles  %.1f%%  ran %llu times, %.2f cycles per pass\n",
+		        b->start, b->last, (unsigned long long)b->cyc, 100.0 * b->cyc / all,
+		        (unsigned long long)b->n, (double)b->cyc / b->n);
+
+		for (uint32_t i = b->start;  i <= b->last;  i += ins_len(m, i)) {
+			uint8_t   ins[3] = { m[i],  m[(uint16_t)(i + 1)],  m[(uint16_t)(i + 2)] };
+			disasm_t  dis;
+			char      hex[12];
+			int       len = decode(ins, &dis).len;
+
+			if (dis.am == AM_REL)  sprintf(dis.oper, "$%04X", (uint16_t)(i + 2 + (int8_t)ins[1])) ;
+			if (!len)  strcpy(dis.mnem, "???"),  *dis.oper = '\0',  len = 1 ;
+			for (int j = 0;  j < 3;  j++)  sprintf(hex + j * 3, (j < len) ? "%02X " : "   ", ins[j]) ;
+
+			fprintf(fh, "  %14llu %5.1f%%  %04X  %s %-4s %s\n",
+			        (unsigned long long)pf->pc[i].cyc, 100.0 * pf->pc[i].cyc / all, i, hex, dis.mnem, dis.oper);
+		}
+	}
+
+done:
+	free(blk);
+	free(used);
+}
@@ -0,0 +1,85 @@
+#ifndef  _6502_PROF_H_
+#define  _6502_PROF_H_
+
+//----------------------------------------------------------------------------- ----------------------------------------
+#include <stdint.h>
+#include <stdio.h>
+
+#include "6502.h"
+
+//----------------------------------------------------------------------------- ----------------------------------------
+// Cycle profiler
+//
+// cpu_run_prof() charges every instruction to the address it started at : one more execution, and the cycles it
+// actually took  (base, page crossing [1] & branch [2] included).  That is two adds into a flat 64K table - it is a core
+// of its own, so the other cores do not pay anything for it.
+//
+// JSR, BRK & interrupts also open a frame of the call tree, and RTS / RTI close every frame whose return address they
+// have pulled  (the stack pointer says which) - so a subroutine that drops its return address, or an RTS used as a
+// jump, does not derail it.  A node of the tree is a call path : it keeps how often it was entered & the cycles from
+// entry to return  (self cycles are that less its children).
+//
+#define PROF_NODES  (16384)        // Call paths  (then new paths are charged to their caller)
+#define PROF_DEPTH  (128)          // Frames  (as many JSRs as the stack page holds)
+
+typedef
+	enum prof_kind {
+		PROF_ROOT = 0,             // Not in any call
+		PROF_JSR,
+		PROF_BRK,
+		PROF_IRQ,
+		PROF_NMI,
+	}
+prof_kind_t;
+
+typedef
+	struct prof_node {
+		uint32_t  parent;
+		uint32_t  child, sib;      // First child, next sibling  (0 -> none; node 0 is the root)
+		uint16_t  addr;            // Entry point
+		uint8_t   kind;            // prof_kind_t
+		uint64_t  calls;
+		uint64_t  cyc;             // Entry to return, of the calls that have returned
+	}
+prof_node_t;
+
+typedef
+	struct prof {
+		struct {
+			uint64_t  n;           // Executions
+			uint64_t  cyc;         // ...and the cycles they took
+		} pc[0x10000];
+
+		uint64_t  cyc0, cyc1;      // c->cyc as the first run started & as the last one finished
+		uint16_t  lpc;             //   ...and PC & S at the end of the last one  (to spot an interrupt in between)
+		uint8_t   ls;
+		uint8_t   seen;            // !0 -> a run has finished
+
+		uint32_t  depth;
+		struct {
+			uint32_t  node;        // PROF_NODES -> not charged  (the table was full)
+			uint8_t   s;           // S once it has returned
+			uint64_t  t0;          // Cycle count on entry
+		} stk[PROF_DEPTH];
+
+		uint32_t  nnode;
+		uint64_t  lost;            // Calls past PROF_NODES / PROF_DEPTH
+		prof_node_t  node[PROF_NODES];
+	}
+prof_t;
+
+//----------------------------------------------------------------------------- ----------------------------------------
+prof_t*  prof_new    (void) ;                              // -> NULL (errno)
+void     prof_free   (prof_t* pf) ;
+void     prof_clear  (prof_t* pf) ;
+
+// Called by the profiling core  (cyc : the cycle count once the JSR/BRK/RTS/RTI itself is done)
+void     prof_call   (prof_t* pf,  uint16_t to,  prof_kind_t kind,  uint8_t s,  uint64_t cyc) ;     // s : S after the return
+void     prof_ret    (prof_t* pf,  uint8_t s,  uint64_t cyc) ;
+
+// Reports  (m : the memory the code ran from, for decode())
+void     prof_blocks (const prof_t* pf,  const uint8_t* m,  int top,  FILE* fh) ;  // Hottest basic blocks, disassembled
+void     prof_tree   (const prof_t* pf,  FILE* fh) ;                              // Call tree : calls, total & self cycles
+void     prof_folded (const prof_t* pf,  FILE* fh) ;                              // "main;sub_C010;sub_C200 1234" lines
+                                                                                  //   (flamegraph.pl, inferno, speedscope)
+#endif //_6502_PROF_H_
@@ -0,0 +1,101 @@
+// gcc  6502-replay.c  6502-trace.c  6502-cpu.c  6502-bus.c  6502-prof.c  6502-op2i.c  -o replay  -O2  -pthread
+//   ./replay file.trc                  : every instruction in the trace  (see ./emu -t)
+//   ./replay file.trc -i n [count]     : 'count' instructions from instruction n
+//   ./replay file.trc -c cyc [count]   : 'count' instructions from the first that starts at or after cycle 'cyc'
+//   ./replay -s file.trc               : summary : chunks, instructions, cycles, bytes per instruction
+//
+// One line per instruction :  instruction#  cycle  PC  bytes  disassembly  registers (as it starts)
+// (the trace holds the state at either end of each run, each instruction's extra cycles & I/O reads - the instructions
+// are run again by this build's core, see 6502-trace.h.  Not seen :  I/O handlers that write memory themselves, or
+// patch the live bus map mid-run)
+
+//----------------------------------------------------------------------------- ----------------------------------------
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "6502.h"
+#include "6502-trace.h"
+
+//+============================================================================ ========================================
+static  void  show (const trace_rec_t* r)
+{
+	disasm_t  dis;
+	uint8_t   ins[3];
+	char      hex[12];
+	int       len;
+
+	memcpy(ins, r->ins, 3);
+	len = decode(ins, &dis).len;
+	if (dis.am == AM_REL)  sprintf(dis.oper, "$%04X", (uint16_t)(r->pc + 2 + (int8_t)ins[1])) ;
+	if (!len)  strcpy(dis.mnem, "???"),  *dis.oper = '\0',  len = 1 ;
+
+	for (int i = 0;  i < 3;  i++)  sprintf(hex + i * 3, (i < len) ? "%02X " : "   ", ins[i]) ;
+
+	printf("%12llu %14llu  %04X  %s %-4s %-10s  A=%02X X=%02X Y=%02X S=%02X P=",
+	       (unsigned long long)r->n, (unsigned long long)r->cyc, r->pc, hex, dis.mnem, dis.oper, r->a, r->x, r->y, r->s);
+	for (int j = 7;  j >= 0;  j--)  putchar((r->p & (1 << j)) ? "CZIDB-VN"[j] : "czidb-vn"[j]) ;
+	putchar('\n');
+}
+
+//+============================================================================ ========================================
+static  int  summary (const char* fn)
+{
+	trace_rd_t*  rd;
+	trace_rec_t  r = {0}, first = {0};
+	uint64_t     n = 0;
+	FILE*        fh;
+	long         sz = 0;
+	int          rv;
+
+	if (!(rd = trace_rd_open(fn)))  return perror(fn), 1 ;
+	if ((fh = fopen(fn, "rb")))  fseek(fh, 0, SEEK_END),  sz = ftell(fh),  fclose(fh) ;
+
+	while ((rv = trace_next(rd, &r)) == 1)  if (!n++)  first = r ;
+	if (rv < 0)  fprintf(stderr, "%s: corrupt after instruction %llu\n", fn, (unsigned long long)n) ;
+
+	printf("%llu chunks, %llu instructions", (unsigned long long)rd->nidx, (unsigned long long)n);
+	if (n)  printf(", cycles %llu..%llu, %.3f bytes/instruction",
+	               (unsigned long long)first.cyc, (unsigned long long)r.cyc, (double)sz / n) ;
+	putchar('\n');
+
+	trace_rd_close(rd);
+	return rv < 0;
+}
+
+//+============================================================================ ========================================
+int  main (int argc,  char* argv[])
+{
+	trace_rd_t*  rd;
+	trace_rec_t  r;
+	uint64_t     cnt = UINT64_MAX;
+	int          rv  = 0;
+
+	if ((argc == 3) && !strcmp(argv[1], "-s"))  return summary(argv[2]) ;
+	if ((argc != 2) && (argc != 4) && (argc != 5)) {
+		fprintf(stderr, "use: %s file.trc [-i n | -c cyc] [count]  |  %s -s file.trc\n"
+		                "     (instructions are run again :  registers & memory are as this build's core has them,\n"
+		                "      cycles & I/O reads as recorded;  I/O handlers that write memory or patch the live map\n"
+		                "      mid-run are not seen)\n", argv[0], argv[0]);
+		return 1;
+	}
+
+	if (!(rd = trace_rd_open(argv[1])))  return perror(argv[1]), 1 ;
+
+	if (argc >= 4) {
+		uint64_t  v = strtoull(argv[3], NULL, 0);
+
+		if      (!strcmp(argv[2], "-i"))  rv = trace_seek(rd, v) ;
+		else if (!strcmp(argv[2], "-c"))  rv = trace_seek_cyc(rd, v) ;
+		else                              return fprintf(stderr, "%s: unknown option %s\n", argv[0], argv[2]), 1 ;
+		if (rv)  return fprintf(stderr, "%s: past the end of the trace\n", argv[1]), 1 ;
+		if (argc == 5)  cnt = strtoull(argv[4], NULL, 0) ;
+	}
+
+	while (cnt-- && ((rv = trace_next(rd, &r)) == 1))  show(&r) ;
+	if (rv < 0)  fprintf(stderr, "%s: corrupt trace\n", argv[1]) ;
+
+	trace_rd_close(rd);
+	return rv < 0;
+}
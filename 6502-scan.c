@@ -0,0 +1,172 @@
+//----------------------------------------------------------------------------- ----------------------------------------
+// Instruction-boundary pre-scan
+//
+// The scalar sweep is a chain:  pos += len[buf[pos]]  - every step waits for the previous one.
+//
+// The vector path cuts the buffer into 64-byte windows and, for each window, independently of where the sweep enters it:
+//   1. len[] for all 64 bytes        : two VPERMI2B lookups (128 entries each) blended on bit 7 of the opcode
+//   2. next[i] = i + len[i]          : exits the window as 64..66
+//   3. J(2^b) = J(2^(b-1)) o J(2^(b-1)): pointer doubling with VPERMB, 6 rounds ->  where a sweep entering at ANY lane
+//                                      leaves the window  (so all sync offsets are resolved together)
+//   4. For each entry that is actually used, lane k of P = J^k(entry), built from the bits of k with the J(2^b) tables,
+//      is the k-th instruction start; those lanes become the window's bitmap.
+// The only serial work left is one table lookup per window per sync offset.
+//
+#include <stdint.h>
+#include <string.h>
+
+#include "6502.h"
+#include "6502-scan.h"
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#	include <immintrin.h>
+#	define SCAN_VBMI  1
+#	define SCAN_TGT   __attribute__((target("avx512f,avx512bw,avx512vbmi")))
+#else
+#	define SCAN_VBMI  0
+#endif
+
+//+============================================================================ ========================================
+// Step size of every opcode, as the sweep sees it  (invalid -> 1)
+//
+static inline  void  scan_lens (uint8_t lent[256])
+{
+	for (int i = 0;  i < 256;  i++)  lent[i] = op2i[i].len ? op2i[i].len : 1 ;
+}
+
+//+============================================================================ ========================================
+// Scalar sweep of buf[pos .. sz), ORing starts into bits
+//
+static inline  void  scan_run (const uint8_t* buf,  size_t sz,  size_t pos,  const uint8_t lent[256],  uint64_t* bits)
+{
+	while (pos < sz) {
+		size_t  l = lent[buf[pos]];
+
+		bits[pos >> 6] |= 1ULL << (pos & 63);
+		pos += (pos + l > sz) ? 1 : l;                  // Truncated by the end of the buffer
+	}
+}
+
+//+============================================================================ ========================================
+void  scan_starts_scalar (const uint8_t* buf,  size_t sz,  const size_t* sync,  int nsync,  uint64_t** bits)
+{
+	uint8_t  lent[256];
+
+	scan_lens(lent);
+	for (int k = 0;  k < nsync;  k++)  scan_run(buf, sz, sync[k], lent, bits[k]) ;
+}
+
+#if SCAN_VBMI
+//+============================================================================ ========================================
+// Bitmap of the starts in one window for a sweep that enters at lane 'e'
+//   jp[b] : J(2^b)
+//
+SCAN_TGT
+static inline  uint64_t  scan_window_bits (const __m512i jp[6],  unsigned e)
+{
+	static const uint64_t  kbit[6] = {                 // Lanes whose index has bit b set
+		0xAAAAAAAAAAAAAAAAULL, 0xCCCCCCCCCCCCCCCCULL, 0xF0F0F0F0F0F0F0F0ULL,
+		0xFF00FF00FF00FF00ULL, 0xFFFF0000FFFF0000ULL, 0xFFFFFFFF00000000ULL,
+	};
+	__m512i  p   = _mm512_set1_epi8(e);
+	__m512i  acc = _mm512_setzero_si512();
+	__m512i  one = _mm512_set1_epi64(1);
+	__m512i  lim = _mm512_set1_epi8(64);
+	uint8_t  lane[64];
+
+	for (int b = 0;  b < 6;  b++) {
+		__mmask64  m = kbit[b] & _mm512_cmplt_epu8_mask(p, lim);      // Still inside the window
+		p = _mm512_mask_permutexvar_epi8(p, m, p, jp[b]);
+	}
+
+	// OR together (1 << p[k]) - lanes that have left the window shift out to nothing
+	_mm512_storeu_si512(lane, p);
+	for (int g = 0;  g < 64;  g += 8)
+		acc = _mm512_or_si512(acc, _mm512_sllv_epi64(one, _mm512_cvtepu8_epi64(_mm_loadl_epi64((const __m128i*)(lane + g)))));
+	return _mm512_reduce_or_epi64(acc);
+}
+
+//+============================================================================ ========================================
+SCAN_TGT
+static  void  scan_starts_vbmi (const uint8_t* buf,  size_t sz,  const size_t* sync,  int nsync,  uint64_t** bits)
+{
+	static const uint8_t  idx[64] = {
+		 0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31,
+		32, 33, 34, 35, 36, 37, 38, 39, 40, 41, 42, 43, 44, 45, 46, 47, 48, 49, 50, 51, 52, 53, 54, 55, 56, 57, 58, 59, 60, 61, 62, 63,
+	};
+	uint8_t   lent[256];
+	size_t    pos[SCAN_SYNC_MAX];
+	size_t    nwin = (sz >= 2) ? (sz - 2) / 64 : 0;     // Windows that no instruction can run off the end of
+	size_t    w    = SIZE_MAX;
+	__m512i   t0, t1, t2, t3, iota, lim;
+
+	scan_lens(lent);
+	t0   = _mm512_loadu_si512(lent +   0);
+	t1   = _mm512_loadu_si512(lent +  64);
+	t2   = _mm512_loadu_si512(lent + 128);
+	t3   = _mm512_loadu_si512(lent + 192);
+	iota = _mm512_loadu_si512(idx);
+	lim  = _mm512_set1_epi8(64);
+
+	for (int k = 0;  k < nsync;  k++) {
+		pos[k] = sync[k];
+		if ((pos[k] >> 6) < w)  w = pos[k] >> 6 ;
+	}
+
+	for (;  w < nwin;  w++) {
+		const uint8_t*  src = buf + (w << 6);
+		size_t          base = w << 6;
+		__m512i         x, l, j, jp[6];
+		uint8_t         out[64];
+		int             live = 0;
+
+		for (int k = 0;  k < nsync;  k++)  live |= ((pos[k] >> 6) == w) ;
+		if (!live)  continue ;
+
+		// 1 & 2 : next[]
+		x = _mm512_loadu_si512(src);
+		l = _mm512_mask_blend_epi8(_mm512_movepi8_mask(x), _mm512_permutex2var_epi8(t0, x, t1),
+		                                                   _mm512_permutex2var_epi8(t2, x, t3));
+		j = _mm512_add_epi8(iota, l);
+
+		// 3 : doubling  (J(64) is where every entry leaves the window)
+		for (int b = 0;  b < 6;  b++) {
+			jp[b] = j;
+			j = _mm512_mask_permutexvar_epi8(j, _mm512_cmplt_epu8_mask(j, lim), j, j);
+		}
+		_mm512_storeu_si512(out, j);
+
+		// 4 : bitmaps, and the next window's entry
+		for (int k = 0;  k < nsync;  k++) {
+			if ((pos[k] >> 6) != w)  continue ;
+			bits[k][w] |= scan_window_bits(jp, pos[k] - base);
+			pos[k] = base + out[pos[k] - base];
+		}
+	}
+
+	for (int k = 0;  k < nsync;  k++)  scan_run(buf, sz, pos[k], lent, bits[k]) ;
+}
+#endif
+
+//+============================================================================ ========================================
+int  scan_simd (void)
+{
+#if SCAN_VBMI
+	return __builtin_cpu_supports("avx512vbmi") && __builtin_cpu_supports("avx512bw");
+#else
+	return 0;
+#endif
+}
+
+//+============================================================================ ========================================
+void  scan_starts (const uint8_t* buf,  size_t sz,  const size_t* sync,  int nsync,  uint64_t** bits)
+{
+	if (nsync > SCAN_SYNC_MAX)  nsync = SCAN_SYNC_MAX ;
+#if SCAN_VBMI
+	if (scan_simd()) {
+		scan_starts_vbmi(buf, sz, sync, nsync, bits);
+		return;
+	}
+#endif
+	scan_starts_scalar(buf, sz, sync, nsync, bits);
+}
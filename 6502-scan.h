@@ -0,0 +1,27 @@
+#ifndef  _6502_SCAN_H_
+#define  _6502_SCAN_H_
+
+//----------------------------------------------------------------------------- ----------------------------------------
+#include <stddef.h>
+#include <stdint.h>
+
+#include "6502.h"
+
+//----------------------------------------------------------------------------- ----------------------------------------
+// Instruction-boundary pre-scan
+//
+// Marks where a linear sweep (as disasm_image() does it) starts each instruction, for several sync offsets at once.
+// An invalid opcode, or an instruction cut off by the end of the buffer, is a 1-byte step  (".byte $xx").
+//
+//   bits[k] : (sz + 63) / 64 words, bit (i % 64) of word (i / 64) set -> an instruction starts at buf[i]
+//             (the caller clears it; bits before sync[k] are never touched)
+//
+// scan_starts() uses the vector path when the CPU has one  (AVX-512 VBMI: 64 bytes per step), else the scalar path.
+//
+#define SCAN_SYNC_MAX  (8)
+
+void  scan_starts        (const uint8_t* buf,  size_t sz,  const size_t* sync,  int nsync,  uint64_t** bits) ;
+void  scan_starts_scalar (const uint8_t* buf,  size_t sz,  const size_t* sync,  int nsync,  uint64_t** bits) ;
+int   scan_simd          (void) ;                 // !0 -> scan_starts() is vectorised on this CPU
+
+#endif //_6502_SCAN_H_
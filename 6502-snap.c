@@ -0,0 +1,202 @@
+//----------------------------------------------------------------------------- ----------------------------------------
+// Checkpoint / restore  (see 6502-snap.h)
+//
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+
+#include "6502-cpu.h"
+#include "6502-snap.h"
+
+#define SNAP_MAGIC  "6502SNAP"
+#define SNAP_VER    (1)
+#define SNAP_HDR    (8 + 1 + 6 + 2 + 8 + 32)   // magic, version, a x y s p jam, pc, cyc, page bitmap
+
+//+============================================================================ ========================================
+static  void  regs_get (snap_regs_t* r,  const cpu_t* c)
+{
+	*r = (snap_regs_t){c->a, c->x, c->y, c->s, c->p, c->jam, c->pc, c->cyc};
+}
+
+static  void  regs_put (cpu_t* c,  const snap_regs_t* r)
+{
+	c->a   = r->a;
+	c->x   = r->x;
+	c->y   = r->y;
+	c->s   = r->s;
+	c->p   = r->p;
+	c->jam = r->jam;
+	c->pc  = r->pc;
+	c->cyc = r->cyc;
+}
+
+//+============================================================================ ========================================
+// Put page 'pg' back to 'src'  (and drop any cached blocks decoded from it)
+//
+static inline  void  page_put (cpu_t* c,  unsigned pg,  const uint8_t* src)
+{
+	memcpy(&c->mem[pg << 8], src, 256);
+	cpu_invalidate(c, pg << 8, (pg << 8) | 0xFF);
+}
+
+//+============================================================================ ========================================
+snap_t*  snap_new (cpu_t* c)
+{
+	snap_t*  sn = calloc(1, sizeof(*sn));
+
+	if (!sn)  return NULL ;
+	sn->c = c;
+	memcpy(sn->shadow, c->mem, sizeof(sn->shadow));
+	for (int pg = 0;  pg < 256;  pg++)  c->dirty[pg] &= ~DIRTY_SNAP ;
+	regs_get(&sn->lvl[0].r, c);
+	return sn;
+}
+
+//+============================================================================ ========================================
+void  snap_free (snap_t* sn)
+{
+	if (!sn)  return ;
+	for (int i = 0;  i < SNAP_DEPTH;  i++)  free(sn->lvl[i].undo) ;
+	free(sn);
+}
+
+//+============================================================================ ========================================
+int  snap_take (snap_t* sn)
+{
+	cpu_t*       c = sn->c;
+	snap_lvl_t*  l;
+	int          n = 0;
+
+	if (sn->top + 1 == SNAP_DEPTH)  return -1 ;
+	l = &sn->lvl[sn->top + 1];
+
+	for (int pg = 0;  pg < 256;  pg++)  n += !!(c->dirty[pg] & DIRTY_SNAP) ;
+	if (n > l->max) {                                       // Grow before anything moves
+		void*  u = realloc(l->undo, n * sizeof(*l->undo));
+
+		if (!u)  return -1 ;
+		l->undo = u;
+		l->max  = n;
+	}
+
+	l->n = 0;
+	for (int pg = 0;  pg < 256;  pg++) {
+		if (!(c->dirty[pg] & DIRTY_SNAP))  continue ;
+		l->pg[l->n] = pg;
+		memcpy(l->undo[l->n++], &sn->shadow[pg << 8], 256);
+		memcpy(&sn->shadow[pg << 8], &c->mem[pg << 8], 256);
+		c->dirty[pg] &= ~DIRTY_SNAP;
+	}
+
+	regs_get(&l->r, c);
+	return ++sn->top;
+}
+
+//+============================================================================ ========================================
+void  snap_restore (snap_t* sn)
+{
+	cpu_t*  c = sn->c;
+
+	for (int pg = 0;  pg < 256;  pg++) {
+		if (!(c->dirty[pg] & DIRTY_SNAP))  continue ;
+		page_put(c, pg, &sn->shadow[pg << 8]);
+		c->dirty[pg] &= ~DIRTY_SNAP;
+	}
+	regs_put(c, &sn->lvl[sn->top].r);
+}
+
+//+============================================================================ ========================================
+int  snap_drop (snap_t* sn)
+{
+	snap_lvl_t*  l = &sn->lvl[sn->top];
+
+	if (!sn->top)  return -1 ;
+	snap_restore(sn);
+
+	for (int i = 0;  i < l->n;  i++) {
+		memcpy(&sn->shadow[l->pg[i] << 8], l->undo[i], 256);
+		page_put(sn->c, l->pg[i], l->undo[i]);
+		sn->c->dirty[l->pg[i]] &= ~DIRTY_SNAP;
+	}
+	l->n = 0;
+
+	regs_put(sn->c, &sn->lvl[--sn->top].r);
+	return sn->top;
+}
+
+//+============================================================================ ========================================
+static  void  put16 (uint8_t* p,  uint16_t v)  {  p[0] = v;  p[1] = v >> 8;  }
+static  void  put64 (uint8_t* p,  uint64_t v)  {  for (int i = 0;  i < 8;  i++)  p[i] = v >> (i * 8) ;  }
+
+static  uint64_t  get64 (const uint8_t* p)
+{
+	uint64_t  v = 0;
+
+	for (int i = 7;  i >= 0;  i--)  v = (v << 8) | p[i] ;
+	return v;
+}
+
+//+============================================================================ ========================================
+// Pages that are all zero are left out
+//
+int  snap_save (const snap_t* sn,  const char* fn)
+{
+	const snap_regs_t*  r = &sn->lvl[sn->top].r;
+	uint8_t             hdr[SNAP_HDR] = {0};
+	uint8_t*            bm = hdr + SNAP_HDR - 32;
+	FILE*               fh;
+	int                 err;
+
+	memcpy(hdr, SNAP_MAGIC, 8);
+	hdr[8] = SNAP_VER;
+	memcpy(hdr + 9, (uint8_t[6]){r->a, r->x, r->y, r->s, r->p, r->jam}, 6);
+	put16(hdr + 15, r->pc);
+	put64(hdr + 17, r->cyc);
+
+	for (int pg = 0;  pg < 256;  pg++) {
+		const uint8_t*  src = &sn->shadow[pg << 8];
+
+		if (src[0] || memcmp(src, src + 1, 255))  bm[pg >> 3] |= 1 << (pg & 7) ;
+	}
+
+	if (!(fh = fopen(fn, "wb")))  return -1 ;
+	err = (fwrite(hdr, 1, SNAP_HDR, fh) != SNAP_HDR);
+	for (int pg = 0;  !err && (pg < 256);  pg++)
+		if (bm[pg >> 3] & (1 << (pg & 7)))  err = (fwrite(&sn->shadow[pg << 8], 1, 256, fh) != 256) ;
+	err |= (fclose(fh) != 0);
+
+	return err ? -1 : 0;
+}
+
+//+============================================================================ ========================================
+// The whole file is read aside first :  a short or bad one leaves c as it was
+//
+snap_t*  snap_load (cpu_t* c,  const char* fn)
+{
+	uint8_t      hdr[SNAP_HDR];
+	uint8_t*     bm = hdr + SNAP_HDR - 32;
+	uint8_t*     mem;
+	snap_regs_t  r;
+	FILE*        fh;
+	int          ok;
+
+	if (!(mem = calloc(1, sizeof(c->mem))))  return NULL ;
+	if (!(fh = fopen(fn, "rb")))  return free(mem), NULL ;
+
+	ok = (fread(hdr, 1, SNAP_HDR, fh) == SNAP_HDR) && !memcmp(hdr, SNAP_MAGIC, 8) && (hdr[8] == SNAP_VER);
+	for (int pg = 0;  ok && (pg < 256);  pg++)
+		if (bm[pg >> 3] & (1 << (pg & 7)))  ok = (fread(&mem[pg << 8], 1, 256, fh) == 256) ;
+	fclose(fh);
+	if (!ok)  return free(mem), errno = EINVAL, NULL ;
+
+	memcpy(c->mem, mem, sizeof(c->mem));
+	free(mem);
+	cpu_invalidate(c, 0x0000, 0xFFFF);
+
+	r = (snap_regs_t){hdr[9], hdr[10], hdr[11], hdr[12], hdr[13], hdr[14], hdr[15] | (hdr[16] << 8), get64(hdr + 17)};
+	regs_put(c, &r);
+
+	return snap_new(c);
+}
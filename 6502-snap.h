@@ -0,0 +1,63 @@
+#ifndef  _6502_SNAP_H_
+#define  _6502_SNAP_H_
+
+//----------------------------------------------------------------------------- ----------------------------------------
+#include <stdint.h>
+
+#include "6502-cpu.h"
+
+//----------------------------------------------------------------------------- ----------------------------------------
+// Checkpoint / restore of one cpu_t  (registers & c->mem)
+//
+// The cores mark every page they write in c->dirty[], the host marks its own writes with cpu_invalidate().
+// The snapshot keeps a shadow of memory as it was at the latest checkpoint, so:
+//   snap_restore() : copies back only the pages dirtied since the latest checkpoint   (repeat as often as you like)
+//   snap_take()    : copies only the dirty pages into the shadow, and keeps their old contents as the new level's
+//                    undo list, which is what lets snap_drop() step back out to the checkpoint below it
+// Only the first checkpoint (snap_new) copies all 64K.
+//
+// Memory behind a bus (c->bus) that is not c->mem is not part of the snapshot.
+//
+#define SNAP_DEPTH  (64)            // Nested checkpoints
+
+typedef
+	struct snap_regs {
+		uint8_t   a, x, y, s, p, jam;
+		uint16_t  pc;
+		uint64_t  cyc;
+	}
+snap_regs_t;
+
+typedef
+	struct snap_lvl {
+		snap_regs_t  r;                 // Registers at this checkpoint
+		int          n;                 // Pages in the undo list
+		int          max;
+		uint8_t      pg[256];           // Page numbers...
+		uint8_t    (*undo)[256];        // ...and their contents at the checkpoint below
+	}
+snap_lvl_t;
+
+typedef
+	struct snap {
+		cpu_t*      c;
+		int         top;                // Latest checkpoint
+		snap_lvl_t  lvl[SNAP_DEPTH];
+		uint8_t     shadow[0x10000];    // c->mem at the latest checkpoint
+	}
+snap_t;
+
+//----------------------------------------------------------------------------- ----------------------------------------
+snap_t*  snap_new     (cpu_t* c) ;                  // Checkpoint 0 is the machine as it is now
+void     snap_free    (snap_t* sn) ;
+
+int      snap_take    (snap_t* sn) ;                // -> depth of the new checkpoint, or -1 when SNAP_DEPTH is reached
+void     snap_restore (snap_t* sn) ;                // Back to the latest checkpoint
+int      snap_drop    (snap_t* sn) ;                // Back to the checkpoint below the latest, which is discarded
+                                                    //   -> new depth, or -1 at checkpoint 0
+
+// Latest checkpoint to/from a file :  "6502SNAP", version, registers, bitmap of non-zero pages, those pages
+int      snap_save    (const snap_t* sn,  const char* fn) ;       // -> 0, or -1 (errno)
+snap_t*  snap_load    (cpu_t* c,  const char* fn) ;               // Loads into c, with the file as checkpoint 0  (or NULL, c untouched)
+
+#endif //_6502_SNAP_H_
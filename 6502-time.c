@@ -0,0 +1,392 @@
+//----------------------------------------------------------------------------- ----------------------------------------
+// Static cycle-timing analysis
+//
+// Blocks are costed as a [min, max] cycle range, loop bodies as the [min, max] over the forward paths from the head
+// to the back edge.  Everything is worked out from op2i[].t :
+//   base  = t % 10
+//   [1]   : t >= 10  ->  +1 if the indexed address crosses a page
+//   [2]   : t >= 20  ->  +1 if the branch is taken, +1 more if it lands on a different page
+//
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "6502.h"
+#include "6502-flow.h"
+#include "6502-time.h"
+
+#define TM_NONE  (0xFFFF)           // No path
+
+//+============================================================================ ========================================
+// Does this instruction write the index register?   reg : 'X' / 'Y'
+//   A subroutine might do anything
+//
+static inline  int  tm_writes (insn_t in,  char reg)
+{
+	uint8_t  mn = op2i[in.op].mnem;
+
+	if (mn == MN_JSR)  return 1 ;
+	return (reg == 'X') ? (mn == MN_LDX) || (mn == MN_TAX) || (mn == MN_TSX) || (mn == MN_INX) || (mn == MN_DEX)
+	                    : (mn == MN_LDY) || (mn == MN_TAY) || (mn == MN_INY) || (mn == MN_DEY) ;
+}
+
+//+============================================================================ ========================================
+// What an instruction does to the range [lo, hi] of an index register
+//
+static  void  tm_range (insn_t in,  char reg,  uint8_t r[2])
+{
+	uint8_t  mn = op2i[in.op].mnem;
+	int      x  = (reg == 'X');
+
+	if (in.op == (x ? OP_LDX_IMM : OP_LDY_IMM)) {
+		r[0] = r[1] = in.oper;
+
+	} else if (mn == (x ? MN_INX : MN_INY)) {
+		if      (r[1] < 0xFF)    r[0]++,  r[1]++ ;
+		else if (r[0] == 0xFF)   r[0] = r[1] = 0x00 ;
+		else                     r[0] = 0,  r[1] = 0xFF ;
+
+	} else if (mn == (x ? MN_DEX : MN_DEY)) {
+		if      (r[0] > 0x00)    r[0]--,  r[1]-- ;
+		else if (r[1] == 0x00)   r[0] = r[1] = 0xFF ;
+		else                     r[0] = 0,  r[1] = 0xFF ;
+
+	} else if (tm_writes(in, reg)) {
+		r[0] = 0;
+		r[1] = 0xFF;
+	}
+}
+
+//+============================================================================ ========================================
+// Cost one block from its entry ranges
+//
+static  void  tm_cost (const flow_t* f,  tm_blk_t* b)
+{
+	uint8_t  xr[2] = {b->xr[0], b->xr[1]};
+	uint8_t  yr[2] = {b->yr[0], b->yr[1]};
+
+	b->min = b->max = 0;
+	b->nt  = b->tk  = 0;
+
+	for (size_t off = b->off;  off < b->end;  off += op2i[f->buf[off]].len) {
+		insn_t    in   = decode_insn(&f->buf[off]);
+		uint8_t   t    = op2i[in.op].t;
+		uint16_t  addr = flow_addr(f, off);
+
+		if (t >= 20) {                                             // [2] : branch, always the terminator
+			b->nt = t % 10;
+			b->tk = b->nt + 1 + (((addr + 2) ^ insn_target(in, addr)) >> 8 != 0);
+			continue;
+		}
+
+		b->min += t % 10;
+		b->max += t % 10;
+
+		if (t >= 10) {                                             // [1] : page crossing
+			const uint8_t*  r  = (in.am == AM_ABSX) ? xr : yr;
+			unsigned        lo = in.oper & 0xFF;
+
+			if (in.am == AM_INDY) {
+				b->max += (yr[1] != 0);                            // The pointer is not static, only Y = 0 is safe
+			} else {
+				b->min += (lo + r[0] > 0xFF);
+				b->max += (lo + r[1] > 0xFF);
+			}
+		}
+
+		tm_range(in, 'X', xr);
+		tm_range(in, 'Y', yr);
+	}
+
+	b->xo[0] = xr[0],  b->xo[1] = xr[1];
+	b->yo[0] = yr[0],  b->yo[1] = yr[1];
+}
+
+//+============================================================================ ========================================
+// Block starting at image offset 'off'  (-1 -> none)
+//
+static  long  tm_find (const timing_t* tm,  long off)
+{
+	size_t  lo = 0,  hi = tm->nblk;
+
+	if (off < 0)  return -1 ;
+	while (lo < hi) {
+		size_t  mid = (lo + hi) / 2;
+		if      (tm->blk[mid].off < (size_t)off)  lo = mid + 1 ;
+		else if (tm->blk[mid].off > (size_t)off)  hi = mid ;
+		else                                      return mid ;
+	}
+	return -1;
+}
+
+//+============================================================================ ========================================
+// Split the code into blocks
+//
+static  void  tm_blocks (timing_t* tm)
+{
+	const flow_t*  f    = tm->f;
+	tm_blk_t*      b    = NULL;
+	size_t         pend = 0;              // End of the last instruction
+
+	for (size_t off = 0;  off < f->sz;  ) {
+		uint8_t          cl   = f->cls[off];
+		const decode_t*  pDec = &op2i[f->buf[off]];
+
+		if ((cl & FL_CLS) != FL_CODE) {
+			if (b)  b->term = TM_STOP,  b = NULL ;               // Ran into data
+			off++;
+			continue;
+		}
+
+		if (b && ((cl & FL_LBL) || !(off % f->bsz)))  b->term = TM_FALL,  b = NULL ;
+
+		if (!b) {
+			b = &tm->blk[tm->nblk++];
+			memset(b, 0, sizeof(*b));
+			b->off = off;
+			b->tgt = -1;
+		}
+
+		b->n++;
+		pend   = off + pDec->len;
+		b->end = pend;
+
+		if (pDec->am == AM_REL) {
+			b->term = TM_BR;
+			b->tgt  = flow_off(f, off / f->bsz, insn_target(decode_insn(&f->buf[off]), flow_addr(f, off)));
+			b       = NULL;
+		} else if (f->buf[off] == OP_JMP_ABS) {
+			b->term = TM_JMP;
+			b->tgt  = flow_off(f, off / f->bsz, PEEK16LE(&f->buf[off + 1]));
+			b       = NULL;
+		} else if ((pDec->mnem == MN_JMP) || (pDec->mnem == MN_RTS) || (pDec->mnem == MN_RTI) || (pDec->mnem == MN_BRK)) {
+			b->term = TM_STOP;
+			b       = NULL;
+		}
+
+		off = pend;
+	}
+	if (b)  b->term = TM_STOP ;
+}
+
+//+============================================================================ ========================================
+// Does block 'i' pass control to block 'j'?
+//
+static  int  tm_goes (const timing_t* tm,  size_t i,  size_t j)
+{
+	const tm_blk_t*  b = &tm->blk[i];
+
+	if (((b->term == TM_FALL) || (b->term == TM_BR)) && (j == i + 1) && (b->end == tm->blk[j].off))  return 1 ;
+	if (((b->term == TM_BR) || (b->term == TM_JMP)) && (tm_find(tm, b->tgt) == (long)j))  return 1 ;
+	return 0;
+}
+
+//+============================================================================ ========================================
+// Is latch -> head a back edge?  ie. can the latch be reached from the head without leaving head..latch
+//
+static  int  tm_back (const timing_t* tm,  size_t head,  size_t latch)
+{
+	size_t    nb   = latch - head + 1;
+	uint8_t*  seen = calloc(nb, 1);
+	int       more = 1;
+	int       r;
+
+	if (!seen)  return 0 ;
+	seen[0] = 1;
+	while (more && !seen[nb - 1]) {                              // Again only if something in the body branched backwards
+		more = 0;
+		for (size_t i = 0;  i < nb - 1;  i++) {
+			const tm_blk_t*  b = &tm->blk[head + i];
+			long             j;
+
+			if (!seen[i])  continue ;
+			if (tm_goes(tm, head + i, head + i + 1))  seen[i + 1] = 1 ;
+			if (((b->term == TM_BR) || (b->term == TM_JMP)) && ((j = tm_find(tm, b->tgt)) > (long)head) && ((size_t)j <= latch))
+				if (!seen[j - head])  seen[j - head] = 1,  more |= ((size_t)j < head + i) ;
+		}
+	}
+	r = seen[nb - 1];
+	free(seen);
+	return r;
+}
+
+//+============================================================================ ========================================
+// Index range of a counted loop body
+//   The register must be a constant on the way in, and written only by the INx/DEx next to the back edge.
+//   The head may only be entered by falling in from the block before it, or from the latch.
+//
+static  void  tm_counted (timing_t* tm,  tm_loop_t* lp)
+{
+	const flow_t*    f  = tm->f;
+	const tm_blk_t*  h  = &tm->blk[lp->head];
+	const tm_blk_t*  l  = &tm->blk[lp->latch];
+	const tm_blk_t*  pre;
+	insn_t           last[3] = {{0}};                       // [2] is the back edge
+	size_t           at[3]   = {0};
+
+	if (!lp->head)  return ;
+	pre = h - 1;
+	if (!tm_goes(tm, lp->head - 1, lp->head))  return ;
+	if (tm->f->cls[h->off] & (FL_SUB | FL_ENT))  return ;        // Also reached from outside the code
+	for (size_t i = 0;  i < tm->nblk;  i++)
+		if ((i != lp->head - 1) && (i != lp->latch) && tm_goes(tm, i, lp->head))  return ;
+
+	for (size_t off = l->off;  off < l->end;  off += op2i[f->buf[off]].len) {
+		last[0] = last[1],  at[0] = at[1];
+		last[1] = last[2],  at[1] = at[2];
+		last[2] = decode_insn(&f->buf[off]),  at[2] = off;
+	}
+	if (last[2].am != AM_REL)  return ;
+
+	for (char reg = 'X';  reg <= 'Y';  reg++) {
+		const uint8_t*  k    = (reg == 'X') ? pre->xo : pre->yo;
+		uint8_t         cpi  = (reg == 'X') ? OP_CPX_IMM : OP_CPY_IMM;
+		uint8_t         inc  = (reg == 'X') ? OP_INX_IMP : OP_INY_IMP;
+		uint8_t         dec  = (reg == 'X') ? OP_DEX_IMP : OP_DEY_IMP;
+		int             cmp  = (last[1].op == cpi);
+		insn_t          step = cmp ? last[0] : last[1];
+		size_t          soff = cmp ? at[0] : at[1];
+		uint8_t         br   = op2i[last[2].op].mnem;
+		unsigned        n    = last[1].oper;
+		int             rlo, rhi;
+
+		if ((k[0] != k[1]) || ((step.op != inc) && (step.op != dec)))  continue ;
+
+		// Nothing else in the body may touch it
+		{
+			int  other = 0;
+			for (size_t b = lp->head;  b <= lp->latch;  b++)
+				for (size_t off = tm->blk[b].off;  off < tm->blk[b].end;  off += op2i[f->buf[off]].len)
+					if ((off != soff) && tm_writes(decode_insn(&f->buf[off]), reg))  other = 1 ;
+			if (other)  continue ;
+		}
+
+		rlo = -1;
+		rhi = -1;
+		if (step.op == inc) {
+			if      (!cmp && (br == MN_BNE))                                     rlo = k[0],  rhi = 0xFF ;
+			else if (cmp  && ((br == MN_BNE) || (br == MN_BCC)) && (k[0] < n))   rlo = k[0],  rhi = n - 1 ;
+		} else {
+			if      (!cmp && (br == MN_BNE) && k[0])                             rlo = 1,     rhi = k[0] ;
+			else if (!cmp && (br == MN_BPL) && (k[0] < 0x80))                    rlo = 0,     rhi = k[0] ;
+			else if (cmp  && (br == MN_BNE) && (k[0] > n))                       rlo = n + 1, rhi = k[0] ;
+		}
+		if (rlo < 0)  continue ;
+
+		lp->reg  = reg;
+		lp->r[0] = rlo;
+		lp->r[1] = rhi;
+		for (size_t b = lp->head;  b <= lp->latch;  b++) {
+			uint8_t*  r = (reg == 'X') ? tm->blk[b].xr : tm->blk[b].yr;
+			r[0] = rlo;
+			r[1] = rhi;
+		}
+	}
+}
+
+//+============================================================================ ========================================
+// [min, max] over the forward paths head -> latch, plus the back edge
+//
+static  void  tm_trip (timing_t* tm,  tm_loop_t* lp)
+{
+	size_t     nb  = lp->latch - lp->head + 1;
+	uint32_t*  mn  = malloc(nb * sizeof(*mn));
+	uint32_t*  mx  = malloc(nb * sizeof(*mx));
+
+	lp->min = lp->max = TM_NONE;
+	if (!mn || !mx)  goto done ;
+
+	for (size_t i = 0;  i < nb;  i++)  mn[i] = UINT32_MAX,  mx[i] = 0 ;
+	mn[0] = 0;
+
+	for (size_t i = 0;  i < nb;  i++) {
+		const tm_blk_t*  b = &tm->blk[lp->head + i];
+		uint32_t         lo, hi;
+		long             j;
+
+		if (mn[i] == UINT32_MAX)  continue ;
+		lo = mn[i] + b->min;
+		hi = mx[i] + b->max;
+
+		if (i == nb - 1) {
+			lp->min = lo + b->tk;                                // Back edge taken
+			lp->max = hi + b->tk;
+			break;
+		}
+
+		#define TM_EDGE(k, add)  do {                                      \
+				if (mn[k] > lo + (add))  mn[k] = lo + (add);               \
+				if (mx[k] < hi + (add))  mx[k] = hi + (add);               \
+			} while (0)
+
+		if ((b->term == TM_FALL) || (b->term == TM_BR))  TM_EDGE(i + 1, b->nt) ;
+		if (((b->term == TM_BR) || (b->term == TM_JMP)) && ((j = tm_find(tm, b->tgt)) > (long)(lp->head + i)))
+			if ((size_t)j <= lp->latch)  TM_EDGE(j - lp->head, (b->term == TM_BR) ? b->tk : 0) ;
+
+		#undef TM_EDGE
+	}
+
+done:
+	free(mn);
+	free(mx);
+}
+
+//+============================================================================ ========================================
+// qsort: widest loop first
+//
+static  int  tm_wider (const void* a,  const void* b)
+{
+	size_t  wa = ((const tm_loop_t*)a)->latch - ((const tm_loop_t*)a)->head;
+	size_t  wb = ((const tm_loop_t*)b)->latch - ((const tm_loop_t*)b)->head;
+
+	return (wa < wb) - (wa > wb);
+}
+
+//+============================================================================ ========================================
+// Blocks, loops & their costs
+//
+int  time_init (timing_t* tm,  const flow_t* f)
+{
+	memset(tm, 0, sizeof(*tm));
+	tm->f = f;
+
+	if (!(tm->blk = malloc((f->ninsn + 1) * sizeof(*tm->blk))))  return -1 ;
+	tm_blocks(tm);
+
+	for (size_t i = 0;  i < tm->nblk;  i++) {
+		tm_blk_t*  b = &tm->blk[i];
+		b->xr[0] = b->yr[0] = 0x00;
+		b->xr[1] = b->yr[1] = 0xFF;
+		tm_cost(f, b);
+	}
+
+	// Back edges  (outermost first, so inner loops refine the ranges last)
+	if (!(tm->loop = malloc((tm->nblk + 1) * sizeof(*tm->loop))))  return time_free(tm), -1 ;
+	for (size_t i = 0;  i < tm->nblk;  i++) {
+		const tm_blk_t*  b = &tm->blk[i];
+		long             h;
+
+		if (((b->term == TM_BR) || (b->term == TM_JMP)) && ((h = tm_find(tm, b->tgt)) >= 0) && ((size_t)h <= i)
+		 && tm_back(tm, h, i)) {
+			tm_loop_t*  lp = &tm->loop[tm->nloop++];
+			memset(lp, 0, sizeof(*lp));
+			lp->head  = h;
+			lp->latch = i;
+		}
+	}
+	qsort(tm->loop, tm->nloop, sizeof(*tm->loop), tm_wider);
+
+	for (size_t i = 0;  i < tm->nloop;  i++)  tm_counted(tm, &tm->loop[i]) ;
+	for (size_t i = 0;  i < tm->nblk;   i++)  tm_cost(f, &tm->blk[i]) ;
+	for (size_t i = 0;  i < tm->nloop;  i++)  tm_trip(tm, &tm->loop[i]) ;
+
+	return 0;
+}
+
+//+============================================================================ ========================================
+void  time_free (timing_t* tm)
+{
+	free(tm->blk);
+	free(tm->loop);
+	tm->blk  = NULL;
+	tm->loop = NULL;
+}
@@ -0,0 +1,69 @@
+#ifndef  _6502_TIME_H_
+#define  _6502_TIME_H_
+
+//----------------------------------------------------------------------------- ----------------------------------------
+#include <stddef.h>
+#include <stdint.h>
+
+#include "6502.h"
+#include "6502-flow.h"
+
+//----------------------------------------------------------------------------- ----------------------------------------
+// Static cycle timing of the code found by a flow_t
+//
+// A basic block starts at a label (or after a block ended) and ends after a branch, JMP, RTS, RTI or BRK.
+// JSR stays inside its block - only the 6 cycles of the call are counted, not the subroutine.
+//
+// op2i[].t footnotes are resolved from the X/Y value range at each instruction:
+//   [1] page crossing : abs,X / abs,Y cross iff (operand.lo + index) > $FF  -  (zp),Y can only be ruled out for Y = 0
+//   [2] branches      : the target is static, so a taken branch costs exactly 3 or 4
+// X & Y are tracked through LDx #imm, INx, DEx within a block, and across the body of counted loops
+//   (LDx #k before the loop ... INx/DEx [CPx #n] Bxx back to the head)
+// A JSR is assumed to change both
+//
+typedef
+	enum tm_term {
+		TM_FALL = 0,        // Runs into the next block
+		TM_BR,              // Conditional branch
+		TM_JMP,             // JMP abs
+		TM_STOP,            // JMP (ind), RTS, RTI, BRK  - or the end of the known code
+	}
+tm_term_t;
+
+typedef
+	struct tm_blk {
+		uint32_t  off, end;         // Image offsets [off, end)
+		uint16_t  n;                // Instructions
+		uint16_t  min, max;         // Cycles, excluding the branch cost of a TM_BR terminator
+		uint8_t   nt, tk;           // TM_BR: cycles if not taken / taken
+		uint8_t   term;             // tm_term_t
+		long      tgt;              // Image offset of the branch/JMP target  (-1 -> none or outside the image)
+		uint8_t   xr[2], yr[2];     // X & Y range on entry  [lo, hi]
+		uint8_t   xo[2], yo[2];     // ...and on exit
+	}
+tm_blk_t;
+
+typedef
+	struct tm_loop {
+		size_t    head, latch;      // Block numbers  (the latch branches/jumps back to the head)
+		uint16_t  min, max;         // Cycles for one trip round the body  (0xFFFF -> no path)  - inner loops count once
+		char      reg;              // 'X' / 'Y' when the index range of the body was worked out, else 0
+		uint8_t   r[2];             // ...that range
+	}
+tm_loop_t;
+
+typedef
+	struct timing {
+		const flow_t*  f;
+		tm_blk_t*      blk;
+		size_t         nblk;
+		tm_loop_t*     loop;
+		size_t         nloop;
+	}
+timing_t;
+
+//----------------------------------------------------------------------------- ----------------------------------------
+int   time_init (timing_t* tm,  const flow_t* f) ;
+void  time_free (timing_t* tm) ;
+
+#endif //_6502_TIME_H_
@@ -0,0 +1,753 @@
+//----------------------------------------------------------------------------- ----------------------------------------
+// Binary execution trace  (see 6502-trace.h)
+//
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <pthread.h>
+
+#include "6502.h"
+#include "6502-cpu.h"
+#include "6502-trace.h"
+
+#define TRACE_MAGIC  "6502TRC"
+#define TRACE_IMAGIC "6502TIX"
+#define TRACE_VER    (3)
+#define TRACE_HDR    (8 + 1)
+#define TRACE_CHDR   (4 + 4 + 8 + 8)     // raw, packed, first instruction, first cycle
+#define TRACE_KEY    ('K')
+#define TRACE_END    ('E')
+
+#define DIRTY_HOST8  (DIRTY_HOST * 0x0101010101010101ull)       // In 8 pages of c->dirty[]
+
+//----------------------------------------------------------------------------- ----------------------------------------
+// Little endian
+//
+static inline  void  put16 (uint8_t* p,  uint16_t v)  {  p[0] = v,  p[1] = v >> 8;  }
+static inline  void  put32 (uint8_t* p,  uint32_t v)  {  p[0] = v,  p[1] = v >> 8,  p[2] = v >> 16,  p[3] = v >> 24;  }
+static inline  void  put64 (uint8_t* p,  uint64_t v)  {  put32(p, v),  put32(p + 4, v >> 32);  }
+
+static inline  unsigned  get16 (const uint8_t* p)  {  return p[0] | (p[1] << 8);  }
+static inline  uint32_t  get32 (const uint8_t* p)  {  return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24);  }
+
+static inline  uint64_t  get64 (const uint8_t* p)
+{
+	uint64_t  v = 0;
+
+	for (int i = 7;  i >= 0;  i--)  v = (v << 8) | p[i] ;
+	return v;
+}
+
+//----------------------------------------------------------------------------- ----------------------------------------
+// Chunk compression : byte-aligned LZ77  (a trace is mostly the same few loops, over & over)
+//
+// Sequence :  token (literals << 4 | match - 4),  [255 ... rest]  literals,  offset LE16,  [255 ... rest]
+// The last sequence is literals only.  Matches are at least 4 bytes, no more than 64K back.
+//
+#define LZ_HBITS   (12)
+#define LZ_MIN     (4)
+#define LZ_TAIL    (12)         // Bytes at the end that are always literals
+
+static inline  uint32_t  lz_hash (const uint8_t* p)
+{
+	uint32_t  v;
+
+	memcpy(&v, p, 4);
+	return (v * 2654435761u) >> (32 - LZ_HBITS);
+}
+
+static  uint8_t*  lz_len (uint8_t* o,  size_t n)
+{
+	for (;  n >= 255;  n -= 255)  *o++ = 255 ;
+	*o++ = n;
+	return o;
+}
+
+static  uint8_t*  lz_seq (uint8_t* o,  const uint8_t* lit,  size_t nlit,  size_t off,  size_t mlen)
+{
+	uint8_t*  tok = o++;
+	size_t    ml  = mlen ? mlen - LZ_MIN : 0;
+
+	*tok = ((nlit < 15) ? nlit : 15) << 4;
+	if (nlit >= 15)  o = lz_len(o, nlit - 15) ;
+	memcpy(o, lit, nlit);
+	o += nlit;
+	if (!mlen)  return o ;
+
+	*o++  = off;
+	*o++  = off >> 8;
+	*tok |= (ml < 15) ? ml : 15;
+	if (ml >= 15)  o = lz_len(o, ml - 15) ;
+	return o;
+}
+
+//+============================================================================ ========================================
+// -> packed size  (dst : at least n + n/255 + 16)
+//
+static  size_t  lz_pack (const uint8_t* src,  size_t n,  uint8_t* dst)
+{
+	uint32_t        ht[1 << LZ_HBITS] = {0};       // Position + 1 of the last 4 bytes with this hash
+	const uint8_t*  ip   = src;
+	const uint8_t*  lit  = src;
+	const uint8_t*  end  = src + n;
+	uint8_t*        o    = dst;
+	unsigned        miss = 0;
+
+	if (n > LZ_TAIL) {
+		while (ip < end - LZ_TAIL) {
+			uint32_t        h   = lz_hash(ip);
+			uint32_t        at  = ht[h];
+			const uint8_t*  ref = src + at - 1;
+			const uint8_t*  mp;
+
+			ht[h] = ip - src + 1;
+			if (!at || (ip - ref > 0xFFFF) || memcmp(ref, ip, LZ_MIN)) {
+				ip += 1 + (miss++ >> 6);               // Step up through data that will not compress
+				continue;
+			}
+
+			for (mp = ip + LZ_MIN;  (mp < end - LZ_TAIL) && (*mp == ref[mp - ip]);  mp++) ;
+			o    = lz_seq(o, lit, ip - lit, ip - ref, mp - ip);
+			ip   = lit = mp;
+			miss = 0;
+		}
+	}
+	return lz_seq(o, lit, end - lit, 0, 0) - dst;
+}
+
+//+============================================================================ ========================================
+// -> unpacked size, or -1 if it is corrupt or over 'cap'
+//
+static  long  lz_unpack (const uint8_t* src,  size_t n,  uint8_t* dst,  size_t cap)
+{
+	const uint8_t*  ip  = src;
+	const uint8_t*  end = src + n;
+	uint8_t*        o   = dst;
+
+	while (ip < end) {
+		uint8_t  tok = *ip++;
+		size_t   len = tok >> 4;
+		size_t   off;
+
+		if (len == 15)  do {  if (ip >= end)  return -1 ;  len += *ip;  } while (*ip++ == 255) ;
+		if ((len > (size_t)(end - ip)) || (len > cap - (o - dst)))  return -1 ;
+		memcpy(o, ip, len);
+		o  += len;
+		ip += len;
+		if (ip == end)  break ;
+
+		if (end - ip < 2)  return -1 ;
+		off  = ip[0] | (ip[1] << 8);
+		ip  += 2;
+		len  = (tok & 15);
+		if (len == 15)  do {  if (ip >= end)  return -1 ;  len += *ip;  } while (*ip++ == 255) ;
+		len += LZ_MIN;
+		if (!off || (off > (size_t)(o - dst)) || (len > cap - (o - dst)))  return -1 ;
+		for (const uint8_t* r = o - off;  len--;  )  *o++ = *r++ ;  // (may overlap)
+	}
+	return o - dst;
+}
+
+//----------------------------------------------------------------------------- ----------------------------------------
+// Writer
+//
+#define TRACE_PKMAX  (TRACE_CHUNK + TRACE_RMAX + (TRACE_CHUNK + TRACE_RMAX) / 255 + 16)
+
+static  void  wr_chunk (trace_t* tr,  unsigned k,  uint8_t* pk)
+{
+	uint8_t         hdr[TRACE_CHDR];
+	uint32_t        n  = tr->len[k];
+	size_t          np = lz_pack(tr->buf[k], n, pk);
+	const uint8_t*  p  = (np < n) ? pk : tr->buf[k];
+
+	if (np >= n)  np = n ;                                  // Stored
+	if (tr->nidx == tr->maxidx) {
+		void*  v = realloc(tr->idx, (tr->maxidx * 2 + 64) * sizeof(*tr->idx));
+
+		if (!v)  {  tr->err = ENOMEM;  return;  }
+		tr->idx     = v;
+		tr->maxidx  = tr->maxidx * 2 + 64;
+	}
+	tr->idx[tr->nidx][0] = ftell(tr->fh);
+	tr->idx[tr->nidx][1] = tr->rn0[k];
+	tr->idx[tr->nidx][2] = tr->rcyc0[k];
+	tr->nidx++;
+
+	put32(hdr +  0, n);
+	put32(hdr +  4, np);
+	put64(hdr +  8, tr->rn0[k]);
+	put64(hdr + 16, tr->rcyc0[k]);
+	if ((fwrite(hdr, 1, TRACE_CHDR, tr->fh) != TRACE_CHDR) || (fwrite(p, 1, np, tr->fh) != np))  tr->err = EIO ;
+	tr->raw    += n;
+	tr->packed += TRACE_CHDR + np;
+}
+
+static  void*  wr_thread (void* arg)
+{
+	trace_t*         tr = arg;
+	struct timespec  ts = {0, 100000};
+	uint8_t*         pk = malloc(TRACE_PKMAX);
+
+	if (!pk)  tr->err = ENOMEM ;
+
+	for (;;) {
+		unsigned  t = atomic_load_explicit(&tr->tail, memory_order_relaxed);
+
+		if (t == atomic_load_explicit(&tr->head, memory_order_acquire)) {
+			if (atomic_load(&tr->done) && (t == atomic_load(&tr->head)))  break ;
+			nanosleep(&ts, NULL);
+			continue;
+		}
+		if (!tr->err)  wr_chunk(tr, t % TRACE_RING, pk) ;
+		atomic_store_explicit(&tr->tail, t + 1, memory_order_release);
+	}
+	free(pk);
+	return NULL;
+}
+
+//+============================================================================ ========================================
+// Hand the current chunk to the writer, and start the next  (waits while the ring is full)
+//
+static  void  flush (trace_t* tr)
+{
+	unsigned  h = atomic_load_explicit(&tr->head, memory_order_relaxed);
+	unsigned  k = h % TRACE_RING;
+
+	if (tr->wp == tr->buf[k])  return ;                     // Empty
+	tr->len[k]   = tr->wp - tr->buf[k];
+	tr->rn0[k]   = tr->n0;
+	tr->rcyc0[k] = tr->cyc0;
+	while (h + 1 - atomic_load_explicit(&tr->tail, memory_order_acquire) > TRACE_RING - 1)  sched_yield() ;
+	atomic_store_explicit(&tr->head, h + 1, memory_order_release);
+
+	k      = (h + 1) % TRACE_RING;
+	tr->wp = tr->buf[k];
+	tr->we = tr->buf[k] + TRACE_CHUNK;
+}
+
+//+============================================================================ ========================================
+// State of a key / end frame
+//
+static  uint8_t*  wr_state (uint8_t* w,  const cpu_t* c,  uint64_t n)
+{
+	w[0] = c->pc;
+	w[1] = c->pc >> 8;
+	w[2] = c->a,  w[3] = c->x,  w[4] = c->y,  w[5] = c->s,  w[6] = c->p;
+	w[7] = c->jam;
+	put64(w +  8, c->cyc);
+	put64(w + 16, n);
+	return w + TRACE_STATE;
+}
+
+//+============================================================================ ========================================
+// Number of a host page in this chunk  (the first time it is met, the next free one)
+//
+static  unsigned  host_no (trace_t* tr,  const uint8_t* pg)
+{
+	unsigned  h = ((uintptr_t)pg * 0x9E3779B97F4A7C15ull) >> (64 - 12);        // (2 * TRACE_HOSTS slots)
+
+	for (;  tr->ht[h];  h = (h + 1) % (2 * TRACE_HOSTS))
+		if (tr->hp[tr->ht[h] - 1] == pg)  return tr->ht[h] - 1 ;
+
+	tr->hp[tr->nhp] = pg;
+	tr->hk[tr->nhp] = 0;
+	tr->ht[h]       = ++tr->nhp;
+	return tr->nhp - 1;
+}
+
+//+============================================================================ ========================================
+// Host page 'id' into the key frame, unless it is in already, replay has it as it is, or it has no memory
+//
+static  uint8_t*  key_page (trace_t* tr,  uint8_t* w,  unsigned id,  unsigned* n)
+{
+	if ((id >= TRACE_SINK) || (tr->hk[id] == tr->kser))                   return w ;
+	if (tr->hk[id] && !memcmp(tr->hs[id], tr->hp[id], 256))  {  tr->hk[id] = tr->kser;  return w;  }
+	tr->hk[id] = tr->kser;
+	memcpy(tr->hs[id], tr->hp[id], 256);
+	put16(w, id);
+	memcpy(w + 2, tr->hp[id], 256);
+	(*n)++;
+	return w + 2 + 256;
+}
+
+//+============================================================================ ========================================
+// The pages written since the last key frame  (all of them, for the first of a chunk) go in the key frame.
+// Those the core wrote are replayed, so are only there for seeks, which skip spans :  if the host changed nothing at all
+// since the end frame  (no DIRTY_HOST page, the same map & state) the span just carries on.
+//
+uint64_t  trace_key (trace_t* tr,  cpu_t* c)
+{
+	const bus_map_t*  m = c->bus ? c->bus->map : NULL;
+	uint8_t           st[TRACE_STATE];
+	uint8_t*          w;
+	uint8_t*          nm;
+	uint8_t*          np;
+	unsigned          n    = 0;
+	uint16_t          old[512];                             // Host pages the dirty ones were on
+	unsigned          nold = 0;
+	uint64_t          host = 0;
+	int               full, moved;
+
+	for (int pg = 0;  pg < 256;  pg += 8) {                  // (8 pages at a time :  this is per run)
+		uint64_t  d;
+
+		memcpy(&d, &c->dirty[pg], 8);
+		host |= d & DIRTY_HOST8;
+	}
+	wr_state(st, c, tr->n);
+	full  = (tr->wp == tr->buf[atomic_load_explicit(&tr->head, memory_order_relaxed) % TRACE_RING]);
+	moved = (!m != !tr->onbus) || (m && (memcmp(m->rd, tr->mrd, sizeof(tr->mrd)) || memcmp(m->wr, tr->mwr, sizeof(tr->mwr))));
+
+	if (!full && !host && !moved && (tr->wp <= tr->we) && (tr->wp - TRACE_ENDSZ < tr->el)
+	    && (c->cyc - tr->kcyc < TRACE_SPAN) && !memcmp(st, tr->es, TRACE_STATE)) {
+		tr->wp -= TRACE_ENDSZ;                              // Drop the end frame :  it is written again after this run
+		return TRACE_SPAN - (c->cyc - tr->kcyc);
+	}
+
+	// A chunk is all on a bus or all on c->mem, & must not run out of host page numbers  (a key frame adds up to 512)
+	if ((tr->wp > tr->we) || (!full && ((!m != !tr->onbus) || (tr->nhp > TRACE_HOSTS - 512))))  flush(tr),  full = 1 ;
+	if (full) {                                             // First of a chunk
+		tr->n0    = tr->n;
+		tr->cyc0  = c->cyc;
+		tr->onbus = !!m;
+		tr->nhp   = 0;
+		tr->kser  = 0;
+		memset(tr->ht, 0, sizeof(tr->ht));
+	}
+	tr->kser++;
+
+	w        = tr->wp;
+	*w++     = TRACE_KEY;
+	memcpy(w, st, TRACE_STATE);
+	w       += TRACE_STATE;
+	tr->kev  = w;
+	w       += 4;
+
+	// Map :  the pages that moved  (all of them, for the first of a chunk), which are then written as well.
+	// Pages the core wrote through the old map also write the host pages that was on
+	nm  = w;
+	w  += 2;
+	if (m) {
+		for (int pg = 0;  pg < 256;  pg++) {
+			if (!full && (c->dirty[pg] & DIRTY_TRACE))  old[nold++] = tr->rid[pg],  old[nold++] = tr->wid[pg] ;
+			if (!full && (m->rd[pg] == tr->mrd[pg]) && (m->wr[pg] == tr->mwr[pg]))  continue ;
+
+			tr->mrd[pg] = m->rd[pg];
+			tr->mwr[pg] = m->wr[pg];
+			tr->rid[pg] = !m->rd[pg] ? TRACE_IO : host_no(tr, m->rd[pg]) ;
+			tr->wid[pg] = !m->wr[pg] ? TRACE_IO : (m->wr[pg] == c->bus->sink) ? TRACE_SINK : host_no(tr, m->wr[pg]) ;
+			c->dirty[pg] |= DIRTY_TRACE;
+			*w++ = pg;
+			put16(w,     tr->rid[pg]);
+			put16(w + 2, tr->wid[pg]);
+			w   += 4;
+			n++;
+		}
+	}
+	put16(nm, n);
+
+	// Pages
+	np  = w;
+	w  += 2;
+	n   = 0;
+	for (unsigned i = 0;  i < nold;  i++)  w = key_page(tr, w, old[i], &n) ;
+	for (int pg = 0;  pg < 256;  pg++) {
+		if (!full && !(c->dirty[pg] & DIRTY_TRACE))  continue ;
+		if (m) {
+			w = key_page(tr, w, tr->rid[pg], &n);
+			w = key_page(tr, w, tr->wid[pg], &n);
+			continue;
+		}
+		put16(w, pg);
+		memcpy(w + 2, &c->mem[pg << 8], 256);
+		w += 2 + 256;
+		n++;
+	}
+	for (int pg = 0;  pg < 256;  pg++)  c->dirty[pg] &= ~(DIRTY_TRACE | DIRTY_HOST) ;
+	put16(np, n);
+
+	tr->wp   = w;
+	tr->ks   = w;
+	tr->el   = w + TRACE_EVMAX;
+	tr->nev  = tr->n;
+	tr->kcyc = c->cyc;
+	return TRACE_SPAN;
+}
+
+//+============================================================================ ========================================
+void  trace_end (trace_t* tr,  const cpu_t* c)
+{
+	put32(tr->kev, tr->wp - tr->ks);
+	wr_state(tr->es, c, tr->n);
+	*tr->wp = TRACE_END;
+	memcpy(tr->wp + 1, tr->es, TRACE_STATE);
+	tr->wp += TRACE_ENDSZ;
+}
+
+//+============================================================================ ========================================
+trace_t*  trace_open (const char* fn)
+{
+	trace_t*  tr = calloc(1, sizeof(*tr));
+	uint8_t   hdr[TRACE_HDR];
+
+	if (!tr)  return NULL ;
+	if (!(tr->buf = malloc(TRACE_RING * sizeof(*tr->buf))))  return free(tr), NULL ;
+	if (!(tr->fh = fopen(fn, "wb")))                        return free(tr->buf), free(tr), NULL ;
+
+	memcpy(hdr, TRACE_MAGIC, 8);
+	hdr[8] = TRACE_VER;
+	if (fwrite(hdr, 1, TRACE_HDR, tr->fh) != TRACE_HDR)  tr->err = EIO ;
+
+	tr->wp  = tr->buf[0];
+	tr->we  = tr->buf[0] + TRACE_CHUNK;
+	atomic_init(&tr->head, 0);
+	atomic_init(&tr->tail, 0);
+	atomic_init(&tr->done, 0);
+
+	if ((errno = pthread_create(&tr->th, NULL, wr_thread, tr)) != 0) {
+		fclose(tr->fh);
+		free(tr->buf);
+		free(tr);
+		return NULL;
+	}
+	return tr;
+}
+
+//+============================================================================ ========================================
+int  trace_close (trace_t* tr)
+{
+	uint8_t  b[8 * 3];
+	int      err;
+
+	flush(tr);
+	atomic_store(&tr->done, 1);
+	pthread_join(tr->th, NULL);
+
+	for (uint64_t i = 0;  !tr->err && (i < tr->nidx);  i++) {
+		for (int j = 0;  j < 3;  j++)  put64(b + j * 8, tr->idx[i][j]) ;
+		if (fwrite(b, 1, sizeof(b), tr->fh) != sizeof(b))  tr->err = EIO ;
+	}
+	put64(b, tr->nidx);
+	memcpy(b + 8, TRACE_IMAGIC, 8);
+	if (!tr->err && (fwrite(b, 1, 16, tr->fh) != 16))  tr->err = EIO ;
+
+	err = tr->err || (fclose(tr->fh) != 0);
+	free(tr->idx);
+	free(tr->buf);
+	free(tr);
+	return err ? -1 : 0;
+}
+
+//----------------------------------------------------------------------------- ----------------------------------------
+// Reader
+//
+//+============================================================================ ========================================
+// The index from the end of the file, or (if the recorder never closed it) by walking the chunk headers
+//
+static  int  rd_index (trace_rd_t* rd)
+{
+	uint8_t   b[TRACE_CHDR];
+	uint64_t  max = 0;
+	long      end;
+
+	if (fseek(rd->fh, -16, SEEK_END) || ((end = ftell(rd->fh)) < 0))  return -1 ;
+	if ((fread(b, 1, 16, rd->fh) == 16) && !memcmp(b + 8, TRACE_IMAGIC, 8)) {
+		rd->nidx = get64(b);
+		if ((rd->nidx > (uint64_t)end / 24) || !(rd->idx = malloc((rd->nidx + 1) * sizeof(*rd->idx))))  return -1 ;
+		if (fseek(rd->fh, end - rd->nidx * 24, SEEK_SET))  return -1 ;
+		for (uint64_t i = 0;  i < rd->nidx;  i++) {
+			if (fread(b, 1, 24, rd->fh) != 24)  return -1 ;
+			for (int j = 0;  j < 3;  j++)  rd->idx[i][j] = get64(b + j * 8) ;
+		}
+		return 0;
+	}
+
+	// No index  (the recorder never got to trace_close) : walk the chunks, up to the first that can not be one
+	if (fseek(rd->fh, TRACE_HDR, SEEK_SET))  return -1 ;
+	for (rd->nidx = 0;  fread(b, 1, TRACE_CHDR, rd->fh) == TRACE_CHDR;  rd->nidx++) {
+		long  at = ftell(rd->fh);
+
+		if (!get32(b) || (get32(b) > TRACE_CHUNK + TRACE_RMAX) || (get32(b + 4) > get32(b))
+		    || (at + (long)get32(b + 4) > end + 16)
+		    || (rd->nidx && (get64(b + 8) <= rd->idx[rd->nidx - 1][1])))  break ;
+		if (rd->nidx == max) {
+			void*  v = realloc(rd->idx, (max = max * 2 + 64) * sizeof(*rd->idx));
+
+			if (!v)  return -1 ;
+			rd->idx = v;
+		}
+		rd->idx[rd->nidx][0] = at - TRACE_CHDR;
+		rd->idx[rd->nidx][1] = get64(b + 8);
+		rd->idx[rd->nidx][2] = get64(b + 16);
+		if (fseek(rd->fh, get32(b + 4), SEEK_CUR))  break ;
+	}
+	return 0;
+}
+
+//+============================================================================ ========================================
+// The I/O pages of a bus :  what the recording read, in order
+//
+static  uint8_t  rd_io (void* ctx,  uint16_t ad)
+{
+	trace_rd_t*  rd = ctx;
+
+	(void)ad;
+	if (rd->iop < rd->nio)  return rd->io[rd->iop++] ;
+	rd->iobad = 1;
+	return 0xFF;
+}
+
+//+============================================================================ ========================================
+trace_rd_t*  trace_rd_open (const char* fn)
+{
+	trace_rd_t*  rd = calloc(1, sizeof(*rd));
+	uint8_t      hdr[TRACE_HDR];
+
+	if (!rd)  return NULL ;
+	if (!(rd->c = cpu_new()) || !(rd->hp = malloc(TRACE_HOSTS * sizeof(*rd->hp))))
+		return cpu_free(rd->c), free(rd), NULL ;
+	if (!(rd->fh = fopen(fn, "rb")))  return cpu_free(rd->c), free(rd->hp), free(rd), NULL ;
+	bus_init(&rd->bus, &rd->map);
+	bus_handler(&rd->bus, rd_io, NULL, rd);                 // 1 :  every I/O page
+	if ((fread(hdr, 1, TRACE_HDR, rd->fh) != TRACE_HDR) || memcmp(hdr, TRACE_MAGIC, 8) || (hdr[8] != TRACE_VER)
+	    || rd_index(rd)) {
+		trace_rd_close(rd);
+		errno = EINVAL;
+		return NULL;
+	}
+	rd->ci = rd->nidx;                                      // Nothing loaded
+	if (trace_seek(rd, 0) && rd->nidx) {
+		trace_rd_close(rd);
+		errno = EINVAL;
+		return NULL;
+	}
+	return rd;
+}
+
+//+============================================================================ ========================================
+void  trace_rd_close (trace_rd_t* rd)
+{
+	if (!rd)  return ;
+	if (rd->fh)  fclose(rd->fh) ;
+	cpu_free(rd->c);
+	free(rd->hp);
+	free(rd->idx);
+	free(rd);
+}
+
+//+============================================================================ ========================================
+// Load chunk 'ci'  -> 0, or -1
+//
+static  int  rd_chunk (trace_rd_t* rd,  uint64_t ci)
+{
+	uint8_t   b[TRACE_CHDR];
+	uint32_t  n, np;
+
+	if (ci >= rd->nidx)  return -1 ;
+	if (fseek(rd->fh, rd->idx[ci][0], SEEK_SET) || (fread(b, 1, TRACE_CHDR, rd->fh) != TRACE_CHDR))  return -1 ;
+	n  = get32(b);
+	np = get32(b + 4);
+	if ((n > TRACE_CHUNK + TRACE_RMAX) || (np > n))  return -1 ;
+
+	if (np == n) {
+		if (fread(rd->raw, 1, n, rd->fh) != n)  return -1 ;
+	} else {
+		if ((fread(rd->tmp, 1, np, rd->fh) != np) || (lz_unpack(rd->tmp, np, rd->raw, n) != (long)n))  return -1 ;
+	}
+
+	rd->ci   = ci;
+	rd->rp   = rd->raw;
+	rd->re   = rd->raw + n;
+	rd->left = 0;
+	return 0;
+}
+
+//+============================================================================ ========================================
+// State of a key / end frame
+//
+static  const uint8_t*  rd_state (const uint8_t* p,  trace_rec_t* r,  uint8_t* jam)
+{
+	r->pc  = p[0] | (p[1] << 8);
+	r->a   = p[2],  r->x = p[3],  r->y = p[4],  r->s = p[5],  r->p = p[6];
+	*jam   = p[7];
+	r->cyc = get64(p +  8);
+	r->n   = get64(p + 16);
+	return p + TRACE_STATE;
+}
+
+//+============================================================================ ========================================
+// The next event of the span  -> 0, or -1 corrupt
+//
+static  int  rd_ev (trace_rd_t* rd)
+{
+	uint64_t  v = 0;
+
+	if (rd->ep >= rd->ee)  {  rd->en = UINT64_MAX;  return 0;  }
+	for (int sh = 0;  ;  sh += 7) {
+		if ((rd->ep >= rd->ee) || (sh > 63))  return -1 ;
+		v |= (uint64_t)(*rd->ep & 0x7F) << sh;
+		if (!(*rd->ep++ & 0x80))  break ;
+	}
+	rd->en += v >> 2;
+	rd->ek  = v & 3;
+	return (rd->ek > TRACE_EV_IO) ? -1 : 0 ;
+}
+
+//+============================================================================ ========================================
+// The next span :  its key frame into rd->c  (& rd->map), its end frame kept  -> 1, 0 at the end of the trace, or -1
+//
+static  int  rd_span (trace_rd_t* rd)
+{
+	cpu_t*          c = rd->c;
+	const uint8_t*  p;
+	trace_rec_t     k;
+	uint8_t         jam;
+	uint32_t        nev;
+	unsigned        nm, np;
+
+	if (rd->rp >= rd->re) {
+		if (rd->ci + 1 >= rd->nidx)  return 0 ;
+		if (rd_chunk(rd, rd->ci + 1))  return -1 ;
+	}
+
+	p = rd->rp;
+	if ((rd->re - p < 1 + TRACE_STATE + 4 + 2) || (*p != TRACE_KEY))  return -1 ;
+	p   = rd_state(p + 1, &k, &jam);
+	nev = get32(p);
+	nm  = get16(p + 4);
+	p  += 4 + 2;
+	if (rd->rp == rd->raw) {                                // A chunk starts with all of memory, or all of the map
+		if ((nm != 0) && (nm != 256))  return -1 ;
+		rd->onbus = (nm == 256);
+	}
+	if ((nm > 256) || (nm && !rd->onbus) || (rd->re - p < (long)nm * 5 + 2))  return -1 ;
+	for (;  nm--;  p += 5) {
+		unsigned  ri = get16(p + 1), wi = get16(p + 3);
+
+		if (((ri >= TRACE_HOSTS) && (ri != TRACE_IO)) || ((wi >= TRACE_HOSTS) && (wi < TRACE_SINK)))  return -1 ;
+		rd->map.rd[p[0]] = (ri == TRACE_IO)   ? NULL : rd->hp[ri] ;
+		rd->map.wr[p[0]] = (wi == TRACE_IO)   ? NULL
+		                 : (wi == TRACE_SINK) ? rd->bus.sink : rd->hp[wi] ;
+		rd->map.io[p[0]] = 1;
+	}
+
+	np  = get16(p);
+	p  += 2;
+	if ((np > TRACE_KEYPG) || ((rd->rp == rd->raw) && !rd->onbus && (np != 256)))  return -1 ;
+	if (rd->re - p < (long)np * 258 + (long)nev + TRACE_ENDSZ)  return -1 ;
+	for (;  np--;  p += 258) {
+		unsigned  id = get16(p);
+
+		if (id >= (rd->onbus ? TRACE_HOSTS : 256))  return -1 ;
+		memcpy(rd->onbus ? rd->hp[id] : &c->mem[id << 8], p + 2, 256);
+	}
+
+	rd->ep = p;
+	rd->ee = p += nev;
+	if (*p != TRACE_END)  return -1 ;
+	rd->rp = (uint8_t*)rd_state(p + 1, &rd->end, &rd->ejam);
+	if (rd->end.n < k.n)  return -1 ;
+
+	c->pc   = k.pc;
+	c->a    = k.a,  c->x = k.x,  c->y = k.y,  c->s = k.s,  c->p = k.p;
+	c->jam  = jam;
+	c->cyc  = k.cyc;
+	c->bus  = rd->onbus ? &rd->bus : NULL;
+	rd->n    = k.n;
+	rd->en   = k.n;
+	rd->left = rd->end.n - k.n;
+	return rd_ev(rd) ? -1 : 1 ;
+}
+
+//+============================================================================ ========================================
+// Byte at 'ad' as the instruction about to replay sees it  (the k'th I/O read, on an I/O page)
+//
+static  uint8_t  rd_peek (trace_rd_t* rd,  uint16_t ad,  unsigned* k)
+{
+	const uint8_t*  pg;
+
+	if (!rd->c->bus)                    return rd->c->mem[ad] ;
+	if ((pg = rd->map.rd[ad >> 8]))     return pg[ad & 0xFF] ;
+	return (*k < rd->nio) ? rd->io[(*k)++] : 0xFF ;
+}
+
+//+============================================================================ ========================================
+// The recording's cycles win over the replaying core's :  op2i[].t, & the events' extra
+//
+int  trace_next (trace_rd_t* rd,  trace_rec_t* r)
+{
+	cpu_t*    c   = rd->c;
+	unsigned  pen = 0, k = 0;
+	uint64_t  cyc;
+	int       rv, len;
+
+	while (!rd->left)  if ((rv = rd_span(rd)) <= 0)  return rv ;
+
+	rd->nio = rd->iop = rd->iobad = 0;
+	for (;  rd->en == rd->n;  ) {                           // This instruction's events
+		if (rd->ek != TRACE_EV_IO)                         pen += 1 + rd->ek ;
+		else if ((rd->ep < rd->ee) && (rd->nio < 8))       rd->io[rd->nio++] = *rd->ep++ ;
+		else                                               return -1 ;
+		if (rd_ev(rd))  return -1 ;
+	}
+
+	r->n   = rd->n;
+	r->cyc = c->cyc;
+	r->pc  = c->pc;
+	r->a   = c->a,  r->x = c->x,  r->y = c->y,  r->s = c->s,  r->p = c->p;
+	memset(r->ins, 0, 3);
+	r->ins[0] = rd_peek(rd, c->pc, &k);
+	len       = op2i[r->ins[0]].len ? op2i[r->ins[0]].len : 1;
+	for (int i = 1;  i < len;  i++)  r->ins[i] = rd_peek(rd, c->pc + i, &k) ;
+
+	cyc = c->cyc + op2i[r->ins[0]].t % 10 + pen;
+	if (c->bus)  cpu_run_bus(c, 1) ;
+	else         cpu_run(c, 1) ;
+	if (rd->iobad || (rd->iop != rd->nio))  return -1 ;
+	c->cyc = cyc;
+	rd->n++;
+	if (--rd->left)  return 1 ;
+
+	// The last of the span :  replay must have ended where the recording did, with every event used
+	return ((c->pc == rd->end.pc) && (c->a == rd->end.a) && (c->x == rd->end.x) && (c->y == rd->end.y)
+	     && (c->s == rd->end.s) && (c->p == rd->end.p) && (c->jam == rd->ejam) && (c->cyc == rd->end.cyc)
+	     && (rd->en == UINT64_MAX)) ? 1 : -1;
+}
+
+//+============================================================================ ========================================
+// Position so that trace_next() returns the first record for which k(record) >= v
+//   k : 1 -> instruction number, 2 -> cycle
+// Spans that end at or before v are not run :  the next key frame brings memory up to date
+//
+static  int  rd_seek (trace_rd_t* rd,  int k,  uint64_t v)
+{
+	uint64_t     lo = 0, hi = rd->nidx;
+	trace_rec_t  r;
+
+	if (!rd->nidx)  return -1 ;
+	while (hi - lo > 1) {                                    // Last chunk that starts at or before v
+		uint64_t  mid = (lo + hi) / 2;
+
+		if (rd->idx[mid][k] <= v)  lo = mid ;
+		else                       hi = mid ;
+	}
+	if (rd_chunk(rd, lo))  return -1 ;
+
+	do {
+		if (rd_span(rd) <= 0)  return -1 ;
+	} while (!rd->left || (((k == 1) ? rd->end.n : rd->end.cyc) <= v)) ;
+
+	while (((k == 1) ? rd->n : rd->c->cyc) < v)
+		if (trace_next(rd, &r) < 0)  return -1 ;
+	while (!rd->left)                                        // (v is past the span's last :  the next one's first)
+		if (rd_span(rd) <= 0)  return -1 ;
+	return 0;
+}
+
+int  trace_seek     (trace_rd_t* rd,  uint64_t n)    {  return rd_seek(rd, 1, n);    }
+int  trace_seek_cyc (trace_rd_t* rd,  uint64_t cyc)  {  return rd_seek(rd, 2, cyc);  }
@@ -0,0 +1,181 @@
+#ifndef  _6502_TRACE_H_
+#define  _6502_TRACE_H_
+
+//----------------------------------------------------------------------------- ----------------------------------------
+#include <stdint.h>
+#include <stdio.h>
+#include <stdatomic.h>
+#include <pthread.h>
+
+#include "6502.h"
+#include "6502-cpu.h"
+#include "6502-bus.h"
+
+//----------------------------------------------------------------------------- ----------------------------------------
+// Binary execution trace
+//
+// Replay runs the instructions again  (one at a time, which gives back each one's PC, bytes & registers), so only what
+// running them again can not give back is recorded :  the state at either end of a run & the memory the host changed
+// between runs, each instruction's cycles over its op2i[].t  (footnote [1] & taken branches), and on a bus (c->bus) the
+// value of every I/O read.  cpu_run_trace() writes a span per TRACE_SPAN cycles, at most, of a run :
+//
+//   key frame : 'K', state, event bytes LE32,
+//               map entry count LE16, per entry :  page, host page read LE16, host page written LE16
+//               page count LE16, per page :  host page LE16 & its 256 bytes
+//               (the pages written since the last key frame - all of them in the first of a chunk - on a bus, the
+//               host pages they were mapped to before & after it, & those newly mapped, if they changed)
+//   events    : per event a LEB128  (instructions since the last event, or the first of the span) << 2 | TRACE_EV_*
+//               TRACE_EV_IO is followed by the value read
+//   end frame : 'E', state  (as the span ends : replay checks that it got there)
+//   state     : PC LE16, A X Y S P, jam, cycle count LE64, instruction number LE64
+//
+// On c->mem there is no map, and host page n is page n.  On a bus the first key frame of a chunk maps all 256 pages,
+// later ones only those that changed;  host pages are numbered in the order the chunk meets them  (pages that share
+// memory share a number), TRACE_IO reads from the events & drops writes, TRACE_SINK drops writes  (ROM).
+//
+// So the host may change anything between runs - registers, memory  (through cpu_invalidate(), which is how the key
+// frame finds it :  c->dirty[]), the bus map, an interrupt.  A run that the host did not touch at all just makes the
+// last span longer, up to TRACE_SPAN cycles.  A handler that switches the map  (bus_switch()) ends the run after that
+// instruction, so the next key frame has the new one.
+// What replay can not see :  a handler that writes memory itself, or patches the live map in place mid-run;  and the
+// instructions' effects on registers & memory are those of the replaying core.
+//
+// Spans are packed into chunks of about TRACE_CHUNK bytes, each starting with a full key frame so it decodes on its own.
+// Full chunks go round a lock-free ring (one producer : the core, one consumer : the writer thread), which
+// compresses them & writes them out.  trace_close() appends an index of the chunks, for seeking.
+//
+// File :  "6502TRC" 0, version
+//         chunks :  raw size LE32, packed size LE32 (== raw -> stored), first instruction LE64, first cycle LE64, data
+//         index  :  per chunk  file offset, first instruction, first cycle  (LE64 each), chunk count LE64, "6502TIX" 0
+//
+#define TRACE_SPAN    (1 << 20)     // Most cycles replay has to run to reach any instruction  (past its key frame)
+#define TRACE_CHUNK   (256 << 10)   // Raw bytes per chunk  (a new one starts past this)
+#define TRACE_RING    (4)           // Chunks between the core & the writer
+#define TRACE_EVMAX   (64 << 10)    // Event bytes per span  (the run stops once past this)
+#define TRACE_EVSLOP  (64)          //   ...and the most one instruction adds
+#define TRACE_HOSTS   (2048)        // Host pages per chunk  (a new one starts when they might run out)
+#define TRACE_IO      (0xFFFF)      // Host page of an I/O page
+#define TRACE_SINK    (0xFFFE)      //   ...written by a ROM page
+#define TRACE_STATE   (24)
+#define TRACE_KEYPG   (1024)        // Most host pages in a key frame  (those of the map before & after it)
+#define TRACE_KEYSZ   (1 + TRACE_STATE + 4 + 2 + 256 * 5 + 2 + TRACE_KEYPG * (2 + 256))     // Largest key frame
+#define TRACE_ENDSZ   (1 + TRACE_STATE)
+#define TRACE_RMAX    (TRACE_KEYSZ + TRACE_EVMAX + TRACE_EVSLOP + TRACE_ENDSZ)     // Most a span adds past TRACE_CHUNK
+
+typedef
+	enum trace_ev {
+		TRACE_EV_CY1 = 0,           // 1 cycle over op2i[].t
+		TRACE_EV_CY2 = 1,           // 2 cycles over  (a branch taken to another page)
+		TRACE_EV_IO  = 2,           // An I/O read  (+ the value)
+	}
+trace_ev_t;
+
+typedef
+	struct trace_rec {
+		uint64_t  n;                // Instruction number  (from 0)
+		uint64_t  cyc;              // Cycle count as it starts
+		uint16_t  pc;
+		uint8_t   a, x, y, s, p;    // Registers as it starts
+		uint8_t   ins[3];           // Opcode & operand bytes
+	}
+trace_rec_t;
+
+typedef
+	struct trace {
+		// Core side
+		uint64_t     n;             // Instructions run  (cpu_run_trace() counts them here)
+		uint64_t     nev;           // Instruction of the last event  (or the span's first)
+		uint8_t*     wp;            // Next frame  (or event, as the core runs)
+		uint8_t*     we;            // Flush when a key frame starts past here
+		uint8_t*     el;            // The core stops once its events get past here
+		uint8_t*     ks;            // The span's first event
+		uint8_t*     kev;           //   ...& where its key frame has their size
+		uint64_t     n0, cyc0;      // First instruction of the current chunk
+		uint64_t     kcyc;          // First cycle of the current span
+		uint8_t      es[TRACE_STATE];   // The state in the last end frame
+
+		// Host pages of the current chunk  (a bus)
+		int             onbus;      // The chunk was started on a bus
+		const uint8_t*  mrd[256];   // The map as the last key frame wrote it
+		uint8_t*        mwr[256];
+		uint16_t        rid[256], wid[256];     //   ...as host page numbers
+		unsigned        nhp;                    // Host pages numbered
+		const uint8_t*  hp[TRACE_HOSTS];        //   ...their memory
+		uint32_t        hk[TRACE_HOSTS];        //   ...the key frame that last wrote them  (0 :  none yet)
+		uint32_t        kser;                   // Key frames in the chunk
+		uint16_t        ht[2 * TRACE_HOSTS];    // Hash of hp[] :  number + 1, 0 free
+		uint8_t         hs[TRACE_HOSTS][256];   // What replay has of them
+
+		// Ring
+		atomic_uint  head, tail;    // Chunks published by the core / written by the writer
+		atomic_int   done;
+		uint32_t     len [TRACE_RING];
+		uint64_t     rn0 [TRACE_RING], rcyc0[TRACE_RING];
+		uint8_t    (*buf)[TRACE_CHUNK + TRACE_RMAX];
+
+		// Writer
+		pthread_t    th;
+		FILE*        fh;
+		int          err;
+		uint64_t     nidx, maxidx;
+		uint64_t   (*idx)[3];       // File offset, first instruction, first cycle
+		uint64_t     raw, packed;   // Bytes in & out  (statistics)
+	}
+trace_t;
+
+// Reader
+typedef
+	struct trace_rd {
+		FILE*        fh;
+		uint64_t     nidx;
+		uint64_t   (*idx)[3];
+		uint64_t     ci;            // Chunk loaded
+		uint8_t*     rp;            // Next frame in it
+		uint8_t*     re;
+		cpu_t*       c;             // Replaying :  the next instruction is at c->pc
+		uint64_t     n;             // ...and its number
+		uint64_t     left;          // Instructions to the end of the span
+		trace_rec_t  end;           // The state it ends in
+		uint8_t      ejam;
+		const uint8_t*  ep;         // Next event of the span
+		const uint8_t*  ee;
+		uint64_t     en;            // Instruction it is for  (UINT64_MAX :  none left)
+		unsigned     ek;            //   ...TRACE_EV_*
+		uint8_t      io[8];         // I/O reads of the instruction replaying
+		unsigned     nio, iop;      //   ...count & next
+		int          iobad;         // It read more than were recorded
+		int          onbus;         // The chunk is of a bus
+		bus_t        bus;           //   ...replayed on this  (I/O pages read from io[])
+		bus_map_t    map;
+		uint8_t    (*hp)[256];      //   ...& its host pages
+		uint8_t      raw[TRACE_CHUNK + TRACE_RMAX];
+		uint8_t      tmp[TRACE_CHUNK + TRACE_RMAX];    // (packed, or it would have been stored)
+	}
+trace_rd_t;
+
+//----------------------------------------------------------------------------- ----------------------------------------
+trace_t*     trace_open     (const char* fn) ;          // Start recording  -> NULL (errno)
+int          trace_close    (trace_t* tr) ;             // Flush, stop the writer, write the index  -> 0, or -1
+
+trace_rd_t*  trace_rd_open  (const char* fn) ;          // -> NULL (errno)
+void         trace_rd_close (trace_rd_t* rd) ;
+int          trace_seek     (trace_rd_t* rd,  uint64_t n) ;     // To instruction n            -> 0, or -1 past the end
+int          trace_seek_cyc (trace_rd_t* rd,  uint64_t cyc) ;   // To the first at/after cyc   -> 0, or -1 past the end
+int          trace_next     (trace_rd_t* rd,  trace_rec_t* r) ; // -> 1, 0 at the end, or -1 corrupt
+
+// A span of cpu_run_trace() :  the key frame before it  (starting a new chunk if this one is full) & the end frame after
+//   trace_key() -> the most cycles the span may still run  (it may be the last one, carried on)
+uint64_t     trace_key      (trace_t* tr,  cpu_t* c) ;
+void         trace_end      (trace_t* tr,  const cpu_t* c) ;
+
+//+============================================================================ ========================================
+// Append an event  (LEB128)  -> past it
+//
+static inline  uint8_t*  trace_ev (uint8_t* w,  uint64_t v)
+{
+	for (;  v >= 0x80;  v >>= 7)  *w++ = v | 0x80 ;
+	*w++ = v;
+	return w;
+}
+
+#endif //_6502_TRACE_H_
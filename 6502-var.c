@@ -0,0 +1,815 @@
+//----------------------------------------------------------------------------- ----------------------------------------
+// CPU variant decode tables  (same layout & footnotes as op2i[] - see 6502-op2i.c)
+//
+// Footnotes:
+//   [1] : (Tcnt += 1) if page boundary is crossed         // +10
+//   [2] : (Tcnt += 1) if branch occurs on same page       // +20
+//       : (Tcnt += 2) if branch occurs to different page  // ...
+// Not in the tables:  65C02 ADC/SBC take 1 more cycle in decimal mode,
+//                     65816 direct page instructions take 1 more cycle when the low byte of D is not 0
+//
+#include <stdint.h>
+#include <string.h>
+
+#include "6502.h"
+
+//----------------------------------------------------------------------------- ----------------------------------------
+// NMOS 6502 with the stable undocumented opcodes
+//   Left invalid:  the 12 JAMs (x2)  and  ANE $8B, SHA $93 $9F, TAS $9B, SHY $9C, SHX $9E, LXA $AB, LAS $BB
+//                  whose results depend on the chip, the temperature, or the bus
+//
+const decode_t  op2i_nmos[256] = {
+	//               addr    len TCnt |<----------------flags------------------->|   flags
+	//  op    mnem     mode   V  VV   | reset  |   set   |         modify        |   read
+	[0x00] = {MN_BRK, AM_IMP , 1,  7, {FLG_NONE, FLG_I,    FLG_NONE               }, FLG_ALL    },
+	[0x01] = {MN_ORA, AM_INDX, 2,  6, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0x03] = {MN_SLO, AM_INDX, 2,  8, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_NONE   },
+	[0x04] = {MN_NOP, AM_ZP  , 2,  3, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x05] = {MN_ORA, AM_ZP  , 2,  3, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0x06] = {MN_ASL, AM_ZP  , 2,  5, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_NONE   },
+	[0x07] = {MN_SLO, AM_ZP  , 2,  5, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_NONE   },
+	[0x08] = {MN_PHP, AM_IMP , 1,  3, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_ALL    },
+	[0x09] = {MN_ORA, AM_IMM , 2,  2, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0x0A] = {MN_ASL, AM_ACC , 1,  2, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_NONE   },
+	[0x0B] = {MN_ANC, AM_IMM , 2,  2, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_NONE   },
+	[0x0C] = {MN_NOP, AM_ABS , 3,  4, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x0D] = {MN_ORA, AM_ABS , 3,  4, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0x0E] = {MN_ASL, AM_ABS , 3,  6, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_NONE   },
+	[0x0F] = {MN_SLO, AM_ABS , 3,  6, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_NONE   },
+	[0x10] = {MN_BPL, AM_REL , 2, 22, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_N      },
+	[0x11] = {MN_ORA, AM_INDY, 2, 15, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0x13] = {MN_SLO, AM_INDY, 2,  8, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_NONE   },
+	[0x14] = {MN_NOP, AM_ZPX , 2,  4, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x15] = {MN_ORA, AM_ZPX , 2,  4, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0x16] = {MN_ASL, AM_ZPX , 2,  6, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_NONE   },
+	[0x17] = {MN_SLO, AM_ZPX , 2,  6, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_NONE   },
+	[0x18] = {MN_CLC, AM_IMP , 1,  2, {FLG_C,    FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x19] = {MN_ORA, AM_ABSY, 3, 14, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0x1A] = {MN_NOP, AM_IMP , 1,  2, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x1B] = {MN_SLO, AM_ABSY, 3,  7, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_NONE   },
+	[0x1C] = {MN_NOP, AM_ABSX, 3, 14, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x1D] = {MN_ORA, AM_ABSX, 3, 14, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0x1E] = {MN_ASL, AM_ABSX, 3,  7, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_NONE   },
+	[0x1F] = {MN_SLO, AM_ABSX, 3,  7, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_NONE   },
+	[0x20] = {MN_JSR, AM_ABS , 3,  6, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x21] = {MN_AND, AM_INDX, 2,  6, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0x23] = {MN_RLA, AM_INDX, 2,  8, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_C      },
+	[0x24] = {MN_BIT, AM_ZP  , 2,  3, {FLG_NONE, FLG_NONE, FLG_N|FLG_V|FLG_Z      }, FLG_NONE   },
+	[0x25] = {MN_AND, AM_ZP  , 2,  3, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0x26] = {MN_ROL, AM_ZP  , 2,  5, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_C      },
+	[0x27] = {MN_RLA, AM_ZP  , 2,  5, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_C      },
+	[0x28] = {MN_PLP, AM_IMP , 1,  4, {FLG_NONE, FLG_NONE, FLG_ALL                }, FLG_NONE   },
+	[0x29] = {MN_AND, AM_IMM , 2,  2, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0x2A] = {MN_ROL, AM_ACC , 1,  2, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_C      },
+	[0x2B] = {MN_ANC, AM_IMM , 2,  2, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_NONE   },
+	[0x2C] = {MN_BIT, AM_ABS , 3,  4, {FLG_NONE, FLG_NONE, FLG_N|FLG_V|FLG_Z      }, FLG_NONE   },
+	[0x2D] = {MN_AND, AM_ABS , 3,  4, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0x2E] = {MN_ROL, AM_ABS , 3,  6, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_C      },
+	[0x2F] = {MN_RLA, AM_ABS , 3,  6, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_C      },
+	[0x30] = {MN_BMI, AM_REL , 2, 22, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_N      },
+	[0x31] = {MN_AND, AM_INDY, 2, 15, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0x33] = {MN_RLA, AM_INDY, 2,  8, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_C      },
+	[0x34] = {MN_NOP, AM_ZPX , 2,  4, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x35] = {MN_AND, AM_ZPX , 2,  4, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0x36] = {MN_ROL, AM_ZPX , 2,  6, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_C      },
+	[0x37] = {MN_RLA, AM_ZPX , 2,  6, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_C      },
+	[0x38] = {MN_SEC, AM_IMP , 1,  2, {FLG_NONE, FLG_C,    FLG_NONE               }, FLG_NONE   },
+	[0x39] = {MN_AND, AM_ABSY, 3, 14, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0x3A] = {MN_NOP, AM_IMP , 1,  2, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x3B] = {MN_RLA, AM_ABSY, 3,  7, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_C      },
+	[0x3C] = {MN_NOP, AM_ABSX, 3, 14, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x3D] = {MN_AND, AM_ABSX, 3, 14, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0x3E] = {MN_ROL, AM_ABSX, 3,  7, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_C      },
+	[0x3F] = {MN_RLA, AM_ABSX, 3,  7, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_C      },
+	[0x40] = {MN_RTI, AM_IMP , 1,  6, {FLG_NONE, FLG_NONE, FLG_ALL                }, FLG_NONE   },
+	[0x41] = {MN_EOR, AM_INDX, 2,  6, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0x43] = {MN_SRE, AM_INDX, 2,  8, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_NONE   },
+	[0x44] = {MN_NOP, AM_ZP  , 2,  3, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x45] = {MN_EOR, AM_ZP  , 2,  3, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0x46] = {MN_LSR, AM_ZP  , 2,  5, {FLG_N,    FLG_NONE,             FLG_Z|FLG_C}, FLG_NONE   },
+	[0x47] = {MN_SRE, AM_ZP  , 2,  5, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_NONE   },
+	[0x48] = {MN_PHA, AM_IMP , 1,  3, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x49] = {MN_EOR, AM_IMM , 2,  2, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0x4A] = {MN_LSR, AM_ACC , 1,  2, {FLG_N,    FLG_NONE,             FLG_Z|FLG_C}, FLG_NONE   },
+	[0x4B] = {MN_ALR, AM_IMM , 2,  2, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_NONE   },
+	[0x4C] = {MN_JMP, AM_ABS , 3,  3, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x4D] = {MN_EOR, AM_ABS , 3,  4, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0x4E] = {MN_LSR, AM_ABS , 3,  6, {FLG_N,    FLG_NONE,             FLG_Z|FLG_C}, FLG_NONE   },
+	[0x4F] = {MN_SRE, AM_ABS , 3,  6, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_NONE   },
+	[0x50] = {MN_BVC, AM_REL , 2, 22, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_V      },
+	[0x51] = {MN_EOR, AM_INDY, 2, 15, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0x53] = {MN_SRE, AM_INDY, 2,  8, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_NONE   },
+	[0x54] = {MN_NOP, AM_ZPX , 2,  4, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x55] = {MN_EOR, AM_ZPX , 2,  4, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0x56] = {MN_LSR, AM_ZPX , 2,  6, {FLG_N,    FLG_NONE,             FLG_Z|FLG_C}, FLG_NONE   },
+	[0x57] = {MN_SRE, AM_ZPX , 2,  6, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_NONE   },
+	[0x58] = {MN_CLI, AM_IMP , 1,  2, {FLG_I,    FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x59] = {MN_EOR, AM_ABSY, 3, 14, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0x5A] = {MN_NOP, AM_IMP , 1,  2, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x5B] = {MN_SRE, AM_ABSY, 3,  7, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_NONE   },
+	[0x5C] = {MN_NOP, AM_ABSX, 3, 14, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x5D] = {MN_EOR, AM_ABSX, 3, 14, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0x5E] = {MN_LSR, AM_ABSX, 3,  7, {FLG_N,    FLG_NONE,             FLG_Z|FLG_C}, FLG_NONE   },
+	[0x5F] = {MN_SRE, AM_ABSX, 3,  7, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_NONE   },
+	[0x60] = {MN_RTS, AM_IMP , 1,  6, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x61] = {MN_ADC, AM_INDX, 2,  6, {FLG_NONE, FLG_NONE, FLG_N|FLG_V|FLG_Z|FLG_C}, FLG_C|FLG_D},
+	[0x63] = {MN_RRA, AM_INDX, 2,  8, {FLG_NONE, FLG_NONE, FLG_N|FLG_V|FLG_Z|FLG_C}, FLG_C|FLG_D},
+	[0x64] = {MN_NOP, AM_ZP  , 2,  3, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x65] = {MN_ADC, AM_ZP  , 2,  3, {FLG_NONE, FLG_NONE, FLG_N|FLG_V|FLG_Z|FLG_C}, FLG_C|FLG_D},
+	[0x66] = {MN_ROR, AM_ZP  , 2,  5, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_C      },
+	[0x67] = {MN_RRA, AM_ZP  , 2,  5, {FLG_NONE, FLG_NONE, FLG_N|FLG_V|FLG_Z|FLG_C}, FLG_C|FLG_D},
+	[0x68] = {MN_PLA, AM_IMP , 1,  4, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0x69] = {MN_ADC, AM_IMM , 2,  2, {FLG_NONE, FLG_NONE, FLG_N|FLG_V|FLG_Z|FLG_C}, FLG_C|FLG_D},
+	[0x6A] = {MN_ROR, AM_ACC , 1,  2, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_C      },
+	[0x6B] = {MN_ARR, AM_IMM , 2,  2, {FLG_NONE, FLG_NONE, FLG_N|FLG_V|FLG_Z|FLG_C}, FLG_C|FLG_D},
+	[0x6C] = {MN_JMP, AM_IND , 3,  5, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x6D] = {MN_ADC, AM_ABS , 3,  4, {FLG_NONE, FLG_NONE, FLG_N|FLG_V|FLG_Z|FLG_C}, FLG_C|FLG_D},
+	[0x6E] = {MN_ROR, AM_ABS , 3,  6, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_C      },
+	[0x6F] = {MN_RRA, AM_ABS , 3,  6, {FLG_NONE, FLG_NONE, FLG_N|FLG_V|FLG_Z|FLG_C}, FLG_C|FLG_D},
+	[0x70] = {MN_BVS, AM_REL , 2, 22, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_V      },
+	[0x71] = {MN_ADC, AM_INDY, 2, 15, {FLG_NONE, FLG_NONE, FLG_N|FLG_V|FLG_Z|FLG_C}, FLG_C|FLG_D},
+	[0x73] = {MN_RRA, AM_INDY, 2,  8, {FLG_NONE, FLG_NONE, FLG_N|FLG_V|FLG_Z|FLG_C}, FLG_C|FLG_D},
+	[0x74] = {MN_NOP, AM_ZPX , 2,  4, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x75] = {MN_ADC, AM_ZPX , 2,  4, {FLG_NONE, FLG_NONE, FLG_N|FLG_V|FLG_Z|FLG_C}, FLG_C|FLG_D},
+	[0x76] = {MN_ROR, AM_ZPX , 2,  6, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_C      },
+	[0x77] = {MN_RRA, AM_ZPX , 2,  6, {FLG_NONE, FLG_NONE, FLG_N|FLG_V|FLG_Z|FLG_C}, FLG_C|FLG_D},
+	[0x78] = {MN_SEI, AM_IMP , 1,  2, {FLG_NONE, FLG_I,    FLG_NONE               }, FLG_NONE   },
+	[0x79] = {MN_ADC, AM_ABSY, 3, 14, {FLG_NONE, FLG_NONE, FLG_N|FLG_V|FLG_Z|FLG_C}, FLG_C|FLG_D},
+	[0x7A] = {MN_NOP, AM_IMP , 1,  2, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x7B] = {MN_RRA, AM_ABSY, 3,  7, {FLG_NONE, FLG_NONE, FLG_N|FLG_V|FLG_Z|FLG_C}, FLG_C|FLG_D},
+	[0x7C] = {MN_NOP, AM_ABSX, 3, 14, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x7D] = {MN_ADC, AM_ABSX, 3, 14, {FLG_NONE, FLG_NONE, FLG_N|FLG_V|FLG_Z|FLG_C}, FLG_C|FLG_D},
+	[0x7E] = {MN_ROR, AM_ABSX, 3,  7, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_C      },
+	[0x7F] = {MN_RRA, AM_ABSX, 3,  7, {FLG_NONE, FLG_NONE, FLG_N|FLG_V|FLG_Z|FLG_C}, FLG_C|FLG_D},
+	[0x80] = {MN_NOP, AM_IMM , 2,  2, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x81] = {MN_STA, AM_INDX, 2,  6, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x82] = {MN_NOP, AM_IMM , 2,  2, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x83] = {MN_SAX, AM_INDX, 2,  6, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x84] = {MN_STY, AM_ZP  , 2,  3, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x85] = {MN_STA, AM_ZP  , 2,  3, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x86] = {MN_STX, AM_ZP  , 2,  3, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x87] = {MN_SAX, AM_ZP  , 2,  3, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x88] = {MN_DEY, AM_IMP , 1,  2, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0x89] = {MN_NOP, AM_IMM , 2,  2, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x8A] = {MN_TXA, AM_IMP , 1,  2, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0x8C] = {MN_STY, AM_ABS , 3,  4, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x8D] = {MN_STA, AM_ABS , 3,  4, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x8E] = {MN_STX, AM_ABS , 3,  4, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x8F] = {MN_SAX, AM_ABS , 3,  4, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x90] = {MN_BCC, AM_REL , 2, 22, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_C      },
+	[0x91] = {MN_STA, AM_INDY, 2,  6, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x94] = {MN_STY, AM_ZPX , 2,  4, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x95] = {MN_STA, AM_ZPX , 2,  4, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x96] = {MN_STX, AM_ZPY , 2,  4, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x97] = {MN_SAX, AM_ZPY , 2,  4, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x98] = {MN_TYA, AM_IMP , 1,  2, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0x99] = {MN_STA, AM_ABSY, 3,  5, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x9A] = {MN_TXS, AM_IMP , 1,  2, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x9D] = {MN_STA, AM_ABSX, 3,  5, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0xA0] = {MN_LDY, AM_IMM , 2,  2, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0xA1] = {MN_LDA, AM_INDX, 2,  6, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0xA2] = {MN_LDX, AM_IMM , 2,  2, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0xA3] = {MN_LAX, AM_INDX, 2,  6, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0xA4] = {MN_LDY, AM_ZP  , 2,  3, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0xA5] = {MN_LDA, AM_ZP  , 2,  3, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0xA6] = {MN_LDX, AM_ZP  , 2,  3, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0xA7] = {MN_LAX, AM_ZP  , 2,  3, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0xA8] = {MN_TAY, AM_IMP , 1,  2, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0xA9] = {MN_LDA, AM_IMM , 2,  2, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0xAA] = {MN_TAX, AM_IMP , 1,  2, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0xAC] = {MN_LDY, AM_ABS , 3,  4, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0xAD] = {MN_LDA, AM_ABS , 3,  4, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0xAE] = {MN_LDX, AM_ABS , 3,  4, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0xAF] = {MN_LAX, AM_ABS , 3,  4, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0xB0] = {MN_BCS, AM_REL , 2, 22, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_C      },
+	[0xB1] = {MN_LDA, AM_INDY, 2, 15, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0xB3] = {MN_LAX, AM_INDY, 2, 15, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0xB4] = {MN_LDY, AM_ZPX , 2,  4, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0xB5] = {MN_LDA, AM_ZPX , 2,  4, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0xB6] = {MN_LDX, AM_ZPY , 2,  4, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0xB7] = {MN_LAX, AM_ZPY , 2,  4, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0xB8] = {MN_CLV, AM_IMP , 1,  2, {FLG_V,    FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0xB9] = {MN_LDA, AM_ABSY, 3, 14, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0xBA] = {MN_TSX, AM_IMP , 1,  2, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0xBC] = {MN_LDY, AM_ABSX, 3, 14, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0xBD] = {MN_LDA, AM_ABSX, 3, 14, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0xBE] = {MN_LDX, AM_ABSY, 3, 14, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0xBF] = {MN_LAX, AM_ABSY, 3, 14, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0xC0] = {MN_CPY, AM_IMM , 2,  2, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_NONE   },
+	[0xC1] = {MN_CMP, AM_INDX, 2,  6, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_NONE   },
+	[0xC2] = {MN_NOP, AM_IMM , 2,  2, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0xC3] = {MN_DCP, AM_INDX, 2,  8, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_NONE   },
+	[0xC4] = {MN_CPY, AM_ZP  , 2,  3, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_NONE   },
+	[0xC5] = {MN_CMP, AM_ZP  , 2,  3, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_NONE   },
+	[0xC6] = {MN_DEC, AM_ZP  , 2,  5, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0xC7] = {MN_DCP, AM_ZP  , 2,  5, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_NONE   },
+	[0xC8] = {MN_INY, AM_IMP , 1,  2, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0xC9] = {MN_CMP, AM_IMM , 2,  2, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_NONE   },
+	[0xCA] = {MN_DEX, AM_IMP , 1,  2, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0xCB] = {MN_SBX, AM_IMM , 2,  2, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_NONE   },
+	[0xCC] = {MN_CPY, AM_ABS , 3,  4, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_NONE   },
+	[0xCD] = {MN_CMP, AM_ABS , 3,  4, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_NONE   },
+	[0xCE] = {MN_DEC, AM_ABS , 3,  6, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0xCF] = {MN_DCP, AM_ABS , 3,  6, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_NONE   },
+	[0xD0] = {MN_BNE, AM_REL , 2, 22, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_Z      },
+	[0xD1] = {MN_CMP, AM_INDY, 2, 15, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_NONE   },
+	[0xD3] = {MN_DCP, AM_INDY, 2,  8, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_NONE   },
+	[0xD4] = {MN_NOP, AM_ZPX , 2,  4, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0xD5] = {MN_CMP, AM_ZPX , 2,  4, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_NONE   },
+	[0xD6] = {MN_DEC, AM_ZPX , 2,  6, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0xD7] = {MN_DCP, AM_ZPX , 2,  6, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_NONE   },
+	[0xD8] = {MN_CLD, AM_IMP , 1,  2, {FLG_D,    FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0xD9] = {MN_CMP, AM_ABSY, 3, 14, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_NONE   },
+	[0xDA] = {MN_NOP, AM_IMP , 1,  2, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0xDB] = {MN_DCP, AM_ABSY, 3,  7, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_NONE   },
+	[0xDC] = {MN_NOP, AM_ABSX, 3, 14, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0xDD] = {MN_CMP, AM_ABSX, 3, 14, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_NONE   },
+	[0xDE] = {MN_DEC, AM_ABSX, 3,  7, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0xDF] = {MN_DCP, AM_ABSX, 3,  7, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_NONE   },
+	[0xE0] = {MN_CPX, AM_IMM , 2,  2, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_NONE   },
+	[0xE1] = {MN_SBC, AM_INDX, 2,  6, {FLG_NONE, FLG_NONE, FLG_N|FLG_V|FLG_Z|FLG_C}, FLG_C|FLG_D},
+	[0xE2] = {MN_NOP, AM_IMM , 2,  2, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0xE3] = {MN_ISC, AM_INDX, 2,  8, {FLG_NONE, FLG_NONE, FLG_N|FLG_V|FLG_Z|FLG_C}, FLG_C|FLG_D},
+	[0xE4] = {MN_CPX, AM_ZP  , 2,  3, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_NONE   },
+	[0xE5] = {MN_SBC, AM_ZP  , 2,  3, {FLG_NONE, FLG_NONE, FLG_N|FLG_V|FLG_Z|FLG_C}, FLG_C|FLG_D},
+	[0xE6] = {MN_INC, AM_ZP  , 2,  5, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0xE7] = {MN_ISC, AM_ZP  , 2,  5, {FLG_NONE, FLG_NONE, FLG_N|FLG_V|FLG_Z|FLG_C}, FLG_C|FLG_D},
+	[0xE8] = {MN_INX, AM_IMP , 1,  2, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0xE9] = {MN_SBC, AM_IMM , 2,  2, {FLG_NONE, FLG_NONE, FLG_N|FLG_V|FLG_Z|FLG_C}, FLG_C|FLG_D},
+	[0xEA] = {MN_NOP, AM_IMP , 1,  2, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0xEB] = {MN_SBC, AM_IMM , 2,  2, {FLG_NONE, FLG_NONE, FLG_N|FLG_V|FLG_Z|FLG_C}, FLG_C|FLG_D},
+	[0xEC] = {MN_CPX, AM_ABS , 3,  4, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_NONE   },
+	[0xED] = {MN_SBC, AM_ABS , 3,  4, {FLG_NONE, FLG_NONE, FLG_N|FLG_V|FLG_Z|FLG_C}, FLG_C|FLG_D},
+	[0xEE] = {MN_INC, AM_ABS , 3,  6, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0xEF] = {MN_ISC, AM_ABS , 3,  6, {FLG_NONE, FLG_NONE, FLG_N|FLG_V|FLG_Z|FLG_C}, FLG_C|FLG_D},
+	[0xF0] = {MN_BEQ, AM_REL , 2, 22, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_Z      },
+	[0xF1] = {MN_SBC, AM_INDY, 2, 15, {FLG_NONE, FLG_NONE, FLG_N|FLG_V|FLG_Z|FLG_C}, FLG_C|FLG_D},
+	[0xF3] = {MN_ISC, AM_INDY, 2,  8, {FLG_NONE, FLG_NONE, FLG_N|FLG_V|FLG_Z|FLG_C}, FLG_C|FLG_D},
+	[0xF4] = {MN_NOP, AM_ZPX , 2,  4, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0xF5] = {MN_SBC, AM_ZPX , 2,  4, {FLG_NONE, FLG_NONE, FLG_N|FLG_V|FLG_Z|FLG_C}, FLG_C|FLG_D},
+	[0xF6] = {MN_INC, AM_ZPX , 2,  6, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0xF7] = {MN_ISC, AM_ZPX , 2,  6, {FLG_NONE, FLG_NONE, FLG_N|FLG_V|FLG_Z|FLG_C}, FLG_C|FLG_D},
+	[0xF8] = {MN_SED, AM_IMP , 1,  2, {FLG_NONE, FLG_D,    FLG_NONE               }, FLG_NONE   },
+	[0xF9] = {MN_SBC, AM_ABSY, 3, 14, {FLG_NONE, FLG_NONE, FLG_N|FLG_V|FLG_Z|FLG_C}, FLG_C|FLG_D},
+	[0xFA] = {MN_NOP, AM_IMP , 1,  2, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0xFB] = {MN_ISC, AM_ABSY, 3,  7, {FLG_NONE, FLG_NONE, FLG_N|FLG_V|FLG_Z|FLG_C}, FLG_C|FLG_D},
+	[0xFC] = {MN_NOP, AM_ABSX, 3, 14, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0xFD] = {MN_SBC, AM_ABSX, 3, 14, {FLG_NONE, FLG_NONE, FLG_N|FLG_V|FLG_Z|FLG_C}, FLG_C|FLG_D},
+	[0xFE] = {MN_INC, AM_ABSX, 3,  7, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0xFF] = {MN_ISC, AM_ABSX, 3,  7, {FLG_NONE, FLG_NONE, FLG_N|FLG_V|FLG_Z|FLG_C}, FLG_C|FLG_D},
+};
+
+//----------------------------------------------------------------------------- ----------------------------------------
+// WDC 65C02  (with the Rockwell RMB/SMB/BBR/BBS)
+//   JMP (ind) no longer wraps inside the page (+1 cycle);  shift/rotate abs,X only pays for a page crossing;
+//   BRK & interrupts clear D;  the unused opcodes are NOPs of 1, 2 or 3 bytes
+//
+const decode_t  op2i_65c02[256] = {
+	//               addr    len TCnt |<----------------flags------------------->|   flags
+	//  op    mnem     mode   V  VV   | reset  |   set   |         modify        |   read
+	[0x00] = {MN_BRK, AM_IMP , 1,  7, {FLG_D,    FLG_I,    FLG_NONE               }, FLG_ALL    },
+	[0x01] = {MN_ORA, AM_INDX, 2,  6, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0x02] = {MN_NOP, AM_IMM , 2,  2, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x03] = {MN_NOP, AM_IMP , 1,  1, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x04] = {MN_TSB, AM_ZP  , 2,  5, {FLG_NONE, FLG_NONE,             FLG_Z      }, FLG_NONE   },
+	[0x05] = {MN_ORA, AM_ZP  , 2,  3, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0x06] = {MN_ASL, AM_ZP  , 2,  5, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_NONE   },
+	[0x07] = {MN_RMB, AM_ZP  , 2,  5, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x08] = {MN_PHP, AM_IMP , 1,  3, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_ALL    },
+	[0x09] = {MN_ORA, AM_IMM , 2,  2, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0x0A] = {MN_ASL, AM_ACC , 1,  2, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_NONE   },
+	[0x0B] = {MN_NOP, AM_IMP , 1,  1, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x0C] = {MN_TSB, AM_ABS , 3,  6, {FLG_NONE, FLG_NONE,             FLG_Z      }, FLG_NONE   },
+	[0x0D] = {MN_ORA, AM_ABS , 3,  4, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0x0E] = {MN_ASL, AM_ABS , 3,  6, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_NONE   },
+	[0x0F] = {MN_BBR, AM_ZPR , 3, 25, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x10] = {MN_BPL, AM_REL , 2, 22, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_N      },
+	[0x11] = {MN_ORA, AM_INDY, 2, 15, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0x12] = {MN_ORA, AM_ZPI , 2,  5, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0x13] = {MN_NOP, AM_IMP , 1,  1, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x14] = {MN_TRB, AM_ZP  , 2,  5, {FLG_NONE, FLG_NONE,             FLG_Z      }, FLG_NONE   },
+	[0x15] = {MN_ORA, AM_ZPX , 2,  4, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0x16] = {MN_ASL, AM_ZPX , 2,  6, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_NONE   },
+	[0x17] = {MN_RMB, AM_ZP  , 2,  5, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x18] = {MN_CLC, AM_IMP , 1,  2, {FLG_C,    FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x19] = {MN_ORA, AM_ABSY, 3, 14, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0x1A] = {MN_INC, AM_ACC , 1,  2, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0x1B] = {MN_NOP, AM_IMP , 1,  1, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x1C] = {MN_TRB, AM_ABS , 3,  6, {FLG_NONE, FLG_NONE,             FLG_Z      }, FLG_NONE   },
+	[0x1D] = {MN_ORA, AM_ABSX, 3, 14, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0x1E] = {MN_ASL, AM_ABSX, 3, 16, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_NONE   },
+	[0x1F] = {MN_BBR, AM_ZPR , 3, 25, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x20] = {MN_JSR, AM_ABS , 3,  6, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x21] = {MN_AND, AM_INDX, 2,  6, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0x22] = {MN_NOP, AM_IMM , 2,  2, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x23] = {MN_NOP, AM_IMP , 1,  1, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x24] = {MN_BIT, AM_ZP  , 2,  3, {FLG_NONE, FLG_NONE, FLG_N|FLG_V|FLG_Z      }, FLG_NONE   },
+	[0x25] = {MN_AND, AM_ZP  , 2,  3, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0x26] = {MN_ROL, AM_ZP  , 2,  5, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_C      },
+	[0x27] = {MN_RMB, AM_ZP  , 2,  5, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x28] = {MN_PLP, AM_IMP , 1,  4, {FLG_NONE, FLG_NONE, FLG_ALL                }, FLG_NONE   },
+	[0x29] = {MN_AND, AM_IMM , 2,  2, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0x2A] = {MN_ROL, AM_ACC , 1,  2, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_C      },
+	[0x2B] = {MN_NOP, AM_IMP , 1,  1, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x2C] = {MN_BIT, AM_ABS , 3,  4, {FLG_NONE, FLG_NONE, FLG_N|FLG_V|FLG_Z      }, FLG_NONE   },
+	[0x2D] = {MN_AND, AM_ABS , 3,  4, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0x2E] = {MN_ROL, AM_ABS , 3,  6, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_C      },
+	[0x2F] = {MN_BBR, AM_ZPR , 3, 25, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x30] = {MN_BMI, AM_REL , 2, 22, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_N      },
+	[0x31] = {MN_AND, AM_INDY, 2, 15, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0x32] = {MN_AND, AM_ZPI , 2,  5, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0x33] = {MN_NOP, AM_IMP , 1,  1, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x34] = {MN_BIT, AM_ZPX , 2,  4, {FLG_NONE, FLG_NONE, FLG_N|FLG_V|FLG_Z      }, FLG_NONE   },
+	[0x35] = {MN_AND, AM_ZPX , 2,  4, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0x36] = {MN_ROL, AM_ZPX , 2,  6, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_C      },
+	[0x37] = {MN_RMB, AM_ZP  , 2,  5, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x38] = {MN_SEC, AM_IMP , 1,  2, {FLG_NONE, FLG_C,    FLG_NONE               }, FLG_NONE   },
+	[0x39] = {MN_AND, AM_ABSY, 3, 14, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0x3A] = {MN_DEC, AM_ACC , 1,  2, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0x3B] = {MN_NOP, AM_IMP , 1,  1, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x3C] = {MN_BIT, AM_ABSX, 3, 14, {FLG_NONE, FLG_NONE, FLG_N|FLG_V|FLG_Z      }, FLG_NONE   },
+	[0x3D] = {MN_AND, AM_ABSX, 3, 14, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0x3E] = {MN_ROL, AM_ABSX, 3, 16, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_C      },
+	[0x3F] = {MN_BBR, AM_ZPR , 3, 25, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x40] = {MN_RTI, AM_IMP , 1,  6, {FLG_NONE, FLG_NONE, FLG_ALL                }, FLG_NONE   },
+	[0x41] = {MN_EOR, AM_INDX, 2,  6, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0x42] = {MN_NOP, AM_IMM , 2,  2, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x43] = {MN_NOP, AM_IMP , 1,  1, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x44] = {MN_NOP, AM_ZP  , 2,  3, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x45] = {MN_EOR, AM_ZP  , 2,  3, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0x46] = {MN_LSR, AM_ZP  , 2,  5, {FLG_N,    FLG_NONE,             FLG_Z|FLG_C}, FLG_NONE   },
+	[0x47] = {MN_RMB, AM_ZP  , 2,  5, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x48] = {MN_PHA, AM_IMP , 1,  3, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x49] = {MN_EOR, AM_IMM , 2,  2, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0x4A] = {MN_LSR, AM_ACC , 1,  2, {FLG_N,    FLG_NONE,             FLG_Z|FLG_C}, FLG_NONE   },
+	[0x4B] = {MN_NOP, AM_IMP , 1,  1, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x4C] = {MN_JMP, AM_ABS , 3,  3, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x4D] = {MN_EOR, AM_ABS , 3,  4, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0x4E] = {MN_LSR, AM_ABS , 3,  6, {FLG_N,    FLG_NONE,             FLG_Z|FLG_C}, FLG_NONE   },
+	[0x4F] = {MN_BBR, AM_ZPR , 3, 25, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x50] = {MN_BVC, AM_REL , 2, 22, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_V      },
+	[0x51] = {MN_EOR, AM_INDY, 2, 15, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0x52] = {MN_EOR, AM_ZPI , 2,  5, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0x53] = {MN_NOP, AM_IMP , 1,  1, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x54] = {MN_NOP, AM_ZPX , 2,  4, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x55] = {MN_EOR, AM_ZPX , 2,  4, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0x56] = {MN_LSR, AM_ZPX , 2,  6, {FLG_N,    FLG_NONE,             FLG_Z|FLG_C}, FLG_NONE   },
+	[0x57] = {MN_RMB, AM_ZP  , 2,  5, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x58] = {MN_CLI, AM_IMP , 1,  2, {FLG_I,    FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x59] = {MN_EOR, AM_ABSY, 3, 14, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0x5A] = {MN_PHY, AM_IMP , 1,  3, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x5B] = {MN_NOP, AM_IMP , 1,  1, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x5C] = {MN_NOP, AM_ABS , 3,  8, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x5D] = {MN_EOR, AM_ABSX, 3, 14, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0x5E] = {MN_LSR, AM_ABSX, 3, 16, {FLG_N,    FLG_NONE,             FLG_Z|FLG_C}, FLG_NONE   },
+	[0x5F] = {MN_BBR, AM_ZPR , 3, 25, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x60] = {MN_RTS, AM_IMP , 1,  6, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x61] = {MN_ADC, AM_INDX, 2,  6, {FLG_NONE, FLG_NONE, FLG_N|FLG_V|FLG_Z|FLG_C}, FLG_C|FLG_D},
+	[0x62] = {MN_NOP, AM_IMM , 2,  2, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x63] = {MN_NOP, AM_IMP , 1,  1, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x64] = {MN_STZ, AM_ZP  , 2,  3, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x65] = {MN_ADC, AM_ZP  , 2,  3, {FLG_NONE, FLG_NONE, FLG_N|FLG_V|FLG_Z|FLG_C}, FLG_C|FLG_D},
+	[0x66] = {MN_ROR, AM_ZP  , 2,  5, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_C      },
+	[0x67] = {MN_RMB, AM_ZP  , 2,  5, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x68] = {MN_PLA, AM_IMP , 1,  4, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0x69] = {MN_ADC, AM_IMM , 2,  2, {FLG_NONE, FLG_NONE, FLG_N|FLG_V|FLG_Z|FLG_C}, FLG_C|FLG_D},
+	[0x6A] = {MN_ROR, AM_ACC , 1,  2, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_C      },
+	[0x6B] = {MN_NOP, AM_IMP , 1,  1, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x6C] = {MN_JMP, AM_IND , 3,  6, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x6D] = {MN_ADC, AM_ABS , 3,  4, {FLG_NONE, FLG_NONE, FLG_N|FLG_V|FLG_Z|FLG_C}, FLG_C|FLG_D},
+	[0x6E] = {MN_ROR, AM_ABS , 3,  6, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_C      },
+	[0x6F] = {MN_BBR, AM_ZPR , 3, 25, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x70] = {MN_BVS, AM_REL , 2, 22, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_V      },
+	[0x71] = {MN_ADC, AM_INDY, 2, 15, {FLG_NONE, FLG_NONE, FLG_N|FLG_V|FLG_Z|FLG_C}, FLG_C|FLG_D},
+	[0x72] = {MN_ADC, AM_ZPI , 2,  5, {FLG_NONE, FLG_NONE, FLG_N|FLG_V|FLG_Z|FLG_C}, FLG_C|FLG_D},
+	[0x73] = {MN_NOP, AM_IMP , 1,  1, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x74] = {MN_STZ, AM_ZPX , 2,  4, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x75] = {MN_ADC, AM_ZPX , 2,  4, {FLG_NONE, FLG_NONE, FLG_N|FLG_V|FLG_Z|FLG_C}, FLG_C|FLG_D},
+	[0x76] = {MN_ROR, AM_ZPX , 2,  6, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_C      },
+	[0x77] = {MN_RMB, AM_ZP  , 2,  5, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x78] = {MN_SEI, AM_IMP , 1,  2, {FLG_NONE, FLG_I,    FLG_NONE               }, FLG_NONE   },
+	[0x79] = {MN_ADC, AM_ABSY, 3, 14, {FLG_NONE, FLG_NONE, FLG_N|FLG_V|FLG_Z|FLG_C}, FLG_C|FLG_D},
+	[0x7A] = {MN_PLY, AM_IMP , 1,  4, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0x7B] = {MN_NOP, AM_IMP , 1,  1, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x7C] = {MN_JMP, AM_IAX , 3,  6, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x7D] = {MN_ADC, AM_ABSX, 3, 14, {FLG_NONE, FLG_NONE, FLG_N|FLG_V|FLG_Z|FLG_C}, FLG_C|FLG_D},
+	[0x7E] = {MN_ROR, AM_ABSX, 3, 16, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_C      },
+	[0x7F] = {MN_BBR, AM_ZPR , 3, 25, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x80] = {MN_BRA, AM_REL , 2, 13, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x81] = {MN_STA, AM_INDX, 2,  6, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x82] = {MN_NOP, AM_IMM , 2,  2, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x83] = {MN_NOP, AM_IMP , 1,  1, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x84] = {MN_STY, AM_ZP  , 2,  3, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x85] = {MN_STA, AM_ZP  , 2,  3, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x86] = {MN_STX, AM_ZP  , 2,  3, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x87] = {MN_SMB, AM_ZP  , 2,  5, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x88] = {MN_DEY, AM_IMP , 1,  2, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0x89] = {MN_BIT, AM_IMM , 2,  2, {FLG_NONE, FLG_NONE,             FLG_Z      }, FLG_NONE   },
+	[0x8A] = {MN_TXA, AM_IMP , 1,  2, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0x8B] = {MN_NOP, AM_IMP , 1,  1, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x8C] = {MN_STY, AM_ABS , 3,  4, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x8D] = {MN_STA, AM_ABS , 3,  4, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x8E] = {MN_STX, AM_ABS , 3,  4, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x8F] = {MN_BBS, AM_ZPR , 3, 25, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x90] = {MN_BCC, AM_REL , 2, 22, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_C      },
+	[0x91] = {MN_STA, AM_INDY, 2,  6, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x92] = {MN_STA, AM_ZPI , 2,  5, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x93] = {MN_NOP, AM_IMP , 1,  1, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x94] = {MN_STY, AM_ZPX , 2,  4, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x95] = {MN_STA, AM_ZPX , 2,  4, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x96] = {MN_STX, AM_ZPY , 2,  4, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x97] = {MN_SMB, AM_ZP  , 2,  5, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x98] = {MN_TYA, AM_IMP , 1,  2, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0x99] = {MN_STA, AM_ABSY, 3,  5, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x9A] = {MN_TXS, AM_IMP , 1,  2, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x9B] = {MN_NOP, AM_IMP , 1,  1, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x9C] = {MN_STZ, AM_ABS , 3,  4, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x9D] = {MN_STA, AM_ABSX, 3,  5, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x9E] = {MN_STZ, AM_ABSX, 3,  5, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x9F] = {MN_BBS, AM_ZPR , 3, 25, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0xA0] = {MN_LDY, AM_IMM , 2,  2, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0xA1] = {MN_LDA, AM_INDX, 2,  6, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0xA2] = {MN_LDX, AM_IMM , 2,  2, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0xA3] = {MN_NOP, AM_IMP , 1,  1, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0xA4] = {MN_LDY, AM_ZP  , 2,  3, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0xA5] = {MN_LDA, AM_ZP  , 2,  3, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0xA6] = {MN_LDX, AM_ZP  , 2,  3, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0xA7] = {MN_SMB, AM_ZP  , 2,  5, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0xA8] = {MN_TAY, AM_IMP , 1,  2, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0xA9] = {MN_LDA, AM_IMM , 2,  2, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0xAA] = {MN_TAX, AM_IMP , 1,  2, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0xAB] = {MN_NOP, AM_IMP , 1,  1, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0xAC] = {MN_LDY, AM_ABS , 3,  4, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0xAD] = {MN_LDA, AM_ABS , 3,  4, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0xAE] = {MN_LDX, AM_ABS , 3,  4, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0xAF] = {MN_BBS, AM_ZPR , 3, 25, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0xB0] = {MN_BCS, AM_REL , 2, 22, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_C      },
+	[0xB1] = {MN_LDA, AM_INDY, 2, 15, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0xB2] = {MN_LDA, AM_ZPI , 2,  5, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0xB3] = {MN_NOP, AM_IMP , 1,  1, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0xB4] = {MN_LDY, AM_ZPX , 2,  4, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0xB5] = {MN_LDA, AM_ZPX , 2,  4, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0xB6] = {MN_LDX, AM_ZPY , 2,  4, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0xB7] = {MN_SMB, AM_ZP  , 2,  5, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0xB8] = {MN_CLV, AM_IMP , 1,  2, {FLG_V,    FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0xB9] = {MN_LDA, AM_ABSY, 3, 14, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0xBA] = {MN_TSX, AM_IMP , 1,  2, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0xBB] = {MN_NOP, AM_IMP , 1,  1, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0xBC] = {MN_LDY, AM_ABSX, 3, 14, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0xBD] = {MN_LDA, AM_ABSX, 3, 14, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0xBE] = {MN_LDX, AM_ABSY, 3, 14, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0xBF] = {MN_BBS, AM_ZPR , 3, 25, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0xC0] = {MN_CPY, AM_IMM , 2,  2, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_NONE   },
+	[0xC1] = {MN_CMP, AM_INDX, 2,  6, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_NONE   },
+	[0xC2] = {MN_NOP, AM_IMM , 2,  2, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0xC3] = {MN_NOP, AM_IMP , 1,  1, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0xC4] = {MN_CPY, AM_ZP  , 2,  3, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_NONE   },
+	[0xC5] = {MN_CMP, AM_ZP  , 2,  3, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_NONE   },
+	[0xC6] = {MN_DEC, AM_ZP  , 2,  5, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0xC7] = {MN_SMB, AM_ZP  , 2,  5, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0xC8] = {MN_INY, AM_IMP , 1,  2, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0xC9] = {MN_CMP, AM_IMM , 2,  2, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_NONE   },
+	[0xCA] = {MN_DEX, AM_IMP , 1,  2, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0xCB] = {MN_WAI, AM_IMP , 1,  3, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0xCC] = {MN_CPY, AM_ABS , 3,  4, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_NONE   },
+	[0xCD] = {MN_CMP, AM_ABS , 3,  4, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_NONE   },
+	[0xCE] = {MN_DEC, AM_ABS , 3,  6, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0xCF] = {MN_BBS, AM_ZPR , 3, 25, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0xD0] = {MN_BNE, AM_REL , 2, 22, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_Z      },
+	[0xD1] = {MN_CMP, AM_INDY, 2, 15, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_NONE   },
+	[0xD2] = {MN_CMP, AM_ZPI , 2,  5, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_NONE   },
+	[0xD3] = {MN_NOP, AM_IMP , 1,  1, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0xD4] = {MN_NOP, AM_ZPX , 2,  4, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0xD5] = {MN_CMP, AM_ZPX , 2,  4, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_NONE   },
+	[0xD6] = {MN_DEC, AM_ZPX , 2,  6, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0xD7] = {MN_SMB, AM_ZP  , 2,  5, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0xD8] = {MN_CLD, AM_IMP , 1,  2, {FLG_D,    FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0xD9] = {MN_CMP, AM_ABSY, 3, 14, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_NONE   },
+	[0xDA] = {MN_PHX, AM_IMP , 1,  3, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0xDB] = {MN_STP, AM_IMP , 1,  3, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0xDC] = {MN_NOP, AM_ABS , 3,  4, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0xDD] = {MN_CMP, AM_ABSX, 3, 14, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_NONE   },
+	[0xDE] = {MN_DEC, AM_ABSX, 3,  7, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0xDF] = {MN_BBS, AM_ZPR , 3, 25, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0xE0] = {MN_CPX, AM_IMM , 2,  2, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_NONE   },
+	[0xE1] = {MN_SBC, AM_INDX, 2,  6, {FLG_NONE, FLG_NONE, FLG_N|FLG_V|FLG_Z|FLG_C}, FLG_C|FLG_D},
+	[0xE2] = {MN_NOP, AM_IMM , 2,  2, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0xE3] = {MN_NOP, AM_IMP , 1,  1, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0xE4] = {MN_CPX, AM_ZP  , 2,  3, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_NONE   },
+	[0xE5] = {MN_SBC, AM_ZP  , 2,  3, {FLG_NONE, FLG_NONE, FLG_N|FLG_V|FLG_Z|FLG_C}, FLG_C|FLG_D},
+	[0xE6] = {MN_INC, AM_ZP  , 2,  5, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0xE7] = {MN_SMB, AM_ZP  , 2,  5, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0xE8] = {MN_INX, AM_IMP , 1,  2, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0xE9] = {MN_SBC, AM_IMM , 2,  2, {FLG_NONE, FLG_NONE, FLG_N|FLG_V|FLG_Z|FLG_C}, FLG_C|FLG_D},
+	[0xEA] = {MN_NOP, AM_IMP , 1,  2, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0xEB] = {MN_NOP, AM_IMP , 1,  1, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0xEC] = {MN_CPX, AM_ABS , 3,  4, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_NONE   },
+	[0xED] = {MN_SBC, AM_ABS , 3,  4, {FLG_NONE, FLG_NONE, FLG_N|FLG_V|FLG_Z|FLG_C}, FLG_C|FLG_D},
+	[0xEE] = {MN_INC, AM_ABS , 3,  6, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0xEF] = {MN_BBS, AM_ZPR , 3, 25, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0xF0] = {MN_BEQ, AM_REL , 2, 22, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_Z      },
+	[0xF1] = {MN_SBC, AM_INDY, 2, 15, {FLG_NONE, FLG_NONE, FLG_N|FLG_V|FLG_Z|FLG_C}, FLG_C|FLG_D},
+	[0xF2] = {MN_SBC, AM_ZPI , 2,  5, {FLG_NONE, FLG_NONE, FLG_N|FLG_V|FLG_Z|FLG_C}, FLG_C|FLG_D},
+	[0xF3] = {MN_NOP, AM_IMP , 1,  1, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0xF4] = {MN_NOP, AM_ZPX , 2,  4, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0xF5] = {MN_SBC, AM_ZPX , 2,  4, {FLG_NONE, FLG_NONE, FLG_N|FLG_V|FLG_Z|FLG_C}, FLG_C|FLG_D},
+	[0xF6] = {MN_INC, AM_ZPX , 2,  6, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0xF7] = {MN_SMB, AM_ZP  , 2,  5, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0xF8] = {MN_SED, AM_IMP , 1,  2, {FLG_NONE, FLG_D,    FLG_NONE               }, FLG_NONE   },
+	[0xF9] = {MN_SBC, AM_ABSY, 3, 14, {FLG_NONE, FLG_NONE, FLG_N|FLG_V|FLG_Z|FLG_C}, FLG_C|FLG_D},
+	[0xFA] = {MN_PLX, AM_IMP , 1,  4, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0xFB] = {MN_NOP, AM_IMP , 1,  1, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0xFC] = {MN_NOP, AM_ABS , 3,  4, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0xFD] = {MN_SBC, AM_ABSX, 3, 14, {FLG_NONE, FLG_NONE, FLG_N|FLG_V|FLG_Z|FLG_C}, FLG_C|FLG_D},
+	[0xFE] = {MN_INC, AM_ABSX, 3,  7, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0xFF] = {MN_BBS, AM_ZPR , 3, 25, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+};
+
+//----------------------------------------------------------------------------- ----------------------------------------
+// 65816 in emulation mode  (E = 1: 8-bit A, X & Y;  stack in page 1)
+//   The 65C02 set without the Rockwell bit instructions, + the 65816 instructions and addressing modes
+//   Long operands are 3 bytes, so JML/JSL and the long forms are 4-byte instructions
+//
+const decode_t  op2i_65816[256] = {
+	//               addr    len TCnt |<----------------flags------------------->|   flags
+	//  op    mnem     mode   V  VV   | reset  |   set   |         modify        |   read
+	[0x00] = {MN_BRK, AM_IMP , 1,  7, {FLG_D,    FLG_I,    FLG_NONE               }, FLG_ALL    },
+	[0x01] = {MN_ORA, AM_INDX, 2,  6, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0x02] = {MN_COP, AM_IMM , 2,  7, {FLG_D,    FLG_I,    FLG_NONE               }, FLG_ALL    },
+	[0x03] = {MN_ORA, AM_SR  , 2,  4, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0x04] = {MN_TSB, AM_ZP  , 2,  5, {FLG_NONE, FLG_NONE,             FLG_Z      }, FLG_NONE   },
+	[0x05] = {MN_ORA, AM_ZP  , 2,  3, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0x06] = {MN_ASL, AM_ZP  , 2,  5, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_NONE   },
+	[0x07] = {MN_ORA, AM_DIL , 2,  6, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0x08] = {MN_PHP, AM_IMP , 1,  3, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_ALL    },
+	[0x09] = {MN_ORA, AM_IMM , 2,  2, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0x0A] = {MN_ASL, AM_ACC , 1,  2, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_NONE   },
+	[0x0B] = {MN_PHD, AM_IMP , 1,  4, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x0C] = {MN_TSB, AM_ABS , 3,  6, {FLG_NONE, FLG_NONE,             FLG_Z      }, FLG_NONE   },
+	[0x0D] = {MN_ORA, AM_ABS , 3,  4, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0x0E] = {MN_ASL, AM_ABS , 3,  6, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_NONE   },
+	[0x0F] = {MN_ORA, AM_LNG , 4,  5, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0x10] = {MN_BPL, AM_REL , 2, 22, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_N      },
+	[0x11] = {MN_ORA, AM_INDY, 2, 15, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0x12] = {MN_ORA, AM_ZPI , 2,  5, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0x13] = {MN_ORA, AM_SRIY, 2,  7, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0x14] = {MN_TRB, AM_ZP  , 2,  5, {FLG_NONE, FLG_NONE,             FLG_Z      }, FLG_NONE   },
+	[0x15] = {MN_ORA, AM_ZPX , 2,  4, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0x16] = {MN_ASL, AM_ZPX , 2,  6, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_NONE   },
+	[0x17] = {MN_ORA, AM_DILY, 2,  6, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0x18] = {MN_CLC, AM_IMP , 1,  2, {FLG_C,    FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x19] = {MN_ORA, AM_ABSY, 3, 14, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0x1A] = {MN_INC, AM_ACC , 1,  2, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0x1B] = {MN_TCS, AM_IMP , 1,  2, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x1C] = {MN_TRB, AM_ABS , 3,  6, {FLG_NONE, FLG_NONE,             FLG_Z      }, FLG_NONE   },
+	[0x1D] = {MN_ORA, AM_ABSX, 3, 14, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0x1E] = {MN_ASL, AM_ABSX, 3,  7, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_NONE   },
+	[0x1F] = {MN_ORA, AM_LNGX, 4,  5, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0x20] = {MN_JSR, AM_ABS , 3,  6, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x21] = {MN_AND, AM_INDX, 2,  6, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0x22] = {MN_JSL, AM_LNG , 4,  8, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x23] = {MN_AND, AM_SR  , 2,  4, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0x24] = {MN_BIT, AM_ZP  , 2,  3, {FLG_NONE, FLG_NONE, FLG_N|FLG_V|FLG_Z      }, FLG_NONE   },
+	[0x25] = {MN_AND, AM_ZP  , 2,  3, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0x26] = {MN_ROL, AM_ZP  , 2,  5, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_C      },
+	[0x27] = {MN_AND, AM_DIL , 2,  6, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0x28] = {MN_PLP, AM_IMP , 1,  4, {FLG_NONE, FLG_NONE, FLG_ALL                }, FLG_NONE   },
+	[0x29] = {MN_AND, AM_IMM , 2,  2, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0x2A] = {MN_ROL, AM_ACC , 1,  2, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_C      },
+	[0x2B] = {MN_PLD, AM_IMP , 1,  5, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0x2C] = {MN_BIT, AM_ABS , 3,  4, {FLG_NONE, FLG_NONE, FLG_N|FLG_V|FLG_Z      }, FLG_NONE   },
+	[0x2D] = {MN_AND, AM_ABS , 3,  4, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0x2E] = {MN_ROL, AM_ABS , 3,  6, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_C      },
+	[0x2F] = {MN_AND, AM_LNG , 4,  5, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0x30] = {MN_BMI, AM_REL , 2, 22, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_N      },
+	[0x31] = {MN_AND, AM_INDY, 2, 15, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0x32] = {MN_AND, AM_ZPI , 2,  5, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0x33] = {MN_AND, AM_SRIY, 2,  7, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0x34] = {MN_BIT, AM_ZPX , 2,  4, {FLG_NONE, FLG_NONE, FLG_N|FLG_V|FLG_Z      }, FLG_NONE   },
+	[0x35] = {MN_AND, AM_ZPX , 2,  4, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0x36] = {MN_ROL, AM_ZPX , 2,  6, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_C      },
+	[0x37] = {MN_AND, AM_DILY, 2,  6, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0x38] = {MN_SEC, AM_IMP , 1,  2, {FLG_NONE, FLG_C,    FLG_NONE               }, FLG_NONE   },
+	[0x39] = {MN_AND, AM_ABSY, 3, 14, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0x3A] = {MN_DEC, AM_ACC , 1,  2, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0x3B] = {MN_TSC, AM_IMP , 1,  2, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0x3C] = {MN_BIT, AM_ABSX, 3, 14, {FLG_NONE, FLG_NONE, FLG_N|FLG_V|FLG_Z      }, FLG_NONE   },
+	[0x3D] = {MN_AND, AM_ABSX, 3, 14, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0x3E] = {MN_ROL, AM_ABSX, 3,  7, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_C      },
+	[0x3F] = {MN_AND, AM_LNGX, 4,  5, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0x40] = {MN_RTI, AM_IMP , 1,  6, {FLG_NONE, FLG_NONE, FLG_ALL                }, FLG_NONE   },
+	[0x41] = {MN_EOR, AM_INDX, 2,  6, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0x42] = {MN_WDM, AM_IMM , 2,  2, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x43] = {MN_EOR, AM_SR  , 2,  4, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0x44] = {MN_MVP, AM_BLK , 3,  7, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x45] = {MN_EOR, AM_ZP  , 2,  3, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0x46] = {MN_LSR, AM_ZP  , 2,  5, {FLG_N,    FLG_NONE,             FLG_Z|FLG_C}, FLG_NONE   },
+	[0x47] = {MN_EOR, AM_DIL , 2,  6, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0x48] = {MN_PHA, AM_IMP , 1,  3, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x49] = {MN_EOR, AM_IMM , 2,  2, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0x4A] = {MN_LSR, AM_ACC , 1,  2, {FLG_N,    FLG_NONE,             FLG_Z|FLG_C}, FLG_NONE   },
+	[0x4B] = {MN_PHK, AM_IMP , 1,  3, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x4C] = {MN_JMP, AM_ABS , 3,  3, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x4D] = {MN_EOR, AM_ABS , 3,  4, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0x4E] = {MN_LSR, AM_ABS , 3,  6, {FLG_N,    FLG_NONE,             FLG_Z|FLG_C}, FLG_NONE   },
+	[0x4F] = {MN_EOR, AM_LNG , 4,  5, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0x50] = {MN_BVC, AM_REL , 2, 22, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_V      },
+	[0x51] = {MN_EOR, AM_INDY, 2, 15, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0x52] = {MN_EOR, AM_ZPI , 2,  5, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0x53] = {MN_EOR, AM_SRIY, 2,  7, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0x54] = {MN_MVN, AM_BLK , 3,  7, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x55] = {MN_EOR, AM_ZPX , 2,  4, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0x56] = {MN_LSR, AM_ZPX , 2,  6, {FLG_N,    FLG_NONE,             FLG_Z|FLG_C}, FLG_NONE   },
+	[0x57] = {MN_EOR, AM_DILY, 2,  6, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0x58] = {MN_CLI, AM_IMP , 1,  2, {FLG_I,    FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x59] = {MN_EOR, AM_ABSY, 3, 14, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0x5A] = {MN_PHY, AM_IMP , 1,  3, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x5B] = {MN_TCD, AM_IMP , 1,  2, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0x5C] = {MN_JML, AM_LNG , 4,  4, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x5D] = {MN_EOR, AM_ABSX, 3, 14, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0x5E] = {MN_LSR, AM_ABSX, 3,  7, {FLG_N,    FLG_NONE,             FLG_Z|FLG_C}, FLG_NONE   },
+	[0x5F] = {MN_EOR, AM_LNGX, 4,  5, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0x60] = {MN_RTS, AM_IMP , 1,  6, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x61] = {MN_ADC, AM_INDX, 2,  6, {FLG_NONE, FLG_NONE, FLG_N|FLG_V|FLG_Z|FLG_C}, FLG_C|FLG_D},
+	[0x62] = {MN_PER, AM_RELL, 3,  6, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x63] = {MN_ADC, AM_SR  , 2,  4, {FLG_NONE, FLG_NONE, FLG_N|FLG_V|FLG_Z|FLG_C}, FLG_C|FLG_D},
+	[0x64] = {MN_STZ, AM_ZP  , 2,  3, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x65] = {MN_ADC, AM_ZP  , 2,  3, {FLG_NONE, FLG_NONE, FLG_N|FLG_V|FLG_Z|FLG_C}, FLG_C|FLG_D},
+	[0x66] = {MN_ROR, AM_ZP  , 2,  5, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_C      },
+	[0x67] = {MN_ADC, AM_DIL , 2,  6, {FLG_NONE, FLG_NONE, FLG_N|FLG_V|FLG_Z|FLG_C}, FLG_C|FLG_D},
+	[0x68] = {MN_PLA, AM_IMP , 1,  4, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0x69] = {MN_ADC, AM_IMM , 2,  2, {FLG_NONE, FLG_NONE, FLG_N|FLG_V|FLG_Z|FLG_C}, FLG_C|FLG_D},
+	[0x6A] = {MN_ROR, AM_ACC , 1,  2, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_C      },
+	[0x6B] = {MN_RTL, AM_IMP , 1,  6, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x6C] = {MN_JMP, AM_IND , 3,  5, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x6D] = {MN_ADC, AM_ABS , 3,  4, {FLG_NONE, FLG_NONE, FLG_N|FLG_V|FLG_Z|FLG_C}, FLG_C|FLG_D},
+	[0x6E] = {MN_ROR, AM_ABS , 3,  6, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_C      },
+	[0x6F] = {MN_ADC, AM_LNG , 4,  5, {FLG_NONE, FLG_NONE, FLG_N|FLG_V|FLG_Z|FLG_C}, FLG_C|FLG_D},
+	[0x70] = {MN_BVS, AM_REL , 2, 22, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_V      },
+	[0x71] = {MN_ADC, AM_INDY, 2, 15, {FLG_NONE, FLG_NONE, FLG_N|FLG_V|FLG_Z|FLG_C}, FLG_C|FLG_D},
+	[0x72] = {MN_ADC, AM_ZPI , 2,  5, {FLG_NONE, FLG_NONE, FLG_N|FLG_V|FLG_Z|FLG_C}, FLG_C|FLG_D},
+	[0x73] = {MN_ADC, AM_SRIY, 2,  7, {FLG_NONE, FLG_NONE, FLG_N|FLG_V|FLG_Z|FLG_C}, FLG_C|FLG_D},
+	[0x74] = {MN_STZ, AM_ZPX , 2,  4, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x75] = {MN_ADC, AM_ZPX , 2,  4, {FLG_NONE, FLG_NONE, FLG_N|FLG_V|FLG_Z|FLG_C}, FLG_C|FLG_D},
+	[0x76] = {MN_ROR, AM_ZPX , 2,  6, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_C      },
+	[0x77] = {MN_ADC, AM_DILY, 2,  6, {FLG_NONE, FLG_NONE, FLG_N|FLG_V|FLG_Z|FLG_C}, FLG_C|FLG_D},
+	[0x78] = {MN_SEI, AM_IMP , 1,  2, {FLG_NONE, FLG_I,    FLG_NONE               }, FLG_NONE   },
+	[0x79] = {MN_ADC, AM_ABSY, 3, 14, {FLG_NONE, FLG_NONE, FLG_N|FLG_V|FLG_Z|FLG_C}, FLG_C|FLG_D},
+	[0x7A] = {MN_PLY, AM_IMP , 1,  4, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0x7B] = {MN_TDC, AM_IMP , 1,  2, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0x7C] = {MN_JMP, AM_IAX , 3,  6, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x7D] = {MN_ADC, AM_ABSX, 3, 14, {FLG_NONE, FLG_NONE, FLG_N|FLG_V|FLG_Z|FLG_C}, FLG_C|FLG_D},
+	[0x7E] = {MN_ROR, AM_ABSX, 3,  7, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_C      },
+	[0x7F] = {MN_ADC, AM_LNGX, 4,  5, {FLG_NONE, FLG_NONE, FLG_N|FLG_V|FLG_Z|FLG_C}, FLG_C|FLG_D},
+	[0x80] = {MN_BRA, AM_REL , 2, 13, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x81] = {MN_STA, AM_INDX, 2,  6, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x82] = {MN_BRL, AM_RELL, 3,  4, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x83] = {MN_STA, AM_SR  , 2,  4, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x84] = {MN_STY, AM_ZP  , 2,  3, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x85] = {MN_STA, AM_ZP  , 2,  3, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x86] = {MN_STX, AM_ZP  , 2,  3, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x87] = {MN_STA, AM_DIL , 2,  6, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x88] = {MN_DEY, AM_IMP , 1,  2, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0x89] = {MN_BIT, AM_IMM , 2,  2, {FLG_NONE, FLG_NONE,             FLG_Z      }, FLG_NONE   },
+	[0x8A] = {MN_TXA, AM_IMP , 1,  2, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0x8B] = {MN_PHB, AM_IMP , 1,  3, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x8C] = {MN_STY, AM_ABS , 3,  4, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x8D] = {MN_STA, AM_ABS , 3,  4, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x8E] = {MN_STX, AM_ABS , 3,  4, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x8F] = {MN_STA, AM_LNG , 4,  5, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x90] = {MN_BCC, AM_REL , 2, 22, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_C      },
+	[0x91] = {MN_STA, AM_INDY, 2,  6, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x92] = {MN_STA, AM_ZPI , 2,  5, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x93] = {MN_STA, AM_SRIY, 2,  7, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x94] = {MN_STY, AM_ZPX , 2,  4, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x95] = {MN_STA, AM_ZPX , 2,  4, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x96] = {MN_STX, AM_ZPY , 2,  4, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x97] = {MN_STA, AM_DILY, 2,  6, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x98] = {MN_TYA, AM_IMP , 1,  2, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0x99] = {MN_STA, AM_ABSY, 3,  5, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x9A] = {MN_TXS, AM_IMP , 1,  2, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x9B] = {MN_TXY, AM_IMP , 1,  2, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0x9C] = {MN_STZ, AM_ABS , 3,  4, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x9D] = {MN_STA, AM_ABSX, 3,  5, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x9E] = {MN_STZ, AM_ABSX, 3,  5, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0x9F] = {MN_STA, AM_LNGX, 4,  5, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0xA0] = {MN_LDY, AM_IMM , 2,  2, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0xA1] = {MN_LDA, AM_INDX, 2,  6, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0xA2] = {MN_LDX, AM_IMM , 2,  2, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0xA3] = {MN_LDA, AM_SR  , 2,  4, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0xA4] = {MN_LDY, AM_ZP  , 2,  3, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0xA5] = {MN_LDA, AM_ZP  , 2,  3, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0xA6] = {MN_LDX, AM_ZP  , 2,  3, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0xA7] = {MN_LDA, AM_DIL , 2,  6, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0xA8] = {MN_TAY, AM_IMP , 1,  2, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0xA9] = {MN_LDA, AM_IMM , 2,  2, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0xAA] = {MN_TAX, AM_IMP , 1,  2, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0xAB] = {MN_PLB, AM_IMP , 1,  4, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0xAC] = {MN_LDY, AM_ABS , 3,  4, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0xAD] = {MN_LDA, AM_ABS , 3,  4, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0xAE] = {MN_LDX, AM_ABS , 3,  4, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0xAF] = {MN_LDA, AM_LNG , 4,  5, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0xB0] = {MN_BCS, AM_REL , 2, 22, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_C      },
+	[0xB1] = {MN_LDA, AM_INDY, 2, 15, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0xB2] = {MN_LDA, AM_ZPI , 2,  5, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0xB3] = {MN_LDA, AM_SRIY, 2,  7, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0xB4] = {MN_LDY, AM_ZPX , 2,  4, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0xB5] = {MN_LDA, AM_ZPX , 2,  4, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0xB6] = {MN_LDX, AM_ZPY , 2,  4, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0xB7] = {MN_LDA, AM_DILY, 2,  6, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0xB8] = {MN_CLV, AM_IMP , 1,  2, {FLG_V,    FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0xB9] = {MN_LDA, AM_ABSY, 3, 14, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0xBA] = {MN_TSX, AM_IMP , 1,  2, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0xBB] = {MN_TYX, AM_IMP , 1,  2, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0xBC] = {MN_LDY, AM_ABSX, 3, 14, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0xBD] = {MN_LDA, AM_ABSX, 3, 14, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0xBE] = {MN_LDX, AM_ABSY, 3, 14, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0xBF] = {MN_LDA, AM_LNGX, 4,  5, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0xC0] = {MN_CPY, AM_IMM , 2,  2, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_NONE   },
+	[0xC1] = {MN_CMP, AM_INDX, 2,  6, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_NONE   },
+	[0xC2] = {MN_REP, AM_IMM , 2,  3, {FLG_NONE, FLG_NONE, FLG_ALL                }, FLG_NONE   },
+	[0xC3] = {MN_CMP, AM_SR  , 2,  4, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_NONE   },
+	[0xC4] = {MN_CPY, AM_ZP  , 2,  3, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_NONE   },
+	[0xC5] = {MN_CMP, AM_ZP  , 2,  3, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_NONE   },
+	[0xC6] = {MN_DEC, AM_ZP  , 2,  5, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0xC7] = {MN_CMP, AM_DIL , 2,  6, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_NONE   },
+	[0xC8] = {MN_INY, AM_IMP , 1,  2, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0xC9] = {MN_CMP, AM_IMM , 2,  2, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_NONE   },
+	[0xCA] = {MN_DEX, AM_IMP , 1,  2, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0xCB] = {MN_WAI, AM_IMP , 1,  3, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0xCC] = {MN_CPY, AM_ABS , 3,  4, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_NONE   },
+	[0xCD] = {MN_CMP, AM_ABS , 3,  4, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_NONE   },
+	[0xCE] = {MN_DEC, AM_ABS , 3,  6, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0xCF] = {MN_CMP, AM_LNG , 4,  5, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_NONE   },
+	[0xD0] = {MN_BNE, AM_REL , 2, 22, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_Z      },
+	[0xD1] = {MN_CMP, AM_INDY, 2, 15, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_NONE   },
+	[0xD2] = {MN_CMP, AM_ZPI , 2,  5, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_NONE   },
+	[0xD3] = {MN_CMP, AM_SRIY, 2,  7, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_NONE   },
+	[0xD4] = {MN_PEI, AM_ZPI , 2,  6, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0xD5] = {MN_CMP, AM_ZPX , 2,  4, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_NONE   },
+	[0xD6] = {MN_DEC, AM_ZPX , 2,  6, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0xD7] = {MN_CMP, AM_DILY, 2,  6, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_NONE   },
+	[0xD8] = {MN_CLD, AM_IMP , 1,  2, {FLG_D,    FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0xD9] = {MN_CMP, AM_ABSY, 3, 14, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_NONE   },
+	[0xDA] = {MN_PHX, AM_IMP , 1,  3, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0xDB] = {MN_STP, AM_IMP , 1,  3, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0xDC] = {MN_JML, AM_IL  , 3,  6, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0xDD] = {MN_CMP, AM_ABSX, 3, 14, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_NONE   },
+	[0xDE] = {MN_DEC, AM_ABSX, 3,  7, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0xDF] = {MN_CMP, AM_LNGX, 4,  5, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_NONE   },
+	[0xE0] = {MN_CPX, AM_IMM , 2,  2, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_NONE   },
+	[0xE1] = {MN_SBC, AM_INDX, 2,  6, {FLG_NONE, FLG_NONE, FLG_N|FLG_V|FLG_Z|FLG_C}, FLG_C|FLG_D},
+	[0xE2] = {MN_SEP, AM_IMM , 2,  3, {FLG_NONE, FLG_NONE, FLG_ALL                }, FLG_NONE   },
+	[0xE3] = {MN_SBC, AM_SR  , 2,  4, {FLG_NONE, FLG_NONE, FLG_N|FLG_V|FLG_Z|FLG_C}, FLG_C|FLG_D},
+	[0xE4] = {MN_CPX, AM_ZP  , 2,  3, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_NONE   },
+	[0xE5] = {MN_SBC, AM_ZP  , 2,  3, {FLG_NONE, FLG_NONE, FLG_N|FLG_V|FLG_Z|FLG_C}, FLG_C|FLG_D},
+	[0xE6] = {MN_INC, AM_ZP  , 2,  5, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0xE7] = {MN_SBC, AM_DIL , 2,  6, {FLG_NONE, FLG_NONE, FLG_N|FLG_V|FLG_Z|FLG_C}, FLG_C|FLG_D},
+	[0xE8] = {MN_INX, AM_IMP , 1,  2, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0xE9] = {MN_SBC, AM_IMM , 2,  2, {FLG_NONE, FLG_NONE, FLG_N|FLG_V|FLG_Z|FLG_C}, FLG_C|FLG_D},
+	[0xEA] = {MN_NOP, AM_IMP , 1,  2, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0xEB] = {MN_XBA, AM_IMP , 1,  3, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0xEC] = {MN_CPX, AM_ABS , 3,  4, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z|FLG_C}, FLG_NONE   },
+	[0xED] = {MN_SBC, AM_ABS , 3,  4, {FLG_NONE, FLG_NONE, FLG_N|FLG_V|FLG_Z|FLG_C}, FLG_C|FLG_D},
+	[0xEE] = {MN_INC, AM_ABS , 3,  6, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0xEF] = {MN_SBC, AM_LNG , 4,  5, {FLG_NONE, FLG_NONE, FLG_N|FLG_V|FLG_Z|FLG_C}, FLG_C|FLG_D},
+	[0xF0] = {MN_BEQ, AM_REL , 2, 22, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_Z      },
+	[0xF1] = {MN_SBC, AM_INDY, 2, 15, {FLG_NONE, FLG_NONE, FLG_N|FLG_V|FLG_Z|FLG_C}, FLG_C|FLG_D},
+	[0xF2] = {MN_SBC, AM_ZPI , 2,  5, {FLG_NONE, FLG_NONE, FLG_N|FLG_V|FLG_Z|FLG_C}, FLG_C|FLG_D},
+	[0xF3] = {MN_SBC, AM_SRIY, 2,  7, {FLG_NONE, FLG_NONE, FLG_N|FLG_V|FLG_Z|FLG_C}, FLG_C|FLG_D},
+	[0xF4] = {MN_PEA, AM_ABS , 3,  5, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0xF5] = {MN_SBC, AM_ZPX , 2,  4, {FLG_NONE, FLG_NONE, FLG_N|FLG_V|FLG_Z|FLG_C}, FLG_C|FLG_D},
+	[0xF6] = {MN_INC, AM_ZPX , 2,  6, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0xF7] = {MN_SBC, AM_DILY, 2,  6, {FLG_NONE, FLG_NONE, FLG_N|FLG_V|FLG_Z|FLG_C}, FLG_C|FLG_D},
+	[0xF8] = {MN_SED, AM_IMP , 1,  2, {FLG_NONE, FLG_D,    FLG_NONE               }, FLG_NONE   },
+	[0xF9] = {MN_SBC, AM_ABSY, 3, 14, {FLG_NONE, FLG_NONE, FLG_N|FLG_V|FLG_Z|FLG_C}, FLG_C|FLG_D},
+	[0xFA] = {MN_PLX, AM_IMP , 1,  4, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0xFB] = {MN_XCE, AM_IMP , 1,  2, {FLG_NONE, FLG_NONE,                   FLG_C}, FLG_C      },
+	[0xFC] = {MN_JSR, AM_IAX , 3,  8, {FLG_NONE, FLG_NONE, FLG_NONE               }, FLG_NONE   },
+	[0xFD] = {MN_SBC, AM_ABSX, 3, 14, {FLG_NONE, FLG_NONE, FLG_N|FLG_V|FLG_Z|FLG_C}, FLG_C|FLG_D},
+	[0xFE] = {MN_INC, AM_ABSX, 3,  7, {FLG_NONE, FLG_NONE, FLG_N      |FLG_Z      }, FLG_NONE   },
+	[0xFF] = {MN_SBC, AM_LNGX, 4,  5, {FLG_NONE, FLG_NONE, FLG_N|FLG_V|FLG_Z|FLG_C}, FLG_C|FLG_D},
+};
+
+//----------------------------------------------------------------------------- ----------------------------------------
+const decode_t* const  op2i_var[VAR_MAX] = {
+	[VAR_6502 ] = op2i,
+	[VAR_NMOS ] = op2i_nmos,
+	[VAR_65C02] = op2i_65c02,
+	[VAR_65816] = op2i_65816,
+};
+
+const char  var_name[VAR_MAX][8] = {
+	[VAR_6502 ] = "6502",
+	[VAR_NMOS ] = "nmos",
+	[VAR_65C02] = "65c02",
+	[VAR_65816] = "65816",
+};
+
+//+============================================================================ ========================================
+int  var_find (const char* name)
+{
+	for (int v = 0;  v < VAR_MAX;  v++)
+		if (!strcmp(name, var_name[v]))  return v ;
+	return -1;
+}
@@ -0,0 +1,114 @@
+#ifndef  _6502_WORK_H_
+#define  _6502_WORK_H_
+
+//----------------------------------------------------------------------------- ----------------------------------------
+#include <stdint.h>
+
+//----------------------------------------------------------------------------- ----------------------------------------
+// Built-in workloads : loops that never end, loaded at $C000  (./emu -b, ./bench)
+//
+// Mixed : indexed load, ALU, store & branch
+static const uint8_t  bench_mix[] = {
+	0xA2, 0x00,             // C000  LDX #$00
+	0xBD, 0x80, 0xC0,       // C002  LDA $C080, X     <- crosses a page for X >= $80
+	0x18,                   // C005  CLC
+	0x69, 0x07,             // C006  ADC #$07
+	0x9D, 0x00, 0x02,       // C008  STA $0200, X
+	0x45, 0x10,             // C00B  EOR $10
+	0x85, 0x10,             // C00D  STA $10
+	0xE8,                   // C00F  INX
+	0xD0, 0xF0,             // C010  BNE $C002
+	0xC8,                   // C012  INY
+	0x4C, 0x02, 0xC0,       // C013  JMP $C002
+};
+
+// ALU heavy : almost every instruction writes flags that the next one overwrites unread
+static const uint8_t  bench_alu[] = {
+	0x18,                   // C000  CLC
+	0xA9, 0x01,             // C001  LDA #$01
+	0x69, 0x03,             // C003  ADC #$03
+	0x45, 0x10,             // C005  EOR $10
+	0x0A,                   // C007  ASL A
+	0x65, 0x11,             // C008  ADC $11
+	0x29, 0x7F,             // C00A  AND #$7F
+	0x2A,                   // C00C  ROL A
+	0xE5, 0x12,             // C00D  SBC $12
+	0x09, 0x11,             // C00F  ORA #$11
+	0x4A,                   // C011  LSR A
+	0xC9, 0x40,             // C012  CMP #$40
+	0x88,                   // C014  DEY
+	0xD0, 0xEC,             // C015  BNE $C003
+	0x4C, 0x03, 0xC0,       // C017  JMP $C003
+};
+
+// BCD : a 4 digit score counter, a seconds clock & a countdown, all in decimal mode
+static const uint8_t  bench_bcd[] = {
+	0xF8,                   // C000  SED
+	0x18,                   // C001  CLC
+	0xA5, 0x10,             // C002  LDA $10          <- score += 25
+	0x69, 0x25,             // C004  ADC #$25
+	0x85, 0x10,             // C006  STA $10
+	0xA5, 0x11,             // C008  LDA $11
+	0x69, 0x00,             // C00A  ADC #$00
+	0x85, 0x11,             // C00C  STA $11
+	0x18,                   // C00E  CLC
+	0xA5, 0x12,             // C00F  LDA $12          <- seconds, 00..59
+	0x69, 0x01,             // C011  ADC #$01
+	0xC9, 0x60,             // C013  CMP #$60
+	0x90, 0x02,             // C015  BCC $C019
+	0xA9, 0x00,             // C017  LDA #$00
+	0x85, 0x12,             // C019  STA $12
+	0x38,                   // C01B  SEC
+	0xA5, 0x13,             // C01C  LDA $13          <- countdown
+	0xE9, 0x01,             // C01E  SBC #$01
+	0x85, 0x13,             // C020  STA $13
+	0x4C, 0x01, 0xC0,       // C022  JMP $C001
+};
+
+// Branch heavy : an 8 bit LFSR steers four data-dependent branches per pass
+static const uint8_t  bench_branch[] = {
+	0xA9, 0x01,             // C000  LDA #$01
+	0x85, 0x10,             // C002  STA $10
+	0xA5, 0x10,             // C004  LDA $10          <- x^8 + x^4 + x^3 + x^2 + 1
+	0x0A,                   // C006  ASL A
+	0x90, 0x02,             // C007  BCC $C00B
+	0x49, 0x1D,             // C009  EOR #$1D
+	0x85, 0x10,             // C00B  STA $10
+	0x30, 0x03,             // C00D  BMI $C012
+	0xE8,                   // C00F  INX
+	0xD0, 0x01,             // C010  BNE $C013
+	0xC8,                   // C012  INY
+	0x29, 0x03,             // C013  AND #$03
+	0xF0, 0x04,             // C015  BEQ $C01B
+	0xC9, 0x02,             // C017  CMP #$02
+	0xB0, 0x01,             // C019  BCS $C01C
+	0xCA,                   // C01B  DEX
+	0x4C, 0x04, 0xC0,       // C01C  JMP $C004
+};
+
+// Memory heavy : copy 4K $2000 -> $3000 through (zp), Y, then INC every byte of a page
+static const uint8_t  bench_mem[] = {
+	0xA9, 0x00,             // C000  LDA #$00
+	0x85, 0x10,             // C002  STA $10
+	0x85, 0x12,             // C004  STA $12
+	0xA9, 0x20,             // C006  LDA #$20
+	0x85, 0x11,             // C008  STA $11
+	0xA9, 0x30,             // C00A  LDA #$30
+	0x85, 0x13,             // C00C  STA $13
+	0xA2, 0x10,             // C00E  LDX #$10         <- 16 pages
+	0xA0, 0x00,             // C010  LDY #$00
+	0xB1, 0x10,             // C012  LDA ($10), Y
+	0x91, 0x12,             // C014  STA ($12), Y
+	0xC8,                   // C016  INY
+	0xD0, 0xF9,             // C017  BNE $C012
+	0xE6, 0x11,             // C019  INC $11
+	0xE6, 0x13,             // C01B  INC $13
+	0xCA,                   // C01D  DEX
+	0xD0, 0xF2,             // C01E  BNE $C012
+	0xFE, 0x00, 0x30,       // C020  INC $3000, X
+	0xE8,                   // C023  INX
+	0xD0, 0xFA,             // C024  BNE $C020
+	0x4C, 0x06, 0xC0,       // C026  JMP $C006
+};
+
+#endif //_6502_WORK_H_
@@ -0,0 +1,264 @@
+//----------------------------------------------------------------------------- ----------------------------------------
+// Cross-reference index  (see 6502-xref.h)
+//
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "6502.h"
+#include "6502-xref.h"
+
+#define XREF_MAGIC  "6502XRF"
+#define XREF_BOM    (0x01020304)
+#define XREF_DIR    (0x10001)
+
+// Where the parts of a block with 'n' references start
+#define XREF_AT_DIR      (sizeof(xref_hdr_t))
+#define XREF_AT_REF      (XREF_AT_DIR + XREF_DIR * sizeof(uint32_t))
+#define XREF_AT_OP(n)    (XREF_AT_REF + (size_t)(n) * sizeof(uint32_t))
+#define XREF_AT_AUX(n)   (XREF_AT_OP(n) + (n))
+#define XREF_SIZE(n)     (XREF_AT_AUX(n) + (n))
+
+//+============================================================================ ========================================
+// What an instruction does at the address it names
+//
+static  xref_kind_t  kind (uint8_t mn,  uint8_t am)
+{
+	switch (mn) {
+		case MN_STA:  case MN_STX:  case MN_STY:  case MN_STZ:  case MN_SAX:
+			return XR_WR;
+
+		case MN_ASL:  case MN_LSR:  case MN_ROL:  case MN_ROR:  case MN_INC:  case MN_DEC:
+		case MN_SLO:  case MN_RLA:  case MN_SRE:  case MN_RRA:  case MN_DCP:  case MN_ISC:
+		case MN_TRB:  case MN_TSB:  case MN_RMB:  case MN_SMB:
+			return XR_RMW;
+
+		case MN_JMP:  case MN_JSR:  case MN_JML:  case MN_JSL:
+			return ((am == AM_ABS) || (am == AM_LNG)) ? XR_JMP : XR_RD ;   // (ind) : the pointer is read
+
+		default:
+			return XR_RD;
+	}
+}
+
+//+============================================================================ ========================================
+int  xref_of (insn_t in,  uint16_t addr,  uint16_t* ad,  uint8_t* kd,  uint8_t* aux)
+{
+	aux[0] = aux[1] = 0;
+	switch (in.am) {
+		case AM_ZP  :  case AM_ZPX :  case AM_ZPY :  case AM_INDX:  case AM_INDY:  case AM_ZPI :
+		case AM_DIL :  case AM_DILY:
+		case AM_ABS :  case AM_ABSX:  case AM_ABSY:  case AM_IND :  case AM_IAX :  case AM_IL  :
+			ad[0] = in.oper;
+			kd[0] = kind(in.mn, in.am);
+			return 1;
+
+		case AM_LNG :  case AM_LNGX:
+			ad[0]  = in.oper;
+			kd[0]  = kind(in.mn, in.am);
+			aux[0] = in.bank;
+			return 1;
+
+		case AM_REL :  case AM_RELL:
+			ad[0] = insn_target(in, addr);
+			kd[0] = XR_JMP;
+			return 1;
+
+		case AM_ZPR :                                       // BBRn/BBSn zp, rel
+			ad[0]  = in.oper & 0xFF;
+			kd[0]  = XR_RD;
+			aux[0] = in.oper >> 8;                          // The other byte : rel
+			ad[1]  = insn_target(in, addr);
+			kd[1]  = XR_JMP;
+			aux[1] = in.oper;                               //                  zp
+			return 2;
+
+		default:
+			return 0;
+	}
+}
+
+//+============================================================================ ========================================
+// Point the parts of x at the block
+//
+static  void  xref_parts (xref_t* x)
+{
+	uint8_t*  b = x->blk;
+	uint32_t  n = ((xref_hdr_t*)b)->nref;
+
+	x->hdr = (const xref_hdr_t*)b;
+	x->dir = (const uint32_t*)(b + XREF_AT_DIR);
+	x->ref = (const uint32_t*)(b + XREF_AT_REF);
+	x->op  = b + XREF_AT_OP(n);
+	x->aux = b + XREF_AT_AUX(n);
+}
+
+//+============================================================================ ========================================
+// One sweep collects the references in image order;  a counting sort on (address, kind) then lays out the block -
+// stable, so the references to each address & kind stay in image order
+//
+typedef
+	struct xr_tmp {
+		uint32_t  key;             // Address << 2 | kind
+		uint32_t  off;
+		uint8_t   op, aux;
+	}
+xr_tmp_t;
+
+int  xref_build (xref_t* x,  const uint8_t* buf,  size_t sz,  uint16_t org,  cpu_var_t var)
+{
+	const decode_t*  tab = op2i_var[var];
+	xr_tmp_t*        t   = NULL;
+	uint32_t*        at  = NULL;                            // Next slot of each (address, kind)
+	size_t           n   = 0,  cap = 0;
+	uint8_t*         b;
+	uint32_t*        dir;
+	uint32_t*        ref;
+	xref_hdr_t*      h;
+
+	memset(x, 0, sizeof(*x));
+	if (sz >= (1u << 30))  return errno = EFBIG, -1 ;
+
+	for (size_t p = 0;  p < sz;  ) {
+		uint8_t   ins[4] = {0};
+		uint16_t  addr   = org + p;
+		uint16_t  ad[2];
+		uint8_t   kd[2], aux[2];
+		int       len    = tab[buf[p]].len,  nr;
+
+		if (!len || (p + len > sz)) {                       // Data byte
+			p++;
+			continue;
+		}
+		memcpy(ins, &buf[p], len);
+		nr = xref_of(decode_insn_tab(tab, ins), addr, ad, kd, aux);
+
+		if (n + nr > cap) {
+			xr_tmp_t*  v = realloc(t, (cap = cap ? cap * 2 : 4096) * sizeof(*t));
+
+			if (!v)  return free(t), -1 ;
+			t = v;
+		}
+		for (int r = 0;  r < nr;  r++)  t[n++] = (xr_tmp_t){ (ad[r] << 2) | kd[r],  p,  ins[0],  aux[r] } ;
+		p += len;
+	}
+
+	if (!(at = calloc(XREF_DIR * 4, sizeof(*at))) || !(b = calloc(1, XREF_SIZE(n))))  return free(at), free(t), -1 ;
+
+	for (size_t i = 0;  i < n;  i++)  at[t[i].key + 1]++ ;
+	for (uint32_t k = 1;  k < XREF_DIR * 4;  k++)  at[k] += at[k - 1] ;
+
+	h   = (xref_hdr_t*)b;
+	dir = (uint32_t*)(b + XREF_AT_DIR);
+	ref = (uint32_t*)(b + XREF_AT_REF);
+	memcpy(h->magic, XREF_MAGIC, 8);
+	h->bom  = XREF_BOM;
+	h->nref = n;
+	h->sz   = sz;
+	h->org  = org;
+	h->var  = var;
+	for (uint32_t a = 0;  a < XREF_DIR;  a++)  dir[a] = at[a << 2] ;
+
+	for (size_t i = 0;  i < n;  i++) {
+		uint32_t  j = at[t[i].key]++;
+
+		ref[j] = (t[i].off << 2) | (t[i].key & 3);
+		b[XREF_AT_OP(n)  + j] = t[i].op;
+		b[XREF_AT_AUX(n) + j] = t[i].aux;
+	}
+
+	free(at);
+	free(t);
+	x->blk = b;
+	x->bsz = XREF_SIZE(n);
+	xref_parts(x);
+	return 0;
+}
+
+//+============================================================================ ========================================
+int  xref_save (const xref_t* x,  const char* fn)
+{
+	FILE*  fh = fopen(fn, "wb");
+	int    rv;
+
+	if (!fh)  return -1 ;
+	rv = (fwrite(x->blk, 1, x->bsz, fh) == x->bsz) ? 0 : -1;
+	if (fclose(fh))  rv = -1 ;
+	return rv;
+}
+
+//+============================================================================ ========================================
+// dir[] must run from 0 to nref without going back  (else a lookup could index past ref[])
+//
+static  int  xref_dir_ok (const xref_t* x)
+{
+	if (x->dir[0])  return 0 ;
+	for (uint32_t a = 0;  a < 0x10000;  a++)
+		if (x->dir[a] > x->dir[a + 1])  return 0 ;
+	return x->dir[0x10000] == x->hdr->nref;
+}
+
+//+============================================================================ ========================================
+int  xref_open (xref_t* x,  const char* fn)
+{
+	struct stat        st;
+	const xref_hdr_t*  h;
+	int                fd;
+
+	memset(x, 0, sizeof(*x));
+	if ((fd = open(fn, O_RDONLY)) < 0)  return -1 ;
+	if (fstat(fd, &st) < 0)  return close(fd), -1 ;
+	if ((size_t)st.st_size < XREF_SIZE(0))  return close(fd), errno = EINVAL, -1 ;
+
+	x->blk = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if (x->blk == MAP_FAILED)  return x->blk = NULL, -1 ;
+	x->bsz = st.st_size;
+	x->map = 1;
+
+	h = x->blk;
+	if (memcmp(h->magic, XREF_MAGIC, 8) || (h->bom != XREF_BOM) || (h->var >= VAR_MAX) || (XREF_SIZE(h->nref) != x->bsz)) {
+		xref_close(x);
+		return errno = EINVAL, -1;
+	}
+	xref_parts(x);
+	if (!xref_dir_ok(x))  return xref_close(x), errno = EINVAL, -1 ;
+	return 0;
+}
+
+//+============================================================================ ========================================
+void  xref_close (xref_t* x)
+{
+	if (x->map)  munmap(x->blk, x->bsz) ;
+	else         free(x->blk) ;
+	memset(x, 0, sizeof(*x));
+}
+
+//+============================================================================ ========================================
+uint16_t  xref_ins (const xref_t* x,  uint16_t a,  uint32_t i,  uint8_t* ins)
+{
+	uint16_t  addr = x->hdr->org + XREF_OFF(x->ref[i]);
+	uint16_t  v    = a;
+
+	switch (op2i_var[x->hdr->var][x->op[i]].am) {
+		case AM_REL :  v = a - (addr + 2);  break ;
+		case AM_RELL:  v = a - (addr + 3);  break ;
+		case AM_ZPR :  v = (XREF_KIND(x->ref[i]) == XR_JMP) ? x->aux[i] | (uint8_t)(a - (addr + 3)) << 8    // zp, rel
+		                                                    : a | x->aux[i] << 8 ;
+		               break ;
+		default     :  break ;
+	}
+
+	ins[0] = x->op[i];
+	ins[1] = v;
+	ins[2] = v >> 8;
+	ins[3] = x->aux[i];                                     // (the bank of a long address)
+	return addr;
+}
@@ -0,0 +1,79 @@
+#ifndef  _6502_XREF_H_
+#define  _6502_XREF_H_
+
+//----------------------------------------------------------------------------- ----------------------------------------
+#include <stddef.h>
+#include <stdint.h>
+
+#include "6502.h"
+
+//----------------------------------------------------------------------------- ----------------------------------------
+// Cross-reference index of a binary image
+//
+// One linear sweep  (as disasm_image() does it) records every instruction that names a memory address, against that
+// address : its image offset, the opcode & what it does there.  Indexed & register-indirect modes count against the
+// base address / the zero page pointer, (ind) jumps against the pointer  (read), branches against their target  (jump).
+// BBRn/BBSn make two : a read of the zero page byte & a jump.  65816 long addresses count against their low 16 bits.
+//
+// The index is one block, identical in memory & on disk, so xref_open() simply maps the file:
+//
+//   xref_hdr_t
+//   dir[0x10001]  : the references to address a are ref[dir[a]] .. ref[dir[a + 1] - 1]
+//   ref[nref]     : image offset << 2 | kind   - by address, then kind, then offset
+//   op [nref]     : opcode
+//   aux[nref]     : the operand byte the address does not give  (BBRn/BBSn, the bank of a long address), else 0
+//                   (so with the address & offset, the whole instruction - the image is not needed)
+//
+// Host byte order  (the header says which)
+//
+typedef
+	enum xref_kind {
+		XR_RD  = 0,                // Read
+		XR_WR  = 1,                // Write
+		XR_RMW = 2,                // Read-modify-write
+		XR_JMP = 3,                // Jump, call or branch target
+	}
+xref_kind_t;
+
+#define XREF_OFF(r)   ((r) >> 2)
+#define XREF_KIND(r)  ((r) & 3)
+
+typedef
+	struct xref_hdr {
+		char      magic[8];        // "6502XRF" 0
+		uint32_t  bom;             // 0x01020304 in the byte order of the host that wrote it
+		uint32_t  nref;
+		uint64_t  sz;              // Image bytes
+		uint16_t  org;             // Address of the first byte  (wraps at 64K)
+		uint8_t   var;             // cpu_var_t the image was decoded as
+		uint8_t   pad[5];
+	}
+xref_hdr_t;
+
+typedef
+	struct xref {
+		const xref_hdr_t*  hdr;
+		const uint32_t*    dir;
+		const uint32_t*    ref;
+		const uint8_t*     op;
+		const uint8_t*     aux;
+		void*              blk;    // The block  (malloc'ed by xref_build(), or mapped by xref_open())
+		size_t             bsz;
+		int                map;    // !0 -> blk is mapped
+	}
+xref_t;
+
+//----------------------------------------------------------------------------- ----------------------------------------
+int     xref_build (xref_t* x,  const uint8_t* buf,  size_t sz,  uint16_t org,  cpu_var_t var) ;   // -> 0, or -1 (errno)
+int     xref_save  (const xref_t* x,  const char* fn) ;
+int     xref_open  (xref_t* x,  const char* fn) ;          // -> 0, or -1 (errno;  EINVAL -> not an index from this host, or damaged)
+void    xref_close (xref_t* x) ;
+
+// The addresses an instruction at addr names, what it does there & the operand byte each does not give  -> how many (0..2)
+int       xref_of  (insn_t in,  uint16_t addr,  uint16_t* ad,  uint8_t* kd,  uint8_t* aux) ;
+
+// Rebuild the instruction behind ref[i], a reference to address 'a', in ins[4]  -> its address
+//   (the references to lo..hi are ref[dir[lo]] .. ref[dir[hi + 1] - 1], address by address)
+uint16_t  xref_ins (const xref_t* x,  uint16_t a,  uint32_t i,  uint8_t* ins) ;
+
+#endif //_6502_XREF_H_
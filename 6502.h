@@ -0,0 +1,529 @@
+#ifndef  _6502_H_
+#define  _6502_H_
+
+//----------------------------------------------------------------------------- ----------------------------------------
+#include <stdint.h>
+#include <string.h>
+
+//----------------------------------------------------------------------------- ----------------------------------------
+#define PEEK8(p)     ( *((uint8_t*)(p)) )
+#define PEEK16LE(p)  ( PEEK8(p) | (PEEK8( ((uint8_t*)(p)) +1) <<8) )
+
+//----------------------------------------------------------------------------- ----------------------------------------
+// Opcodes
+//
+typedef
+	enum opcode {
+		// https://www.masswerk.at/6502/6502_instruction_set.html
+		// In case of errors:  The *COMMENTS* should be trusted above the enums
+		//   *  : (Tcnt += 1) if page boundary is crossed
+		//   ** : (Tcnt += 1) if branch occurs on same page
+		//      : (Tcnt += 2) if branch occurs to different page
+		OP_ADC_ABS  = 0x6D,    // absolute      ADC oper      6D    3     4   
+		OP_ADC_ABSX = 0x7D,    // absolute,X    ADC oper,X    7D    3     4*   
+		OP_ADC_ABSY = 0x79,    // absolute,Y    ADC oper,Y    79    3     4*   
+		OP_ADC_IMM  = 0x69,    // immediate     ADC #oper     69    2     2
+		OP_ADC_INDX = 0x61,    // (indirect,X)  ADC (oper,X)  61    2     6   
+		OP_ADC_INDY = 0x71,    // (indirect),Y  ADC (oper),Y  71    2     5*   
+		OP_ADC_ZP   = 0x65,    // zeropage      ADC oper      65    2     3   
+		OP_ADC_ZPX  = 0x75,    // zeropage,X    ADC oper,X    75    2     4   
+		OP_AND_ABS  = 0x2D,    // absolute      AND oper      2D    3     4   
+		OP_AND_ABSX = 0x3D,    // absolute,X    AND oper,X    3D    3     4*   
+		OP_AND_ABSY = 0x39,    // absolute,Y    AND oper,Y    39    3     4*   
+		OP_AND_IMM  = 0x29,    // immediate     AND #oper     29    2     2   
+		OP_AND_INDX = 0x21,    // (indirect,X)  AND (oper,X)  21    2     6   
+		OP_AND_INDY = 0x31,    // (indirect),Y  AND (oper),Y  31    2     5*   
+		OP_AND_ZP   = 0x25,    // zeropage      AND oper      25    2     3   
+		OP_AND_ZPX  = 0x35,    // zeropage,X    AND oper,X    35    2     4   
+		OP_ASL_ABS  = 0x0E,    // absolute      ASL oper      0E    3     6   
+		OP_ASL_ABSX = 0x1E,    // absolute,X    ASL oper,X    1E    3     7   
+		OP_ASL_ACC  = 0x0A,    // accumulator   ASL A         0A    1     2   
+		OP_ASL_ZP   = 0x06,    // zeropage      ASL oper      06    2     5   
+		OP_ASL_ZPX  = 0x16,    // zeropage,X    ASL oper,X    16    2     6   
+		OP_BCC_REL  = 0x90,    // relative      BCC oper      90    2     2**   
+		OP_BCS_REL  = 0xB0,    // relative      BCS oper      B0    2     2**   
+		OP_BEQ_REL  = 0xF0,    // relative      BEQ oper      F0    2     2**   
+		OP_BIT_ABS  = 0x2C,    // absolute      BIT oper      2C    3     4   
+		OP_BIT_ZP   = 0x24,    // zeropage      BIT oper      24    2     3   
+		OP_BMI_REL  = 0x30,    // relative      BMI oper      30    2     2**   
+		OP_BNE_REL  = 0xD0,    // relative      BNE oper      D0    2     2**   
+		OP_BPL_REL  = 0x10,    // relative      BPL oper      10    2     2**   
+		OP_BRK_IMP  = 0x00,    // implied       BRK           00    1     7   
+		OP_BVC_REL  = 0x50,    // relative      BVC oper      50    2     2**   
+		OP_BVS_REL  = 0x70,    // relative      BVC oper      70    2     2**   
+		OP_CLC_IMP  = 0x18,    // implied       CLC           18    1     2   
+		OP_CLD_IMP  = 0xD8,    // implied       CLD           D8    1     2   
+		OP_CLI_IMP  = 0x58,    // implied       CLI           58    1     2   
+		OP_CLV_IMP  = 0xB8,    // implied       CLV           B8    1     2   
+		OP_CMP_ABS  = 0xCD,    // absolute      CMP oper      CD    3     4   
+		OP_CMP_ABSX = 0xDD,    // absolute,X    CMP oper,X    DD    3     4*   
+		OP_CMP_ABSY = 0xD9,    // absolute,Y    CMP oper,Y    D9    3     4*   
+		OP_CMP_IMM  = 0xC9,    // immediate     CMP #oper     C9    2     2   
+		OP_CMP_INDX = 0xC1,    // (indirect,X)  CMP (oper,X)  C1    2     6   
+		OP_CMP_INDY = 0xD1,    // (indirect),Y  CMP (oper),Y  D1    2     5*   
+		OP_CMP_ZP   = 0xC5,    // zeropage      CMP oper      C5    2     3   
+		OP_CMP_ZPX  = 0xD5,    // zeropage,X    CMP oper,X    D5    2     4   
+		OP_CPX_ABS  = 0xEC,    // absolute      CPX oper      EC    3     4   
+		OP_CPX_IMM  = 0xE0,    // immediate     CPX #oper     E0    2     2   
+		OP_CPX_ZP   = 0xE4,    // zeropage      CPX oper      E4    2     3   
+		OP_CPY_ABS  = 0xCC,    // absolute      CPY oper      CC    3     4   
+		OP_CPY_IMM  = 0xC0,    // immediate     CPY #oper     C0    2     2   
+		OP_CPY_ZP   = 0xC4,    // zeropage      CPY oper      C4    2     3   
+		OP_DEC_ABS  = 0xCE,    // absolute      DEC oper      CE    3     6   
+		OP_DEC_ABSX = 0xDE,    // absolute,X    DEC oper,X    DE    3     7   
+		OP_DEC_ZP   = 0xC6,    // zeropage      DEC oper      C6    2     5   
+		OP_DEC_ZPX  = 0xD6,    // zeropage,X    DEC oper,X    D6    2     6   
+		OP_DEX_IMP  = 0xCA,    // implied       DEC           CA    1     2   
+		OP_DEY_IMP  = 0x88,    // implied       DEC           88    1     2   
+		OP_EOR_ABS  = 0x4D,    // absolute      EOR oper      4D    3     4   
+		OP_EOR_ABSX = 0x5D,    // absolute,X    EOR oper,X    5D    3     4*   
+		OP_EOR_ABSY = 0x59,    // absolute,Y    EOR oper,Y    59    3     4*   
+		OP_EOR_IMM  = 0x49,    // immediate     EOR #oper     49    2     2   
+		OP_EOR_INDX = 0x41,    // (indirect,X)  EOR (oper,X)  41    2     6   
+		OP_EOR_INDY = 0x51,    // (indirect),Y  EOR (oper),Y  51    2     5*   
+		OP_EOR_ZP   = 0x45,    // zeropage      EOR oper      45    2     3   
+		OP_EOR_ZPX  = 0x55,    // zeropage,X    EOR oper,X    55    2     4   
+		OP_INC_ABS  = 0xEE,    // absolute      INC oper      EE    3     6   
+		OP_INC_ABSX = 0xFE,    // absolute,X    INC oper,X    FE    3     7   
+		OP_INC_ZP   = 0xE6,    // zeropage      INC oper      E6    2     5   
+		OP_INC_ZPX  = 0xF6,    // zeropage,X    INC oper,X    F6    2     6   
+		OP_INX_IMP  = 0xE8,    // implied       INX           E8    1     2   
+		OP_INY_IMP  = 0xC8,    // implied       INY           C8    1     2   
+		OP_JMP_ABS  = 0x4C,    // absolute      JMP oper      4C    3     3   
+		OP_JMP_IND  = 0x6C,    // indirect      JMP (oper)    6C    3     5   
+		OP_JSR_ABS  = 0x20,    // absolute      JSR oper      20    3     6   
+		OP_LDA_ABS  = 0xAD,    // absolute      LDA oper      AD    3     4   
+		OP_LDA_ABSX = 0xBD,    // absolute,X    LDA oper,X    BD    3     4*   
+		OP_LDA_ABSY = 0xB9,    // absolute,Y    LDA oper,Y    B9    3     4*   
+		OP_LDA_IMM  = 0xA9,    // immediate     LDA #oper     A9    2     2   
+		OP_LDA_INDX = 0xA1,    // (indirect,X)  LDA (oper,X)  A1    2     6   
+		OP_LDA_INDY = 0xB1,    // (indirect),Y  LDA (oper),Y  B1    2     5*   
+		OP_LDA_ZP   = 0xA5,    // zeropage      LDA oper      A5    2     3   
+		OP_LDA_ZPX  = 0xB5,    // zeropage,X    LDA oper,X    B5    2     4   
+		OP_LDX_ABS  = 0xAE,    // absolute      LDX oper      AE    3     4   
+		OP_LDX_ABSY = 0xBE,    // absolute,Y    LDX oper,Y    BE    3     4*   
+		OP_LDX_IMM  = 0xA2,    // immediate     LDX #oper     A2    2     2   
+		OP_LDX_ZP   = 0xA6,    // zeropage      LDX oper      A6    2     3   
+		OP_LDX_ZPY  = 0xB6,    // zeropage,Y    LDX oper,Y    B6    2     4   
+		OP_LDY_ABS  = 0xAC,    // absolute      LDY oper      AC    3     4   
+		OP_LDY_ABSX = 0xBC,    // absolute,X    LDY oper,X    BC    3     4*   
+		OP_LDY_IMM  = 0xA0,    // immediate     LDY #oper     A0    2     2   
+		OP_LDY_ZP   = 0xA4,    // zeropage      LDY oper      A4    2     3   
+		OP_LDY_ZPX  = 0xB4,    // zeropage,X    LDY oper,X    B4    2     4   
+		OP_LSR_ABS  = 0x4E,    // absolute      LSR oper      4E    3     6   
+		OP_LSR_ABSX = 0x5E,    // absolute,X    LSR oper,X    5E    3     7   
+		OP_LSR_IMM  = 0x4A,    // accumulator   LSR A         4A    1     2   
+		OP_LSR_ZP   = 0x46,    // zeropage      LSR oper      46    2     5   
+		OP_LSR_ZPX  = 0x56,    // zeropage,X    LSR oper,X    56    2     6   
+		OP_NOP_IMP  = 0xEA,    // implied       NOP           EA    1     2   
+		OP_ORA_ABS  = 0x0D,    // absolute      ORA oper      0D    3     4   
+		OP_ORA_ABSX = 0x1D,    // absolute,X    ORA oper,X    1D    3     4*   
+		OP_ORA_ABSY = 0x19,    // absolute,Y    ORA oper,Y    19    3     4*   
+		OP_ORA_IMM  = 0x09,    // immediate     ORA #oper     09    2     2   
+		OP_ORA_INDX = 0x01,    // (indirect,X)  ORA (oper,X)  01    2     6   
+		OP_ORA_INDY = 0x11,    // (indirect),Y  ORA (oper),Y  11    2     5*   
+		OP_ORA_ZP   = 0x05,    // zeropage      ORA oper      05    2     3   
+		OP_ORA_ZPX  = 0x15,    // zeropage,X    ORA oper,X    15    2     4   
+		OP_PHA_IMP  = 0x48,    // implied       PHA           48    1     3   
+		OP_PHP_IMP  = 0x08,    // implied       PHP           08    1     3   
+		OP_PLA_IMP  = 0x68,    // implied       PLA           68    1     4   
+		OP_PLP_IMP  = 0x28,    // implied       PLP           28    1     4   
+		OP_ROL_ABS  = 0x2E,    // absolute      ROL oper      2E    3     6   
+		OP_ROL_ABSX = 0x3E,    // absolute,X    ROL oper,X    3E    3     7   
+		OP_ROL_ACC  = 0x2A,    // accumulator   ROL A         2A    1     2   
+		OP_ROL_ZP   = 0x26,    // zeropage      ROL oper      26    2     5   
+		OP_ROL_ZPX  = 0x36,    // zeropage,X    ROL oper,X    36    2     6   
+		OP_ROR_ABS  = 0x6E,    // absolute      ROR oper      6E    3     6   
+		OP_ROR_ABSX = 0x7E,    // absolute,X    ROR oper,X    7E    3     7   
+		OP_ROR_ACC  = 0x6A,    // accumulator   ROR A         6A    1     2   
+		OP_ROR_ZP   = 0x66,    // zeropage      ROR oper      66    2     5   
+		OP_ROR_ZPX  = 0x76,    // zeropage,X    ROR oper,X    76    2     6   
+		OP_RTI_IMP  = 0x40,    // implied       RTI           40    1     6   
+		OP_RTS_IMP  = 0x60,    // implied       RTS           60    1     6   
+		OP_SBC_ABS  = 0xED,    // absolute      SBC oper      ED    3     4   
+		OP_SBC_ABSX = 0xFD,    // absolute,X    SBC oper,X    FD    3     4*   
+		OP_SBC_ABSY = 0xF9,    // absolute,Y    SBC oper,Y    F9    3     4*   
+		OP_SBC_IMM  = 0xE9,    // immediate     SBC #oper     E9    2     2   
+		OP_SBC_INDX = 0xE1,    // (indirect,X)  SBC (oper,X)  E1    2     6   
+		OP_SBC_INDY = 0xF1,    // (indirect),Y  SBC (oper),Y  F1    2     5*   
+		OP_SBC_ZP   = 0xE5,    // zeropage      SBC oper      E5    2     3   
+		OP_SBC_ZPX  = 0xF5,    // zeropage,X    SBC oper,X    F5    2     4   
+		OP_SEC_IMP  = 0x38,    // implied       SEC           38    1     2   
+		OP_SED_IMP  = 0xF8,    // implied       SED           F8    1     2   
+		OP_SEI_IMP  = 0x78,    // implied       SEI           78    1     2   
+		OP_STA_ABS  = 0x8D,    // absolute      STA oper      8D    3     4   
+		OP_STA_ABSX = 0x9D,    // absolute,X    STA oper,X    9D    3     5   
+		OP_STA_ABSY = 0x99,    // absolute,Y    STA oper,Y    99    3     5   
+		OP_STA_INDX = 0x81,    // (indirect,X)  STA (oper,X)  81    2     6   
+		OP_STA_INDY = 0x91,    // (indirect),Y  STA (oper),Y  91    2     6   
+		OP_STA_ZP   = 0x85,    // zeropage      STA oper      85    2     3   
+		OP_STA_ZPX  = 0x95,    // zeropage,X    STA oper,X    95    2     4   
+		OP_STX_ABS  = 0x8E,    // absolute      STX oper      8E    3     4   
+		OP_STX_ZP   = 0x86,    // zeropage      STX oper      86    2     3   
+		OP_STX_ZPY  = 0x96,    // zeropage,Y    STX oper,Y    96    2     4   
+		OP_STY_ABS  = 0x8C,    // absolute      STY oper      8C    3     4   
+		OP_STY_ZP   = 0x84,    // zeropage      STY oper      84    2     3   
+		OP_STY_ZPX  = 0x94,    // zeropage,X    STY oper,X    94    2     4   
+		OP_TAX_IMP  = 0xAA,    // implied       TAX           AA    1     2   
+		OP_TAY_IMP  = 0xA8,    // implied       TAY           A8    1     2   
+		OP_TSX_IMP  = 0xBA,    // implied       TSX           BA    1     2   
+		OP_TXA_IMP  = 0x8A,    // implied       TXA           8A    1     2   
+		OP_TXS_IMP  = 0x9A,    // implied       TXS           9A    1     2   
+		OP_TYA_IMP  = 0x98,    // implied       TYA           98    1     2   		
+	}
+opcode_t;
+
+//----------------------------------------------------------------------------- ----------------------------------------
+// Addressing Modes
+//
+typedef	
+	enum amode {
+		// In order of "increasing opcode value"
+		AM_IMP = 0,
+		AM_REL,
+		AM_ACC,
+		AM_IMM,
+		AM_ZP,
+		AM_ZPX,
+		AM_ZPY,
+		AM_ABS,
+		AM_ABSX,
+		AM_ABSY,
+		AM_IND,
+		AM_INDX,
+		AM_INDY,
+
+		// 65C02
+		AM_ZPI,     // (zp)
+		AM_IAX,     // (abs,X)
+		AM_ZPR,     // zp,rel               BBRn/BBSn : test a zero page bit & branch
+		// 65816
+		AM_SR,      // sr,S                 stack relative
+		AM_SRIY,    // (sr,S),Y
+		AM_DIL,     // [dp]                 24-bit pointer
+		AM_DILY,    // [dp],Y
+		AM_LNG,     // long                 24-bit address
+		AM_LNGX,    // long,X
+		AM_RELL,    // rel16                BRL, PER
+		AM_BLK,     // srcbank,dstbank      MVN, MVP
+		AM_IL,      // [abs]                JML [abs]
+		
+		AM_MAX  // Must be last
+	}
+amode_t;	
+
+extern const char  amode[AM_MAX][16];
+
+//----------------------------------------------------------------------------- ----------------------------------------
+// Mnemonics
+//
+typedef
+	enum mnem {
+		MN_ILL = 0,  // Invalid opcode
+		MN_ADC, MN_AND, MN_ASL, MN_BCC, MN_BCS, MN_BEQ, MN_BIT, MN_BMI,
+		MN_BNE, MN_BPL, MN_BRK, MN_BVC, MN_BVS, MN_CLC, MN_CLD, MN_CLI,
+		MN_CLV, MN_CMP, MN_CPX, MN_CPY, MN_DEC, MN_DEX, MN_DEY, MN_EOR,
+		MN_INC, MN_INX, MN_INY, MN_JMP, MN_JSR, MN_LDA, MN_LDX, MN_LDY,
+		MN_LSR, MN_NOP, MN_ORA, MN_PHA, MN_PHP, MN_PLA, MN_PLP, MN_ROL,
+		MN_ROR, MN_RTI, MN_RTS, MN_SBC, MN_SEC, MN_SED, MN_SEI, MN_STA,
+		MN_STX, MN_STY, MN_TAX, MN_TAY, MN_TSX, MN_TXA, MN_TXS, MN_TYA,
+
+		// NMOS undocumented  (the stable ones)
+		MN_ALR, MN_ANC, MN_ARR, MN_DCP, MN_ISC, MN_LAX, MN_RLA, MN_RRA,
+		MN_SAX, MN_SBX, MN_SLO, MN_SRE,
+
+		// 65C02  (BBR..SMB carry a bit number: "RMB3")
+		MN_BBR, MN_BBS, MN_RMB, MN_SMB,
+		MN_BRA, MN_PHX, MN_PHY, MN_PLX, MN_PLY, MN_STP, MN_STZ, MN_TRB,
+		MN_TSB, MN_WAI,
+
+		// 65816
+		MN_BRL, MN_COP, MN_JML, MN_JSL, MN_MVN, MN_MVP, MN_PEA, MN_PEI,
+		MN_PER, MN_PHB, MN_PHD, MN_PHK, MN_PLB, MN_PLD, MN_REP, MN_RTL,
+		MN_SEP, MN_TCD, MN_TCS, MN_TDC, MN_TSC, MN_TXY, MN_TYX, MN_WDM,
+		MN_XBA, MN_XCE,
+
+		MN_MAX  // Must be last
+	}
+mnem_t;
+
+// Mnemonic string pool  (3 chars + NUL)
+extern const char  mnem[MN_MAX][4];
+
+// Mnemonic lookup:  mnem_hash[MN_HASH(c0, c1, c2)] is the only candidate  (0 = MN_ILL -> not a mnemonic)
+//   the 5-bit letter codes are packed into 15 bits and hashed multiplicatively to 9 bits - no two mnemonics collide
+#define MN_HASH_SZ      (512)
+#define MN_HASH(a,b,c)  ( ((((uint32_t)(a) & 31) << 10 | ((uint32_t)(b) & 31) << 5 | ((uint32_t)(c) & 31)) * 0x869CEE7Bu) >> 23 )
+
+// Mnemonics that are followed by a bit number
+#define MN_HASBIT(mn)   ( ((mn) >= MN_BBR) && ((mn) <= MN_SMB) )
+
+extern const uint8_t  mnem_hash[MN_HASH_SZ];
+
+//----------------------------------------------------------------------------- ----------------------------------------
+// (Processor) Status Word (aka Flags) register
+//
+typedef
+	enum flags {
+		// Leftmost (2^7) flag first
+		FLG_N    = 0x80,  // Negative    (r & 0x80)
+		FLG_V    = 0x40,  // oVerflow    http://6502.org/tutorials/vflag.html
+		FLG_X    = 0x20,  // -unused-
+		FLG_B    = 0x10,  // BReaK
+		FLG_D    = 0x08,  // Decimal     (BCD)
+		FLG_I    = 0x04,  // /Interrupt  (Interrupt DISable)
+		FLG_Z    = 0x02,  // Zero        (r = 0x00)
+		FLG_C    = 0x01,  // Carry       (r > 0xff)
+		
+		FLG_ALL  = 0xFF,
+		FLG_NONE = 0,
+	}
+flags_t;
+
+//----------------------------------------------------------------------------- ----------------------------------------
+// A disassembled instruction
+//
+typedef
+	struct disasm {         // vv---Useful for: D=disassembly; E=emulation
+		char     mnem[8];   // D.: mnemonic
+		char     oper[16];  // D.: operands
+		amode_t  am;        // .E: Addressing Mode
+		int      len;       // DE: Instr/macro length
+		int      t;         // .E: Tcnt (for instr only (for now))  [+10, or +20 -> footnote #1, #2]
+		uint8_t  flg[3];    // .E: [0] clear, [1] set, [2] modify
+	}
+disasm_t;
+
+//----------------------------------------------------------------------------- ----------------------------------------
+// Instruction decoder table
+//
+// One 8-byte word per opcode, so the whole table is 2KB (32 cache lines)
+// and a lookup is a single 64-bit load
+//
+typedef
+	struct decode {
+		uint8_t  mnem;      // mnemonic  (mnem_t : index into mnem[])
+		uint8_t  am;        // Addressing Mode  (amode_t)
+		uint8_t  len;       // Instr/macro length
+		uint8_t  t;         // Tcnt (for instr only (for now))  [+10, or +20 -> footnote #1, #2]   <-- 0_o
+		uint8_t  flg[3];    // [0] clear, [1] set, [2] modify
+		uint8_t  rd;        // flags read
+	}
+decode_t;
+
+_Static_assert(sizeof(decode_t) == 8, "decode_t must pack into one 64-bit word");
+
+// The decode table  (see 6502-op2i.c)
+extern const decode_t  op2i[256];
+
+//----------------------------------------------------------------------------- ----------------------------------------
+// CPU variants  (see 6502-var.c)
+//
+// Each variant is a whole decode table of its own, with its own cycle counts & flag masks.
+// Code that walks instructions takes the table as a parameter and is instantiated once per table,
+// so the address of the table is a constant and the inner loop never looks at the variant.
+//
+typedef
+	enum cpu_var {
+		VAR_6502 = 0,   // NMOS, documented opcodes only  (op2i[])
+		VAR_NMOS,       // NMOS, + the stable undocumented opcodes  (the 12 JAMs & 8 unstable ones stay invalid)
+		VAR_65C02,      // WDC 65C02, incl. the Rockwell bit instructions  (all 256 defined)
+		VAR_65816,      // 65816 in emulation mode: 8-bit A & index  (all 256 defined)
+
+		VAR_MAX  // Must be last
+	}
+cpu_var_t;
+
+extern const decode_t        op2i_nmos [256];
+extern const decode_t        op2i_65c02[256];
+extern const decode_t        op2i_65816[256];
+extern const decode_t* const op2i_var  [VAR_MAX];
+extern const char            var_name  [VAR_MAX][8];
+
+int  var_find (const char* name) ;   // -> cpu_var_t, or -1
+
+//----------------------------------------------------------------------------- ----------------------------------------
+// Decoder API
+//
+decode_t  decode     (uint8_t* pc,  disasm_t* pDis) ;
+decode_t  decode_tab (const decode_t* tab,  uint8_t* pc,  disasm_t* pDis) ;   // Any variant table
+
+//----------------------------------------------------------------------------- ----------------------------------------
+// Structured decode  (no text until somebody asks for it)
+//
+typedef
+	struct insn {
+		uint8_t   op;       // opcode
+		uint8_t   am;       // Addressing Mode  (amode_t)
+		uint8_t   len;      // Instr length  (0 -> invalid opcode)
+		uint8_t   mn;       // mnemonic  (mnem_t)
+		uint16_t  oper;     // raw operand: byte (zero-extended) or 16-bit LE word  [AM_REL: signed offset byte]
+		uint8_t   bank;     // 3rd operand byte  (AM_LNG, AM_LNGX)
+		uint8_t   _rsvd;
+	}
+insn_t;
+
+static const char  hexdig[16] = "0123456789ABCDEF";
+
+//+============================================================================ ========================================
+static inline  char*  hex2 (char* s,  uint8_t v)
+{
+	s[0] = hexdig[v >> 4];
+	s[1] = hexdig[v & 0xF];
+	return s + 2;
+}
+
+//+============================================================================ ========================================
+static inline  char*  hex4 (char* s,  uint16_t v)
+{
+	return hex2(hex2(s, v >> 8), v & 0xFF);
+}
+
+//+============================================================================ ========================================
+static inline  char*  strput (char* s,  const char* src)
+{
+	while (*src)  *s++ = *src++ ;
+	return s;
+}
+
+//+============================================================================ ========================================
+// Decode without formatting - only the operand bytes the instruction owns are read
+//   tab : decode table  (op2i, or one of the variants)
+//
+static inline  insn_t  decode_insn_tab (const decode_t* tab,  const uint8_t* pc)
+{
+	const decode_t*  pDec = &tab[*pc];
+	insn_t           in   = {*pc, pDec->am, pDec->len, pDec->mnem, 0, 0, 0};
+
+	switch (in.len) {
+		case 4:  in.bank = PEEK8(pc+3);  // Fallthrough
+		case 3:  in.oper = PEEK16LE(pc+1);  break ;
+		case 2:  in.oper = PEEK8   (pc+1);  break ;
+	}
+
+	return in;
+}
+
+//+============================================================================ ========================================
+static inline  insn_t  decode_insn (const uint8_t* pc)
+{
+	return decode_insn_tab(op2i, pc);
+}
+
+//+============================================================================ ========================================
+// Branch target of an AM_REL (or AM_RELL, AM_ZPR) instruction at 'addr'
+//
+static inline  uint16_t  insn_target (insn_t in,  uint16_t addr)
+{
+	switch (in.am) {
+		case AM_RELL:  return addr + 3 + (int16_t)in.oper;
+		case AM_ZPR :  return addr + 3 + (int8_t)(in.oper >> 8);
+		default:       return addr + 2 + (int8_t)in.oper;
+	}
+}
+
+//+============================================================================ ========================================
+// Render "MNM OPER" (no NUL)
+//   addr : address of the instruction  (used to resolve AM_REL targets)
+// Returns the new end of string
+//
+static inline  char*  insn_render (char* s,  insn_t in,  uint16_t addr)
+{
+	memcpy(s, mnem[in.mn], 3);
+	s += 3;
+	if (MN_HASBIT(in.mn))  *s++ = '0' + ((in.op >> 4) & 7) ;
+
+	switch (in.am) {
+		case AM_IMP :                                                                        break ;
+		case AM_REL :  s = hex4(strput(s, " $"  ), insn_target(in, addr));                   break ;
+		case AM_ACC :  s = strput(s, " A");                                                  break ;
+		case AM_IMM :  s = hex2(strput(s, " #$" ), in.oper);                                 break ;
+		case AM_ZP  :  s = hex2(strput(s, " $"  ), in.oper);                                 break ;
+		case AM_ZPX :  s = strput(hex2(strput(s, " $"  ), in.oper), ", X");                  break ;
+		case AM_ZPY :  s = strput(hex2(strput(s, " $"  ), in.oper), ", Y");                  break ;
+		case AM_ABS :  s = hex4(strput(s, " $"  ), in.oper);                                 break ;
+		case AM_ABSX:  s = strput(hex4(strput(s, " $"  ), in.oper), ", X");                  break ;
+		case AM_ABSY:  s = strput(hex4(strput(s, " $"  ), in.oper), ", Y");                  break ;
+		case AM_IND :  s = strput(hex4(strput(s, " ($" ), in.oper), ")");                    break ;
+		case AM_INDX:  s = strput(hex2(strput(s, " ($" ), in.oper), ", X)");                 break ;
+		case AM_INDY:  s = strput(hex2(strput(s, " ($" ), in.oper), "), Y");                 break ;
+		case AM_ZPI :  s = strput(hex2(strput(s, " ($" ), in.oper), ")");                    break ;
+		case AM_IAX :  s = strput(hex4(strput(s, " ($" ), in.oper), ", X)");                 break ;
+		case AM_ZPR :  s = hex4(strput(hex2(strput(s, " $"), in.oper), ", $"), insn_target(in, addr));  break ;
+		case AM_SR  :  s = strput(hex2(strput(s, " $"  ), in.oper), ", S");                  break ;
+		case AM_SRIY:  s = strput(hex2(strput(s, " ($" ), in.oper), ", S), Y");              break ;
+		case AM_DIL :  s = strput(hex2(strput(s, " [$" ), in.oper), "]");                    break ;
+		case AM_DILY:  s = strput(hex2(strput(s, " [$" ), in.oper), "], Y");                 break ;
+		case AM_LNG :  s = hex4(hex2(strput(s, " $"  ), in.bank), in.oper);                  break ;
+		case AM_LNGX:  s = strput(hex4(hex2(strput(s, " $"  ), in.bank), in.oper), ", X");   break ;
+		case AM_RELL:  s = hex4(strput(s, " $"  ), insn_target(in, addr));                   break ;
+		case AM_BLK :  s = hex2(strput(hex2(strput(s, " $"), in.oper >> 8), ", $"), in.oper);  break ;
+		case AM_IL  :  s = strput(hex4(strput(s, " [$" ), in.oper), "]");                    break ;
+		default:       s = strput(s, " ???");                                                break ;
+	}
+
+	return s;
+}
+
+#define DIS_LINE_MAX  (48)         // Longest possible line (with slack)
+
+//+============================================================================ ========================================
+// Disassemble one instruction (no libc formatting)  - the line format of ./table -d
+//   "AAAA  B0 B1 B2  MNM OPER\n"    - Relative branches show their target address
+//   "AAAA  B0        .byte $B0\n"   - Invalid opcode, or instruction truncated by the end of the image
+//   (at most DIS_LINE_MAX bytes)
+//   tab : decode table
+//   nb  : raw byte columns  (3, or 4 for the 65816)
+// Returns the number of bytes consumed [1..nb]
+//
+static inline  int  dis_line (char** ps,  const uint8_t* pc,  size_t rem,  uint16_t addr,  const decode_t* tab,  int nb)
+{
+	char*            s    = *ps;
+	const decode_t*  pDec = &tab[*pc];
+	int              len  = pDec->len;
+
+	s    = hex4(s, addr);
+	*s++ = ' ';
+	*s++ = ' ';
+
+	if ((len == 0) || ((size_t)len > rem)) {                   // Data byte
+		s = hex2(s, *pc);
+		if (nb > 3)  s = strput(s, "   ") ;
+		s = strput(s, "        .byte $");
+		s = hex2(s, *pc);
+		*s++ = '\n';
+		*ps = s;
+		return 1;
+	}
+
+	// Raw bytes, padded to nb
+	s = hex2(s, pc[0]);  *s++ = ' ';
+	if (len > 1)  s = hex2(s, pc[1]) ;  else  *s++ = ' ', *s++ = ' ' ;
+	*s++ = ' ';
+	if (len > 2)  s = hex2(s, pc[2]) ;  else  *s++ = ' ', *s++ = ' ' ;
+	*s++ = ' ';
+	if (nb > 3) {
+		if (len > 3)  s = hex2(s, pc[3]) ;  else  *s++ = ' ', *s++ = ' ' ;
+		*s++ = ' ';
+	}
+	*s++ = ' ';
+
+	// Mnemonic & operand
+	s = insn_render(s, decode_insn_tab(tab, pc), addr);
+	*s++ = '\n';
+
+	*ps = s;
+	return len;
+}
+
+//+============================================================================ ========================================
+// Mnemonic (3 letters, any case) -> mnem_t  (MN_ILL -> not one)
+//
+static inline  mnem_t  mnem_find (const char* s)
+{
+	uint8_t  mn = mnem_hash[MN_HASH(s[0], s[1], s[2])];
+
+	return ((mnem[mn][0] == (s[0] & ~0x20)) && (mnem[mn][1] == (s[1] & ~0x20)) && (mnem[mn][2] == (s[2] & ~0x20))) ? mn : MN_ILL ;
+}
+
+#endif //_6502_H_